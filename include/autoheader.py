@@ -86,7 +86,8 @@ quoteSpices = [
 ]
 
 includeDependency = {
-	'machine': 'container'
+	'machine': 'container',
+	'vanity': 'address'
 }
 
 def getModulesStructure():
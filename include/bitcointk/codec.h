@@ -38,26 +38,67 @@ extern "C" {
 
 int32_t get_strlen(int8_t *string);
 **/
+/* 0x10a0 ~ 0x10af : Strings */
+#define HEXSTR_ODD_LENGTH        (void *)0x10a0
+#define HEXSTR_INVALID_CHARACTER (void *)0x10a1
+
+typedef enum hex_case {
+	HEX_UPPER = 0x00, // "0A1B2C"
+	HEX_LOWER = 0x01, // "0a1b2c"
+} HEX_CASE;
+
+/** Hexadecimal kernels.
+*   The scalar kernel works with lookup tables, the SSSE3 and AVX2 kernels
+*   convert 16 and 32 bytes per iteration.
+**/
+typedef enum hex_impl {
+	HEX_AUTO   = 0x00, // The best kernel the CPU supports.
+	HEX_SCALAR = 0x01,
+	HEX_SSSE3  = 0x02,
+	HEX_AVX2   = 0x03,
+} HEX_IMPL;
+
+/** Select the kernel used by the hexadecimal conversions, the best one is selected by CPUID at load time.
+*   Not thread-safe, call it before converting from multiple threads.
+*   \param  impl        The kernel, HEX_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status hex_select(HEX_IMPL impl);
+
+/** Get the kernel in use. **/
+HEX_IMPL hex_selected(void);
+
 /** Convert a hexadecimal string to a byte array.
+*   Both letter cases are accepted, every character is checked.
 *   \param  str         Hexadecimal string.
 *   \param  str_len     String length, must be even.
-*   \param  arr         Store the byte array.
-*   \return  0 on success.
-*           -1 on odd string length.
-*           -2 on non-hexadecimal characters in the string.
+*   \param  arr         Store the byte array, str_len / 2 bytes. Undefined on error.
+*   \return SUCCEEDED on success.
+*           HEXSTR_ODD_LENGTH on odd string length.
+*           HEXSTR_INVALID_CHARACTER on non-hexadecimal characters in the string.
 *   \example: "0A1B2C" -> {'0x0A', '0X1B', '0X2C'}
 **/
-Status hexstr_to_bytearr(uint8_t *str, size_t str_len, byte *arr);
+Status hexstr_to_bytearr(const uint8_t *str, size_t str_len, byte *arr);
 
-/** Convert a byte array to a hexadecimal string.
-*   \param  arr         byte array, byte's value range: -128 ~ 127.
+/** Convert a byte array to an uppercase hexadecimal string.
+*   \param  arr         byte array.
 *   \param  arr_len     The length of arr.
-*   \param  str         Store the hexadecimal string.
-*   \return  0 on success.
-*           -1 on byte(s) value out range.
+*   \param  str         Store the hexadecimal string, arr_len * 2 + 1 bytes with the NUL.
+*   \return SUCCEEDED.
 *   \example: {'0x0A', '0X1B', '0X2C'} -> "0A1B2C"
 **/
-Status bytearr_to_hexstr(byte *arr, size_t arr_len, uint8_t *str);
+Status bytearr_to_hexstr(const byte *arr, size_t arr_len, uint8_t *str);
+
+/** Convert a byte array to a hexadecimal string in the given letter case.
+*   \param  arr         byte array.
+*   \param  arr_len     The length of arr.
+*   \param  str         Store the hexadecimal string, arr_len * 2 + 1 bytes with the NUL.
+*   \param  hex_case    HEX_UPPER or HEX_LOWER.
+*   \return SUCCEEDED.
+**/
+Status bytearr_to_hexstr_case(const byte *arr, size_t arr_len, uint8_t *str, HEX_CASE hex_case);
+
 void bytearr_reverse(byte *arr, size_t size);
 void hexstr_reverse(uint8_t *str, size_t len);
 void * lsrtip(const void *arr, size_t arr_size, size_t *r_size);
@@ -66,7 +107,109 @@ Status integer_swap(void *a, void *b, void *dtype);
 
 
 
-/** Base6 Encoder. (Leaading '0x00' bytes will be ignored)
+
+/* 0x10c0 ~ 0x10cf : Codec */
+#define CODEC_BUFFER_TOO_SMALL  (void *)0x10c0 // The needed length is still stored.
+#define CODEC_INVALID_CHARACTER (void *)0x10c1
+#define CODEC_INVALID_CHECKSUM  (void *)0x10c2
+
+/** Worst-case buffer sizes for 'n' input bytes (encoders, the NUL included) or characters (decoders).
+*   A byte takes at most log(256)/log(6) < 3.1 Base6 digits, log(256)/log(10) < 2.41 decimal digits
+*   or log(256)/log(58) < 1.38 Base58 digits, a leading Base58 '1' or Base6 or decimal '0' decodes
+*   to one 0x00 byte.
+**/
+#define BASE6_ENCODE_BOUND(n)  ((n) * 31 / 10 + 2)
+#define BASE6_DECODE_BOUND(n)  (n)
+#define BASE10_ENCODE_BOUND(n) ((n) * 241 / 100 + 2)
+#define BASE10_DECODE_BOUND(n) (n)
+#define BASE58_ENCODE_BOUND(n) ((n) * 138 / 100 + 2)
+#define BASE58_DECODE_BOUND(n) (n)
+#define BASE64_ENCODE_BOUND(n) ((((n) + 2) / 3 * 4) + 1)
+#define BASE64_DECODE_BOUND(n) ((n) / 4 * 3 + 2)
+
+/*
+*  The single-pass codecs below write to a buffer of 'capacity' bytes and store the output
+*  length, NUL not counted. On CODEC_BUFFER_TOO_SMALL nothing is written but the length is
+*  stored, so a retry with a buffer that big succeeds. The older functions that take NULL
+*  to return the length are kept as wrappers.
+*  Base6, decimal and Base58 values of more than a few KiB are converted by divide and conquer
+*  on the heap, so those functions may also return MEMORY_ALLOCATE_FAILED, -1 for the wrappers.
+*/
+
+/** Base6 Encoder, single pass. (Leaading '0x00' bytes will be replaced by character '0')
+*   \param  payload     byte array.
+*   \param  payload_len Length of the payload.
+*   \param  encoded     Store the NUL-terminated string.
+*   \param  capacity    Size of 'encoded', BASE6_ENCODE_BOUND(payload_len) is always enough.
+*   \param  encoded_len Store the string length.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL or MEMORY_ALLOCATE_FAILED.
+**/
+Status base6_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len);
+
+/** Base6 Decoder, single pass. (Leaading '0' characters will be replaced by byte '0x00')
+*   \param  payload     The string need to be decode.
+*   \param  payload_len Length of the payload string.
+*   \param  decoded     Store the bytes.
+*   \param  capacity    Size of 'decoded', BASE6_DECODE_BOUND(payload_len) is always enough.
+*   \param  decoded_len Store the decoded length.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL, CODEC_INVALID_CHARACTER or MEMORY_ALLOCATE_FAILED.
+**/
+Status base6_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len);
+
+/** Decimal Encoder, single pass, as base6_encode. (Leaading '0x00' bytes will be replaced by character '0')
+*   \param  capacity    Size of 'encoded', BASE10_ENCODE_BOUND(payload_len) is always enough.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL or MEMORY_ALLOCATE_FAILED.
+**/
+Status base10_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len);
+
+/** Decimal Decoder, single pass, as base6_decode. (Leaading '0' characters will be replaced by byte '0x00')
+*   \param  capacity    Size of 'decoded', BASE10_DECODE_BOUND(payload_len) is always enough.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL, CODEC_INVALID_CHARACTER or MEMORY_ALLOCATE_FAILED.
+**/
+Status base10_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len);
+
+/** Base58 Encoder, single pass. (Leaading '0x00' bytes will be replaced by character '1')
+*   \param  capacity    Size of 'encoded', BASE58_ENCODE_BOUND(payload_len) is always enough.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL or MEMORY_ALLOCATE_FAILED.
+*   The other parameters are as for base6_encode.
+**/
+Status base58_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len);
+
+/** Base58 Decoder, single pass. (Leaading '1' characters will be replaced by byte '0x00')
+*   \param  capacity    Size of 'decoded', BASE58_DECODE_BOUND(payload_len) is always enough.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL, CODEC_INVALID_CHARACTER or MEMORY_ALLOCATE_FAILED.
+*   The other parameters are as for base6_decode.
+**/
+Status base58_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len);
+
+/** Base58Check Encoder, single pass: the payload and the first four bytes of its sha256d.
+*   \param  capacity    Size of 'encoded', BASE58_ENCODE_BOUND(payload_len + 4) is always enough.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL or MEMORY_ALLOCATE_FAILED.
+**/
+Status base58_check_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity,
+	size_t *encoded_len);
+
+/** Base58Check Decoder, single pass. The checksum is checked and not stored.
+*   \param  capacity    Size of 'decoded', BASE58_DECODE_BOUND(payload_len) is always enough.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL, CODEC_INVALID_CHARACTER, CODEC_INVALID_CHECKSUM
+*           or MEMORY_ALLOCATE_FAILED.
+**/
+Status base58_check_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity,
+	size_t *decoded_len);
+
+/** Base64 Encoder, single pass.
+*   \param  capacity    Size of 'encoded', BASE64_ENCODE_BOUND(payload_len) is always enough.
+*   \return SUCCEEDED or CODEC_BUFFER_TOO_SMALL.
+**/
+Status base64_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len);
+
+/** Base64 Decoder, single pass. Padded and unpadded input is accepted.
+*   \param  capacity    Size of 'decoded', BASE64_DECODE_BOUND(payload_len) is always enough.
+*   \return SUCCEEDED, CODEC_BUFFER_TOO_SMALL, BASE64_INVALID_CHARACTER or BASE64_INVALID_PADDING.
+**/
+Status base64_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len);
+
+/** Base6 Encoder. (Leaading '0x00' bytes will be replaced by character '0')
 *   \param  payload     byte array, bytes's value range: 0x00 ~ 0xFF.
 *   \param  payload_len Length of the payload.
 *   \param  encoded     String, store the encoded payload.
@@ -76,7 +219,7 @@ Status integer_swap(void *a, void *b, void *dtype);
 **/
 size_t base6encode(byte *payload, size_t payload_len, uint8_t *encoded);
 
-/** Base6 Decoder. (Leaading '0' characters will be ignored)
+/** Base6 Decoder. (Leaading '0' characters will be replaced by byte '0x00')
 *   \param  payload     The string need to be decode.
 *   \param  payload_len Length of the payload string.
 *   \param  decoded     byte array, store the decoded payload.
@@ -106,6 +249,17 @@ size_t base58encode(byte *payload, size_t payload_len, uint8_t *encoded);
 **/
 size_t base58decode(uint8_t *payload, size_t payload_len, byte *decoded);
 
+/** Base58 Decoder for payloads of a known length, decodes in a single pass.
+*   \param  payload     The string need to be decode.
+*   \param  payload_len Length of the payload string.
+*   \param  decoded     byte array, store the decoded payload.
+*   \param  decoded_len Expected length of the decoded payload.
+*   \return  0 on success.
+*           -1 on non-base58 character(s) in the payload string.
+*           -2 on decoded payload length not equal to 'decoded_len'.
+**/
+size_t base58decode_fixed(uint8_t *payload, size_t payload_len, byte *decoded, size_t decoded_len);
+
 /** Base58 Encoder. (Leaading '0x00' bytes will be replaced by character '1')
 *   \param  payload     byte array, byte's value range: 0x00 ~ 0xFF.
 *   \param  payload_len Length of the payload.
@@ -127,12 +281,89 @@ size_t base58check_encode(byte *payload, size_t payload_len, uint8_t *encoded);
 **/
 size_t base58check_decode(uint8_t *payload, size_t payload_len, byte *decoded);
 
+/* 0x10b0 ~ 0x10bf : Base64 */
+#define BASE64_INVALID_CHARACTER (void *)0x10b0
+#define BASE64_INVALID_PADDING   (void *)0x10b1 // Misplaced '=', data after it, or a cut last quantum.
+
+// Encoded length of 'n' bytes, padding included.
+#define BASE64_ENCODED_LEN(n) (((n) + 2) / 3 * 4)
+
+/** Base64 kernels.
+*   The scalar kernel works a group at a time with lookup tables, the AVX2 kernel
+*   converts 24 bytes to 32 characters per iteration.
+**/
+typedef enum base64_impl {
+	BASE64_AUTO   = 0x00, // The best kernel the CPU supports.
+	BASE64_SCALAR = 0x01,
+	BASE64_AVX2   = 0x02,
+} BASE64_IMPL;
+
+/** Select the kernel used by the base64 functions, the best one is selected by CPUID at load time.
+*   Not thread-safe, call it before converting from multiple threads.
+*   \param  impl        The kernel, BASE64_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status base64_select(BASE64_IMPL impl);
+
+/** Get the kernel in use. **/
+BASE64_IMPL base64_selected(void);
+
+/** State of a chunked base64 conversion, the input can be cut anywhere. **/
+typedef struct base64_stream_st Base64Stream;
+struct base64_stream_st {
+	uint8_t pending[4];  // Bytes short of a group (encoding), sextets of a quantum (decoding).
+	uint8_t pending_len;
+	uint8_t padding;     // '=' characters in the current quantum.
+	bool finished;       // A padded quantum ended the data.
+};
+
+/** Start a base64 encoding. **/
+void base64_encode_init(Base64Stream *stream);
+
+/** Encode the next chunk, the bytes short of a group are kept for the next call.
+*   \param  stream      The state.
+*   \param  data        The chunk.
+*   \param  len         Length of the chunk.
+*   \param  encoded     Store the characters, room for BASE64_ENCODED_LEN(len). Not NUL-terminated.
+*   \return how many characters were stored.
+**/
+size_t base64_encode_update(Base64Stream *stream, const byte *data, size_t len, uint8_t *encoded);
+
+/** Encode the kept bytes with padding and reset the state.
+*   \param  encoded     Store the characters, room for 4. Not NUL-terminated.
+*   \return how many characters were stored, 0 or 4.
+**/
+size_t base64_encode_final(Base64Stream *stream, uint8_t *encoded);
+
+/** Start a base64 decoding. **/
+void base64_decode_init(Base64Stream *stream);
+
+/** Decode the next chunk, the characters short of a quantum are kept for the next call.
+*   \param  stream      The state.
+*   \param  str         The chunk.
+*   \param  len         Length of the chunk.
+*   \param  decoded     Store the bytes, room for len / 4 * 3 + 3.
+*   \param  decoded_len Store how many bytes were stored.
+*   \return SUCCEEDED on success.
+*           BASE64_INVALID_CHARACTER or BASE64_INVALID_PADDING, the stream can't go on.
+**/
+Status base64_decode_update(Base64Stream *stream, const uint8_t *str, size_t len, byte *decoded, size_t *decoded_len);
+
+/** End a base64 decoding and reset the state. An unpadded last quantum is accepted.
+*   \param  decoded     Store the bytes of an unpadded last quantum, room for 2.
+*   \param  decoded_len Store how many bytes were stored.
+*   \return SUCCEEDED on success.
+*           BASE64_INVALID_PADDING if the data stops inside a quantum that can't end there.
+**/
+Status base64_decode_final(Base64Stream *stream, byte *decoded, size_t *decoded_len);
+
 /** Base64 Encoder.
 *   \param  payload     byte array, byte's value range: 0x00 ~ 0xFF.
 *   \param  payload_len Length of the payload.
 *   \param  encoded     String, store the encoded payload.
 *   \return  0 on success.
-*         else on decoded payload length, if param 'decoded' is NULL.
+*         else on encoded payload length, if param 'encoded' is NULL.
 **/
 size_t base64encode(byte *payload, size_t payload_len, uint8_t *encoded);
 
@@ -141,8 +372,8 @@ size_t base64encode(byte *payload, size_t payload_len, uint8_t *encoded);
 *   \param  payload_len Length of the payload string.
 *   \param  decoded     byte array, store the decoded payload.
 *   \return  0 on success.
-*           -1 on non-base64 character(s) in the payload string.
-*         else on encoded payload length, if param 'encoded' is NULL.
+*           -1 on non-base64 character(s) or bad padding in the payload string.
+*         else on decoded payload length, if param 'decoded' is NULL.
 **/
 size_t base64decode(uint8_t *payload, size_t payload_len, byte *decoded);
 
@@ -150,7 +381,7 @@ size_t base64decode(uint8_t *payload, size_t payload_len, byte *decoded);
  *  \param  payload     An integer represented in a base 2^8 array (Little-endian).
  *  \param  payload_len Length of the payload.
  *  \param  converted   Store the converted number, represented in a base 2^32 array (Little-endian).
- *                      Array's item will be reset to zero by memset().
+ *                      May be 'payload' itself, with room for the converted length.
  *  \return  0 on success.
  *        else on converted array's length, if param 'converted' is NULL.
 **/
@@ -160,7 +391,7 @@ size_t base2p8_to_base2p32(uint8_t *payload, size_t payload_len, uint32_t *conve
  *  \param  payload     An integer represented in a base 2^32 array (Little-endian).
  *  \param  payload_len Length of the payload.
  *  \param  converted   Store the converted number, represented in a base 2^8 array (Little-endian).
- *                      Array's item will be reset to zero by memset().
+ *                      May be 'payload' itself, with room for the converted length.
  *  \return  0 on success.
  *        else on converted array's length, if param 'converted' is NULL.
 **/
@@ -170,7 +401,7 @@ size_t base2p32_to_base2p8(uint32_t *payload, size_t payload_len, uint8_t *conve
  *  \param  payload     An integer represented in a base 2^16 array (Little-endian).
  *  \param  payload_len Length of the payload.
  *  \param  converted   Store the converted number, represented in a base 2^32 array (Little-endian).
- *                      Array's item will be reset to zero by memset().
+ *                      May be 'payload' itself, with room for the converted length.
  *  \return  0 on success.
  *        else on converted array's length, if param 'converted' is NULL.
 **/
@@ -180,7 +411,7 @@ size_t base2p16_to_base2p32(uint16_t *payload, size_t payload_len, uint32_t *con
  *  \param  payload     An integer represented in a base 2^32 array (Little-endian).
  *  \param  payload_len Length of the payload.
  *  \param  converted   Store the converted number, represented in a base 2^16 array (Little-endian).
- *                      Array's item will be reset to zero by memset().
+ *                      May be 'payload' itself, with room for the converted length.
  *  \return  0 on success.
  *        else on converted array's length, if param 'converted' is NULL.
 **/
@@ -30,11 +30,94 @@ extern "C" {
 
 // a^b (mod m)
 uint64_t quick_power_mod(uint64_t a, uint64_t b, uint64_t m);
+/** Transform mod P in place, through a plan built for the call.
+*   \param  on          false forward, true inverse.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
 // overflow when point > 0xaf45
-void ntt(uint64_t *a, uint32_t len, bool on);
+Status ntt(uint64_t *a, uint32_t len, bool on);
+
+/** NTT butterfly kernels.
+*   All of them multiply by the twiddles with Shoup's precomputed quotients, the AVX2 and
+*   AVX-512 kernels run 8 and 16 butterflies on 32-bit residues per iteration.
+**/
+typedef enum ntt_impl {
+	NTT_AUTO   = 0x00, // The best kernel the CPU supports.
+	NTT_SCALAR = 0x01,
+	NTT_AVX2   = 0x02,
+	NTT_AVX512 = 0x03,
+} NTT_IMPL;
+
+/** Select the kernel used by the transforms, the best one is selected by CPUID at load time.
+*   Not thread-safe, call it before transforming from multiple threads.
+*   \param  impl        The kernel, NTT_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status ntt_select(NTT_IMPL impl);
+
+/** Get the kernel in use. **/
+NTT_IMPL ntt_selected(void);
+
+
+/* 0x10d0 ~ 0x10df : Bigint */
+#define BIGINT_INVALID_MODULUS (void *)0x10d0 // Even, zero or negative.
+#define BIGINT_NOT_INVERTIBLE  (void *)0x10d1
+#define BIGINT_DIVIDE_BY_ZERO  (void *)0x10d2
+
+/** Product of two little-endian limb arrays.
+*   \param  r           Store a_len + b_len limbs, must not overlap 'a' or 'b'.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+Status d_mul(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r);
+
+/** d_mul with the NTT transforms split across threads, the same product.
+*   Operands shorter than parallel_threshold are multiplied on the calling thread.
+*   \param  threads     Threads per transform, 0 for one per online CPU.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+Status d_mul_parallel(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r,
+	uint32_t threads);
 
+/** A one-limb divisor with its reciprocal, set up once and used for many divisions. **/
+typedef struct limb_divisor_st LimbDivisor;
+struct limb_divisor_st {
+	uint32_t d;     // The divisor shifted until its top bit is set.
+	uint32_t v;     // floor((2^64 - 1) / d) - 2^32.
+	uint32_t shift;
+};
+
+/** \param  divisor     Not zero. **/
+void limb_divisor_init(LimbDivisor *d, uint32_t divisor);
+
+/** q = a / d, two multiplications per limb.
+*   \param  q           Store len limbs, may be 'a' or NULL.
+*   \return the remainder.
+**/
+uint32_t d_div_1(const uint32_t *a, uint32_t len, const LimbDivisor *d, uint32_t *q);
+
+/** Quotient and remainder of little-endian limb arrays: one-limb divisors by d_div_1, Knuth's
+*   Algorithm D, and Newton's reciprocal with d_mul for long divisors and quotients.
+*   \param  b           Taken without its top zero limbs, b_len below.
+*   \param  q           Store a_len - b_len + 1 limbs, one if a_len < b_len, or NULL.
+*   \param  r           Store b_len limbs, or NULL. Neither may overlap 'a' or 'b'.
+*   \return SUCCEEDED, MEMORY_ALLOCATE_FAILED or BIGINT_DIVIDE_BY_ZERO.
+**/
+Status d_div(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *q, uint32_t *r);
 
-void d_mul(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r);
+/** Multiplication thresholds, in limbs of the shorter operand.
+*   Run the Bigint bench to find the crossovers of a machine.
+**/
+typedef struct bigint_mul_config_st BigintMulConfig;
+struct bigint_mul_config_st {
+	uint32_t karatsuba_threshold; // Schoolbook below, at least 4.
+	uint32_t ntt_threshold;       // NTT from here on.
+	uint32_t parallel_threshold;  // d_mul_parallel uses threads from here on.
+};
+
+/** Set the thresholds for all threads, call it before multiplying from multiple threads. **/
+void Bigint_mul_config_set(const BigintMulConfig *config);
+void Bigint_mul_config_get(BigintMulConfig *config);
 
 typedef struct Bigint_st Bigint;
 struct Bigint_st {
@@ -52,10 +135,263 @@ Bigint Bigint_set_hexstr(Bigint *bn, uint8_t *str, size_t len);
 Bigint * Bigint_add(Bigint *a, Bigint *b);
 Bigint * Bigint_sub(Bigint *a, Bigint *b);
 Bigint * Bigint_mul(Bigint *a, Bigint *b);
+// Bigint_mul through d_mul_parallel, 'threads' 0 for one per online CPU.
+Bigint * Bigint_mul_parallel(Bigint *a, Bigint *b, uint32_t threads);
+// a / b rounded toward zero, BIGINT_DIVIDE_BY_ZERO for a zero 'b'.
 Bigint * Bigint_div(Bigint *a, Bigint *b);
-Bigint * Bigint_pow(Bigint *a, Bigint *order);
+
+/** a^e (mod order) by Montgomery multiplication, with a sliding window over the bits of 'e'.
+*   The time depends on 'e', use Bigint_pow_consttime for secret exponents. A negative 'a' or
+*   'e' is fine, a^-e is (1 / a)^e.
+*   \param  order       Odd and positive.
+*   \return the result in [0, order), MEMORY_ALLOCATE_FAILED, BIGINT_INVALID_MODULUS or
+*           BIGINT_NOT_INVERTIBLE for a negative 'e'.
+**/
+Bigint * Bigint_pow(Bigint *a, Bigint *e, Bigint *order);
+
+/** Bigint_pow with fixed 4-bit windows over all e->len limbs and every table entry read for
+*   each window, no branch or memory access depends on 'a' or 'e'. Only their lengths show.
+**/
+Bigint * Bigint_pow_consttime(Bigint *a, Bigint *e, Bigint *order);
+
+/** 1 / a (mod order) by Bernstein-Yang safegcd, a fixed number of divsteps for the length of
+*   'order', so it is constant-time in 'a' and fine for secrets.
+*   \param  order       Odd and positive.
+*   \return the inverse in [0, order), MEMORY_ALLOCATE_FAILED, BIGINT_INVALID_MODULUS or
+*           BIGINT_NOT_INVERTIBLE.
+**/
 Bigint * Bigint_ext(Bigint *a, Bigint *order);
 
+
+
+/** Cryptographically secure random bytes.
+*   Each thread has its own ChaCha20 generator, seeded from getrandom() and reseeded after every
+*   MiB of output and after fork(). The key is replaced after every refill,
+*   so earlier output can't be recovered from the state.
+*   \param  buf         Store the random bytes.
+*   \param  len         How many bytes.
+*   \return SUCCEEDED on success.
+*           FAILED if the operating system can't provide a seed.
+**/
+Status random_bytes(byte *buf, size_t len);
+
+
+
+/** RIPEMD-160 kernels.
+*   The scalar kernel hashes one message at a time,
+*   the SSE4.1, AVX2 and AVX-512 kernels hash 4, 8 and 16 messages side by side.
+**/
+typedef enum ripemd160_impl {
+	RIPEMD160_AUTO   = 0x00, // The best kernels the CPU supports.
+	RIPEMD160_SCALAR = 0x01,
+	RIPEMD160_SSE41  = 0x03,
+	RIPEMD160_AVX2   = 0x04,
+	RIPEMD160_AVX512 = 0x05,
+} RIPEMD160_IMPL;
+
+/** Select the kernel used by all ripemd160 and hash160 functions, the best one is selected by CPUID at load time.
+*   Messages that don't fill the lanes of a multi-lane kernel go to the narrower kernels, then the scalar one.
+*   Not thread-safe, call it before hashing from multiple threads.
+*   \param  impl        The kernel, RIPEMD160_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status ripemd160_select(RIPEMD160_IMPL impl);
+
+/** Get the kernel in use. **/
+RIPEMD160_IMPL ripemd160_selected(void);
+
+/** RIPEMD-160 digest.
+*   \param  data        The message.
+*   \param  len         Length of the message.
+*   \param  digest      Store the 20 bytes digest.
+**/
+void ripemd160(const byte *data, size_t len, byte *digest);
+
+/** RIPEMD-160 digests of many messages of the same length.
+*   \param  data        The messages, message i starts at data + i * stride.
+*   \param  stride      Distance in bytes between two messages.
+*   \param  len         Length of each message.
+*   \param  count       How many messages.
+*   \param  digests     Store the 20 bytes digests, packed.
+**/
+void ripemd160_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests);
+
+/** HASH160 digest, ripemd160(sha256(data)).
+*   \param  data        The message, usually a 33 or 65 bytes public key.
+*   \param  len         Length of the message.
+*   \param  digest      Store the 20 bytes digest.
+**/
+void hash160(const byte *data, size_t len, byte *digest);
+
+/** HASH160 digests of many messages of the same length, both hashes run on the multi-lane kernels.
+*   Parameters are the same as ripemd160_batch().
+**/
+void hash160_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests);
+
+
+
+#define SECP256K1_BATCH_SIZE 256 // Keys sharing one field inversion.
+
+/** Check a secp256k1 private key.
+*   \param  seckey      32 bytes big-endian scalar.
+*   \return true if the scalar is in [1, n-1].
+**/
+bool secp256k1_seckey_verify(const byte *seckey);
+
+/** Generate secp256k1 private keys, uniform in [1, n-1], from random_bytes().
+*   \param  seckeys     Store the private keys, 32 bytes each, packed.
+*   \param  count       How many private keys.
+*   \return SUCCEEDED on success.
+*           FAILED if no random bytes are available.
+**/
+Status secp256k1_seckey_generate(byte *seckeys, size_t count);
+
+/** Public key of a secp256k1 private key, seckey * G.
+*   The multiples of G are precomputed once, on the first call.
+*   The table lookups and the additions don't depend on the private key's bits.
+*   \param  seckey      32 bytes big-endian scalar.
+*   \param  pub         Store the public key, 33 bytes if compressed else 65 bytes.
+*   \param  compress    Whether the public key is compressed.
+*   \return SUCCEEDED on success.
+*           FAILED if the scalar is not in [1, n-1].
+**/
+Status secp256k1_pubkey_create(const byte *seckey, byte *pub, bool compress);
+
+/** Public keys of many private keys.
+*   Keys are multiplied in blocks of SECP256K1_BATCH_SIZE and each block shares one field inversion.
+*   \param  seckeys     The private keys, 32 bytes each, packed.
+*   \param  count       How many private keys.
+*   \param  pubs        Store the public keys, 33 bytes each if compressed else 65 bytes, packed.
+*                       The public key of an invalid private key is zero-filled.
+*   \param  compress    Whether the public keys are compressed.
+*   \param  statuses    Store each key's status, SUCCEEDED or FAILED if the scalar is not in [1, n-1].
+*   \return how many private keys are valid.
+**/
+size_t secp256k1_pubkey_create_batch(const byte *seckeys, size_t count, byte *pubs, bool compress, Status *statuses);
+
+
+
+/** SHA-256 kernels.
+*   The scalar and SHA-NI kernels hash one message at a time,
+*   the SSE4.1, AVX2 and AVX-512 kernels hash 4, 8 and 16 messages side by side.
+**/
+typedef enum sha256_impl {
+	SHA256_AUTO   = 0x00, // The best kernels the CPU supports.
+	SHA256_SCALAR = 0x01,
+	SHA256_SHANI  = 0x02,
+	SHA256_SSE41  = 0x03,
+	SHA256_AVX2   = 0x04,
+	SHA256_AVX512 = 0x05,
+} SHA256_IMPL;
+
+/** Select the kernel used by all sha256 functions, the best one is selected by CPUID at load time.
+*   Messages that don't fill the lanes of a multi-lane kernel go to the narrower kernels, then the scalar one.
+*   Not thread-safe, call it before hashing from multiple threads.
+*   \param  impl        The kernel, SHA256_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status sha256_select(SHA256_IMPL impl);
+
+/** Get the kernel in use. **/
+SHA256_IMPL sha256_selected(void);
+
+/** SHA-256 digest.
+*   \param  data        The message.
+*   \param  len         Length of the message.
+*   \param  digest      Store the 32 bytes digest.
+**/
+void sha256(const byte *data, size_t len, byte *digest);
+
+/** Double SHA-256 digest, sha256(sha256(data)).
+*   \param  data        The message.
+*   \param  len         Length of the message.
+*   \param  digest      Store the 32 bytes digest.
+**/
+void sha256d(const byte *data, size_t len, byte *digest);
+
+/** SHA-256 digests of many messages of the same length.
+*   \param  data        The messages, message i starts at data + i * stride.
+*   \param  stride      Distance in bytes between two messages.
+*   \param  len         Length of each message.
+*   \param  count       How many messages.
+*   \param  digests     Store the 32 bytes digests, packed.
+**/
+void sha256_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests);
+
+/** Double SHA-256 digests of many messages of the same length.
+*   Parameters are the same as sha256_batch().
+**/
+void sha256d_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests);
+
+
+
+/*
+*  Fixed-width 256-bit unsigned integers for the secp256k1 field and scalar math.
+*  Values live on the stack, nothing is allocated, and no branch or memory access depends on
+*  the values, so secret keys can go through every function.
+*/
+
+// Four little-endian 64-bit limbs.
+typedef struct uint256_st Uint256;
+struct uint256_st {
+	uint64_t n[4];
+};
+
+// Eight little-endian 64-bit limbs, a full product.
+typedef struct uint512_st Uint512;
+struct uint512_st {
+	uint64_t n[8];
+};
+
+extern const Uint256 uint256_p; // Field prime, 2^256 - 2^32 - 977.
+extern const Uint256 uint256_n; // Group order.
+
+/** Load and store 32 bytes big-endian. **/
+void uint256_set_bytes(Uint256 *r, const byte *bytes);
+void uint256_get_bytes(const Uint256 *a, byte *bytes);
+
+void uint256_set_u64(Uint256 *r, uint64_t v);
+bool uint256_is_zero(const Uint256 *a);
+
+/** Compare two integers.
+*   \return -1, 0 or 1 as 'a' is less than, equal to or greater than 'b'.
+**/
+int uint256_cmp(const Uint256 *a, const Uint256 *b);
+
+/** r = a + b (mod 2^256), 'r' may alias the inputs.
+*   \return the carry, 0 or 1.
+**/
+uint64_t uint256_add(Uint256 *r, const Uint256 *a, const Uint256 *b);
+
+/** r = a - b (mod 2^256), 'r' may alias the inputs.
+*   \return the borrow, 1 if a < b.
+**/
+uint64_t uint256_sub(Uint256 *r, const Uint256 *a, const Uint256 *b);
+
+/** Full 512-bit product, r = a * b. **/
+void uint256_mul(Uint512 *r, const Uint256 *a, const Uint256 *b);
+void uint256_sqr(Uint512 *r, const Uint256 *a);
+
+/** Reduce a 512-bit integer mod p, folding with 2^256 = 2^32 + 977 (mod p). **/
+void uint256_reduce_p(Uint256 *r, const Uint512 *a);
+
+/** Reduce a 512-bit integer mod n, folding with 2^256 = 2^256 - n (mod n), a 129-bit constant. **/
+void uint256_reduce_n(Uint256 *r, const Uint512 *a);
+
+/** Reduce a 256-bit integer, one conditional subtraction as p and n are above 2^255. **/
+void uint256_mod_p(Uint256 *r, const Uint256 *a);
+void uint256_mod_n(Uint256 *r, const Uint256 *a);
+
+/** Arithmetic mod p and mod n, the inputs must be reduced and so is the result. 'r' may alias the inputs. **/
+void uint256_add_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_sub_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_mul_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_add_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_sub_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_mul_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b);
+
 #ifdef __cpluscplus
 }
 #endif
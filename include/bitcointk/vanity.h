@@ -0,0 +1,86 @@
+/** 
+*  MIT LICENSE
+*  Copyright (c) 2018 Yirain Suen
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to
+*  deal in the Software without restriction, including without limitation the
+*  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+*  sell copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in
+*  all copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+*  IN THE SOFTWARE.
+**/
+/** 
+*  AUTO-GENERATED CODE, DO NOT EDIT EXCEPT EXPERIMENTALLY
+*  Maintainers: Do not include this header internal to this library.
+**/
+#ifdef __cpluscplus
+extern "C" {
+#endif
+#include "common.h"
+#include "address.h"
+/* 0x1080 ~ 0x109f : Vanity */
+#define VANITY_INVALID_PATTERN     (void *)0x1080 // Bad character, too long, or no address can match.
+#define VANITY_PATTERN_TOO_BROAD   (void *)0x1081 // Too many case variants.
+#define VANITY_THREAD_FAILED       (void *)0x1082
+
+typedef enum vanity_match {
+	VANITY_PREFIX         = 0x01, // Base58 address prefix, e.g. "1Love".
+	VANITY_PREFIX_NOCASE  = 0x02, // Base58 address prefix, any letter case.
+	VANITY_HASH160_PREFIX = 0x03, // Hexadecimal hash160 prefix, e.g. "0000".
+} VANITY_MATCH;
+
+typedef struct vanity_stats_st VanityStats;
+struct vanity_stats_st {
+	uint64_t keys;          // Keys tested.
+	double seconds;         // Elapsed time.
+	double keys_per_second;
+};
+
+typedef struct vanity_config_st VanityConfig;
+struct vanity_config_st {
+	const uint8_t *pattern; // NUL-terminated.
+	VANITY_MATCH match;
+	bool compress;          // Whether the public keys are compressed.
+	ADDRESS_TYPE addr_type;
+	uint32_t threads;       // Worker threads, 0 for one per online CPU.
+	size_t max_hits;        // Stop after this many hits, at least 1.
+	uint64_t max_keys;      // Stop after about this many keys, 0 for no limit.
+	// Called from the calling thread about once a second, may be NULL.
+	void (*progress)(const VanityStats *stats, void *arg);
+	void *progress_arg;
+};
+
+typedef struct vanity_hit_st VanityHit;
+struct vanity_hit_st {
+	byte priv_raw[32];
+	byte pub_raw[65];      // 33 bytes used if compressed.
+	uint8_t address[ADDRESS_SLOT_SIZE];
+};
+
+/** Search for keys whose address or hash160 starts with a pattern.
+*   Every worker walks its own range of consecutive keys from a random start.
+*   The pattern is turned into ranges of hash160 values once, so candidates are compared
+*   as hash160s and only the hits are Base58 encoded.
+*   \param  config      The search.
+*   \param  hits        Store the hits, room for config->max_hits.
+*   \param  hit_count   Store how many hits were found.
+*   \param  stats       Store the keys tested and the speed, may be NULL.
+*   \return SUCCEEDED when the search stops on max_hits or max_keys, or every worker ran out of keys.
+*           FAILED when config->max_hits is 0 or no random start key can be drawn.
+*           VANITY_INVALID_PATTERN, VANITY_PATTERN_TOO_BROAD or VANITY_THREAD_FAILED.
+**/
+Status vanity_search(const VanityConfig *config, VanityHit *hits, size_t *hit_count, VanityStats *stats);
+
+#ifdef __cpluscplus
+}
+#endif
@@ -5,6 +5,13 @@
 #include "common.h"
 /** AUTOHEADER TAG: DELETE END **/
 
+/* 0x1060 ~ 0x107f : Address */
+#define ADDRESS_INVALID_LENGTH    (void *)0x1060
+#define ADDRESS_INVALID_CHARACTER (void *)0x1061
+#define ADDRESS_INVALID_CHECKSUM  (void *)0x1062
+
+#define ADDRESS_SLOT_SIZE 36 // 35 charaters long at most plus '\0'
+
 // Type defines.
 typedef enum prefix {
 	PREFIX_PRIV_MAINNET = 0x80,
@@ -37,7 +44,8 @@ typedef enum privkey_format {
 } PRIVKEY_FORMAT;
 
 // Basic functions.
-void ecdsa_secp256k1_generate_private_key(byte *priv_raw);
+// Private keys come from the thread's ChaCha20 generator, see random_bytes().
+Status ecdsa_secp256k1_generate_private_key(byte *priv_raw);
 Status ecdsa_secp256k1_privkey_to_pubkey(byte *priv_raw, byte *pub_raw, bool compress);
 void raw_to_wif(byte *priv_raw, uint8_t *priv_wif, bool compress, NETWORK_TYPE type);
 Status wif_to_raw(uint8_t *priv_wif, byte *priv_raw);
@@ -47,6 +55,91 @@ Status address_to_hash160(uint8_t *address, byte *hash160);
 Status privkey_validation(uint8_t *key, size_t len, PRIVKEY_FORMAT format);
 uint8_t selector(uint16_t item);
 
+// Batch functions.
+/** Generate many private keys, uniform in [1, n-1].
+*   \param  priv_raws   Store the private keys, 32 bytes each, packed.
+*   \param  count       How many private keys.
+*   \return SUCCEEDED on success.
+*           FAILED if no random bytes are available.
+**/
+Status ecdsa_secp256k1_generate_private_keys(byte *priv_raws, size_t count);
+
+/** Get the public keys of many private keys, see secp256k1_pubkey_create_batch().
+*   \param  priv_raws   The private keys, 32 bytes each, packed.
+*   \param  count       How many private keys.
+*   \param  pub_raws    Store the public keys, 33 bytes each if compressed else 65 bytes, packed.
+*   \param  compress    Whether the public keys are compressed.
+*   \param  statuses    Store each key's status, SUCCEEDED or FAILED if the key is out of range.
+*   \return how many private keys are valid.
+**/
+size_t ecdsa_secp256k1_privkey_to_pubkey_batch(byte *priv_raws, size_t count, byte *pub_raws, bool compress,
+	Status *statuses);
+
+/** Get the hash160 values of many addresses.
+*   \param  addresses   Array of NUL-terminated address strings.
+*   \param  count       How many addresses.
+*   \param  hash160s    Store the hash160 values, 20 bytes per address, packed.
+*   \param  statuses    Store each address's status: SUCCEEDED, ADDRESS_INVALID_LENGTH,
+*                       ADDRESS_INVALID_CHARACTER or ADDRESS_INVALID_CHECKSUM.
+*   \return how many addresses are valid.
+**/
+size_t address_to_hash160_batch(uint8_t **addresses, size_t count, byte *hash160s, Status *statuses);
+
+/** Get the hash160 values of the addresses in a newline-delimited buffer.
+*   Empty lines are skipped and a '\r' before the '\n' is ignored.
+*   \param  buffer      Addresses, one per line.
+*   \param  buffer_len  Length of the buffer.
+*   \param  hash160s    Store the hash160 values, 20 bytes per address, packed.
+*   \param  statuses    Store each address's status, same as address_to_hash160_batch().
+*   \param  capacity    How many items 'hash160s' and 'statuses' can hold.
+*   \param  count       Store how many addresses were read from the buffer (<= capacity).
+*   \return how many addresses are valid.
+**/
+size_t address_to_hash160_lines(uint8_t *buffer, size_t buffer_len, byte *hash160s, Status *statuses,
+	size_t capacity, size_t *count);
+
+/** Get the addresses of many public keys.
+*   \param  pub_raws    The public keys, 33 bytes each if compressed else 65 bytes, packed.
+*   \param  count       How many public keys.
+*   \param  addresses   Store the NUL-terminated addresses, one per ADDRESS_SLOT_SIZE bytes slot.
+*   \param  compress    Whether the public keys are compressed.
+*   \param  addr_type   Type of the addresses.
+**/
+void pub_to_address_batch(byte *pub_raws, size_t count, uint8_t *addresses, bool compress, ADDRESS_TYPE addr_type);
+
+/******************** Key range walker ********************/
+/** Walk consecutive private keys k, k + 1, k + 2, ... and derive their public keys by adding G,
+*   each block of SECP256K1_BATCH_SIZE keys shares one field inversion.
+**/
+typedef struct key_walker_st KeyWalker;
+struct key_walker_st {
+	byte priv_raw[32]; // Private key of the next public key.
+	byte pub_raw[65];  // Next public key, uncompressed.
+	bool exhausted;    // The walk went past n - 1.
+};
+
+/** Start a walk.
+*   \param  walker      The walker.
+*   \param  start       The first private key, 32 bytes.
+*   \return SUCCEEDED on success.
+*           FAILED if the key is not in [1, n-1].
+**/
+Status key_walker_init(KeyWalker *walker, const byte *start);
+
+/** Derive the next keys of a walk, key i of the call is walker->priv_raw + i before the call.
+*   'pub_raws', 'hash160s' and 'addresses' may each be NULL.
+*   \param  walker      The walker.
+*   \param  count       How many keys.
+*   \param  pub_raws    Store the public keys, 33 bytes each if compressed else 65 bytes, packed.
+*   \param  hash160s    Store the hash160 values of the public keys, 20 bytes each, packed.
+*   \param  addresses   Store the NUL-terminated addresses, one per ADDRESS_SLOT_SIZE bytes slot.
+*   \param  compress    Whether the public keys are compressed.
+*   \param  addr_type   Type of the addresses.
+*   \return how many keys were derived, less than 'count' only if the walk reached n - 1.
+**/
+size_t key_walker_next(KeyWalker *walker, size_t count, byte *pub_raws, byte *hash160s, uint8_t *addresses,
+	bool compress, ADDRESS_TYPE addr_type);
+
 /******************** Father ********************/
 typedef struct root_address_st root_Address;
 struct root_address_st {
@@ -68,7 +161,8 @@ struct p2pkh_main_address_st {
 	uint8_t * (*get_wif)(P2PKH_Main_Address *);
 	bool compress;
 };
-// Allocate on heap memory.
+// Allocate on heap memory with a new private key.
+// MEMORY_ALLOCATE_FAILED, or FAILED (NULL) if no random bytes are available.
 P2PKH_Main_Address * new_P2PKH_Main(bool compress);
 P2PKH_Main_Address * new_P2PKH_Main_from_key(const uint8_t *anyformat, bool compress);
 Status delete_P2PKH_Main(P2PKH_Main_Address *self);
@@ -134,5 +228,8 @@ Status Initialize_P2SH_Test(P2SH_Test_Address *addr, bool compress);
 Status Abandon_P2SH_Test(P2SH_Test_Address *addr);
 
 /** AUTOHEADER TAG: DELETE BEGIN **/
+// Payload prefix byte of an address type.
+byte address_prefix(ADDRESS_TYPE addr_type);
+
 #endif
 /** AUTOHEADER TAG: DELETE END **/
\ No newline at end of file
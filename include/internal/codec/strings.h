@@ -14,32 +14,89 @@
 
 int32_t get_strlen(int8_t *string);
 **/
+/* 0x10a0 ~ 0x10af : Strings */
+#define HEXSTR_ODD_LENGTH        (void *)0x10a0
+#define HEXSTR_INVALID_CHARACTER (void *)0x10a1
+
+typedef enum hex_case {
+	HEX_UPPER = 0x00, // "0A1B2C"
+	HEX_LOWER = 0x01, // "0a1b2c"
+} HEX_CASE;
+
+/** Hexadecimal kernels.
+*   The scalar kernel works with lookup tables, the SSSE3 and AVX2 kernels
+*   convert 16 and 32 bytes per iteration.
+**/
+typedef enum hex_impl {
+	HEX_AUTO   = 0x00, // The best kernel the CPU supports.
+	HEX_SCALAR = 0x01,
+	HEX_SSSE3  = 0x02,
+	HEX_AVX2   = 0x03,
+} HEX_IMPL;
+
+/** Select the kernel used by the hexadecimal conversions, the best one is selected by CPUID at load time.
+*   Not thread-safe, call it before converting from multiple threads.
+*   \param  impl        The kernel, HEX_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status hex_select(HEX_IMPL impl);
+
+/** Get the kernel in use. **/
+HEX_IMPL hex_selected(void);
+
 /** Convert a hexadecimal string to a byte array.
+*   Both letter cases are accepted, every character is checked.
 *   \param  str         Hexadecimal string.
 *   \param  str_len     String length, must be even.
-*   \param  arr         Store the byte array.
-*   \return  0 on success.
-*           -1 on odd string length.
-*           -2 on non-hexadecimal characters in the string.
+*   \param  arr         Store the byte array, str_len / 2 bytes. Undefined on error.
+*   \return SUCCEEDED on success.
+*           HEXSTR_ODD_LENGTH on odd string length.
+*           HEXSTR_INVALID_CHARACTER on non-hexadecimal characters in the string.
 *   \example: "0A1B2C" -> {'0x0A', '0X1B', '0X2C'}
 **/
-Status hexstr_to_bytearr(uint8_t *str, size_t str_len, byte *arr);
+Status hexstr_to_bytearr(const uint8_t *str, size_t str_len, byte *arr);
 
-/** Convert a byte array to a hexadecimal string.
-*   \param  arr         byte array, byte's value range: -128 ~ 127.
+/** Convert a byte array to an uppercase hexadecimal string.
+*   \param  arr         byte array.
 *   \param  arr_len     The length of arr.
-*   \param  str         Store the hexadecimal string.
-*   \return  0 on success.
-*           -1 on byte(s) value out range.
+*   \param  str         Store the hexadecimal string, arr_len * 2 + 1 bytes with the NUL.
+*   \return SUCCEEDED.
 *   \example: {'0x0A', '0X1B', '0X2C'} -> "0A1B2C"
 **/
-Status bytearr_to_hexstr(byte *arr, size_t arr_len, uint8_t *str);
+Status bytearr_to_hexstr(const byte *arr, size_t arr_len, uint8_t *str);
+
+/** Convert a byte array to a hexadecimal string in the given letter case.
+*   \param  arr         byte array.
+*   \param  arr_len     The length of arr.
+*   \param  str         Store the hexadecimal string, arr_len * 2 + 1 bytes with the NUL.
+*   \param  hex_case    HEX_UPPER or HEX_LOWER.
+*   \return SUCCEEDED.
+**/
+Status bytearr_to_hexstr_case(const byte *arr, size_t arr_len, uint8_t *str, HEX_CASE hex_case);
+
 void bytearr_reverse(byte *arr, size_t size);
 void hexstr_reverse(uint8_t *str, size_t len);
 void * lsrtip(const void *arr, size_t arr_size, size_t *r_size);
 void * rsrtip(const void *arr, size_t arr_size, size_t *r_size);
 Status integer_swap(void *a, void *b, void *dtype);
 
+/** AUTOHEADER TAG: DELETE BEGIN **/
+extern const uint8_t hex_digits[2][16]; // Uppercase, lowercase.
+
+/** Hexadecimal kernels, convert the longest prefix they handle.
+*   The encoders write two characters per converted byte and no NUL, 'digits' is one of hex_digits.
+*   The decoders stop before a block with a non-hexadecimal character.
+*   \return how many bytes were converted.
+**/
+size_t hex_encode_scalar(const byte *arr, size_t arr_len, uint8_t *str, const uint8_t *digits);
+size_t hex_encode_ssse3(const byte *arr, size_t arr_len, uint8_t *str, const uint8_t *digits);
+size_t hex_encode_avx2(const byte *arr, size_t arr_len, uint8_t *str, const uint8_t *digits);
+size_t hex_decode_scalar(const uint8_t *str, size_t arr_len, byte *arr);
+size_t hex_decode_ssse3(const uint8_t *str, size_t arr_len, byte *arr);
+size_t hex_decode_avx2(const uint8_t *str, size_t arr_len, byte *arr);
+/** AUTOHEADER TAG: DELETE END **/
+
 /** AUTOHEADER TAG: DELETE BEGIN **/
 #endif
 /** AUTOHEADER TAG: DELETE END **/
\ No newline at end of file
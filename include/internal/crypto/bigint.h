@@ -7,10 +7,66 @@
 // Inner functions.
 void d_add(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r);
 void d_sub(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r);
-void d_div(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r);
 int8_t d_equal(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len);
 /** AUTOHEADER TAG: DELETE END **/
-void d_mul(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r);
+/* 0x10d0 ~ 0x10df : Bigint */
+#define BIGINT_INVALID_MODULUS (void *)0x10d0 // Even, zero or negative.
+#define BIGINT_NOT_INVERTIBLE  (void *)0x10d1
+#define BIGINT_DIVIDE_BY_ZERO  (void *)0x10d2
+
+/** Product of two little-endian limb arrays.
+*   \param  r           Store a_len + b_len limbs, must not overlap 'a' or 'b'.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+Status d_mul(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r);
+
+/** d_mul with the NTT transforms split across threads, the same product.
+*   Operands shorter than parallel_threshold are multiplied on the calling thread.
+*   \param  threads     Threads per transform, 0 for one per online CPU.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+Status d_mul_parallel(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r,
+	uint32_t threads);
+
+/** A one-limb divisor with its reciprocal, set up once and used for many divisions. **/
+typedef struct limb_divisor_st LimbDivisor;
+struct limb_divisor_st {
+	uint32_t d;     // The divisor shifted until its top bit is set.
+	uint32_t v;     // floor((2^64 - 1) / d) - 2^32.
+	uint32_t shift;
+};
+
+/** \param  divisor     Not zero. **/
+void limb_divisor_init(LimbDivisor *d, uint32_t divisor);
+
+/** q = a / d, two multiplications per limb.
+*   \param  q           Store len limbs, may be 'a' or NULL.
+*   \return the remainder.
+**/
+uint32_t d_div_1(const uint32_t *a, uint32_t len, const LimbDivisor *d, uint32_t *q);
+
+/** Quotient and remainder of little-endian limb arrays: one-limb divisors by d_div_1, Knuth's
+*   Algorithm D, and Newton's reciprocal with d_mul for long divisors and quotients.
+*   \param  b           Taken without its top zero limbs, b_len below.
+*   \param  q           Store a_len - b_len + 1 limbs, one if a_len < b_len, or NULL.
+*   \param  r           Store b_len limbs, or NULL. Neither may overlap 'a' or 'b'.
+*   \return SUCCEEDED, MEMORY_ALLOCATE_FAILED or BIGINT_DIVIDE_BY_ZERO.
+**/
+Status d_div(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *q, uint32_t *r);
+
+/** Multiplication thresholds, in limbs of the shorter operand.
+*   Run the Bigint bench to find the crossovers of a machine.
+**/
+typedef struct bigint_mul_config_st BigintMulConfig;
+struct bigint_mul_config_st {
+	uint32_t karatsuba_threshold; // Schoolbook below, at least 4.
+	uint32_t ntt_threshold;       // NTT from here on.
+	uint32_t parallel_threshold;  // d_mul_parallel uses threads from here on.
+};
+
+/** Set the thresholds for all threads, call it before multiplying from multiple threads. **/
+void Bigint_mul_config_set(const BigintMulConfig *config);
+void Bigint_mul_config_get(BigintMulConfig *config);
 
 typedef struct Bigint_st Bigint;
 struct Bigint_st {
@@ -28,8 +84,31 @@ Bigint Bigint_set_hexstr(Bigint *bn, uint8_t *str, size_t len);
 Bigint * Bigint_add(Bigint *a, Bigint *b);
 Bigint * Bigint_sub(Bigint *a, Bigint *b);
 Bigint * Bigint_mul(Bigint *a, Bigint *b);
+// Bigint_mul through d_mul_parallel, 'threads' 0 for one per online CPU.
+Bigint * Bigint_mul_parallel(Bigint *a, Bigint *b, uint32_t threads);
+// a / b rounded toward zero, BIGINT_DIVIDE_BY_ZERO for a zero 'b'.
 Bigint * Bigint_div(Bigint *a, Bigint *b);
-Bigint * Bigint_pow(Bigint *a, Bigint *order);
+
+/** a^e (mod order) by Montgomery multiplication, with a sliding window over the bits of 'e'.
+*   The time depends on 'e', use Bigint_pow_consttime for secret exponents. A negative 'a' or
+*   'e' is fine, a^-e is (1 / a)^e.
+*   \param  order       Odd and positive.
+*   \return the result in [0, order), MEMORY_ALLOCATE_FAILED, BIGINT_INVALID_MODULUS or
+*           BIGINT_NOT_INVERTIBLE for a negative 'e'.
+**/
+Bigint * Bigint_pow(Bigint *a, Bigint *e, Bigint *order);
+
+/** Bigint_pow with fixed 4-bit windows over all e->len limbs and every table entry read for
+*   each window, no branch or memory access depends on 'a' or 'e'. Only their lengths show.
+**/
+Bigint * Bigint_pow_consttime(Bigint *a, Bigint *e, Bigint *order);
+
+/** 1 / a (mod order) by Bernstein-Yang safegcd, a fixed number of divsteps for the length of
+*   'order', so it is constant-time in 'a' and fine for secrets.
+*   \param  order       Odd and positive.
+*   \return the inverse in [0, order), MEMORY_ALLOCATE_FAILED, BIGINT_INVALID_MODULUS or
+*           BIGINT_NOT_INVERTIBLE.
+**/
 Bigint * Bigint_ext(Bigint *a, Bigint *order);
 
 /** AUTOHEADER TAG: DELETE BEGIN **/
@@ -8,17 +8,134 @@
 #define P 2013265921 // 15 * 2^27 + 1
 #define G 31
 
+// Three primes p = k * 2^m + 1 below 2^31 and their primitive roots. A product of 32-bit limbs
+// is exact mod p0 * p1 * p2 > 2^92 while a coefficient stays below 2^88.
+#define NTT_PRIME_COUNT 3
+#define NTT_P0 2013265921 // 15 * 2^27 + 1
+#define NTT_G0 31
+#define NTT_P1 1811939329 // 27 * 2^26 + 1
+#define NTT_G1 13
+#define NTT_P2 2113929217 // 63 * 2^25 + 1
+#define NTT_G2 5
+#define NTT_MAX_LOG 25    // The smallest 2^m.
+
 #include "internal/common.h"
 
 
 /** AUTOHEADER TAG: DELETE END **/
 // a^b (mod m)
 uint64_t quick_power_mod(uint64_t a, uint64_t b, uint64_t m);
+
+/** Transform mod P in place, through a plan built for the call.
+*   \param  on          false forward, true inverse.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
 // overflow when point > 0xaf45
-void ntt(uint64_t *a, uint32_t len, bool on);
+Status ntt(uint64_t *a, uint32_t len, bool on);
+
+/** NTT butterfly kernels.
+*   All of them multiply by the twiddles with Shoup's precomputed quotients, the AVX2 and
+*   AVX-512 kernels run 8 and 16 butterflies on 32-bit residues per iteration.
+**/
+typedef enum ntt_impl {
+	NTT_AUTO   = 0x00, // The best kernel the CPU supports.
+	NTT_SCALAR = 0x01,
+	NTT_AVX2   = 0x02,
+	NTT_AVX512 = 0x03,
+} NTT_IMPL;
+
+/** Select the kernel used by the transforms, the best one is selected by CPUID at load time.
+*   Not thread-safe, call it before transforming from multiple threads.
+*   \param  impl        The kernel, NTT_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status ntt_select(NTT_IMPL impl);
+
+/** Get the kernel in use. **/
+NTT_IMPL ntt_selected(void);
 
 /** AUTOHEADER TAG: DELETE BEGIN **/
-void get_Wn();
-void rader(uint64_t *a, uint32_t len);
+extern const uint64_t ntt_primes[NTT_PRIME_COUNT];
+
+/*
+*  Everything a transform of one length mod one prime needs, built once and read-only afterwards,
+*  so threads can share a plan.
+*/
+typedef struct ntt_plan_st NttPlan;
+struct ntt_plan_st {
+	uint32_t len;             // A power of two, at most 2^NTT_MAX_LOG.
+	uint32_t prime;           // Index in ntt_primes.
+	uint32_t p;
+	uint32_t p_inv;           // -1 / p (mod 2^32), for Montgomery products.
+	uint32_t len_inv;         // 1 / len (mod p).
+	uint32_t len_inv_shoup;
+	// Radix-2 plans.
+	uint32_t *rev;            // Bit-reversal permutation.
+	uint32_t *twiddles;       // The stage with half-length m reads w_2m^k at [m + k], k < m.
+	uint32_t *twiddles_shoup; // floor(twiddle * 2^32 / p), same layout.
+	// Four-step plans, the residues are a matrix of col_plan->len rows and row_plan->len columns.
+	NttPlan *col_plan;        // Transforms down the columns, NULL for radix-2 plans.
+	NttPlan *row_plan;        // Transforms along the rows.
+	uint32_t *step_twiddles;  // w^(k * c) at [k * cols + c] in Montgomery form, then w^-(k * c) / len.
+};
+
+// Four-step from this length on, 32 MiB of residues, where the radix-2 stages stream from memory.
+// Its plans are also smaller, 8 bytes per point instead of 12.
+#define NTT_FOUR_STEP_LOG 23
+#define NTT_BLOCK_COLS    16       // One 64-byte line of every row.
+#define NTT_FOUR_STEP_MIN (1 << 8) // The columns fill the strips.
+#define NTT_MAX_THREADS   64
+
+/** Build a radix-2 plan, one allocation holds the tables.
+*   \param  prime       Index in ntt_primes.
+*   \return the plan or MEMORY_ALLOCATE_FAILED.
+**/
+NttPlan * new_NttPlan(uint32_t len, uint32_t prime);
+
+/** Build a four-step plan: column transforms on strips of NTT_BLOCK_COLS columns that stay in
+*   cache, a twiddle step, then row transforms. There is no bit-reversal pass over the whole
+*   array. The forward transform leaves X[k_r + rows * k_c] at [k_r * cols + k_c], the transposed
+*   order, and the inverse takes that order back, so convolutions don't see it. Below
+*   NTT_FOUR_STEP_MIN it builds a radix-2 plan, the same order with one row.
+*   \return the plan or MEMORY_ALLOCATE_FAILED.
+**/
+NttPlan * new_NttPlan_four_step(uint32_t len, uint32_t prime);
+void delete_NttPlan(NttPlan *plan);
+
+/** Transform plan->len residues in place mod plan->p.
+*   \param  a           Residues below p.
+*   \param  on          false forward, true inverse.
+**/
+void ntt_execute(const NttPlan *plan, uint32_t *a, bool on);
+
+/** Transform like ntt_execute with up to 'threads' threads, at most NTT_MAX_THREADS.
+*   The rows and the strips of a four-step plan are split across the threads, a radix-2 plan
+*   runs on the calling thread. Threads that can't be started leave their share to the calling
+*   thread, so it doesn't fail.
+**/
+void ntt_execute_parallel(const NttPlan *plan, uint32_t *a, bool on, uint32_t threads);
+
+/** Pointwise a[i] = a[i] * b[i] (mod p) of plan->len residues. **/
+void ntt_mul(const NttPlan *plan, uint32_t *a, const uint32_t *b);
+
+/** Butterfly kernels, one stage with half-length 'm' over 'len' residues below 'p < 2^31'.
+*   'w' and 'w_shoup' are the stage's twiddles. The SIMD kernels need 'm' to be a multiple of
+*   their lanes.
+**/
+void ntt_stage_scalar(uint32_t *a, uint32_t len, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p);
+void ntt_stage_avx2(uint32_t *a, uint32_t len, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p);
+void ntt_stage_avx512(uint32_t *a, uint32_t len, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p);
+
+/** Four-step column kernels on a strip of NTT_BLOCK_COLS columns, 'rows' lines 'stride' apart.
+*   The stage kernels run one stage with half-length 'm' down the columns, a line pair shares the
+*   twiddle w[k]. The twiddle kernels multiply by 'w', laid out like the strip, in Montgomery form.
+**/
+void ntt_col_stage_scalar(uint32_t *a, size_t stride, uint32_t rows, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p);
+void ntt_col_stage_avx2(uint32_t *a, size_t stride, uint32_t rows, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p);
+void ntt_col_stage_avx512(uint32_t *a, size_t stride, uint32_t rows, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p);
+void ntt_col_twiddle_scalar(uint32_t *a, size_t stride, uint32_t rows, const uint32_t *w, uint32_t p, uint32_t p_inv);
+void ntt_col_twiddle_avx2(uint32_t *a, size_t stride, uint32_t rows, const uint32_t *w, uint32_t p, uint32_t p_inv);
+void ntt_col_twiddle_avx512(uint32_t *a, size_t stride, uint32_t rows, const uint32_t *w, uint32_t p, uint32_t p_inv);
 #endif
 /** AUTOHEADER TAG: DELETE END **/
\ No newline at end of file
@@ -0,0 +1,26 @@
+/** AUTOHEADER TAG: DELETE BEGIN **/
+#ifndef _CRYPTO_RANDOM_
+#define _CRYPTO_RANDOM_
+
+#include "internal/common.h"
+/** AUTOHEADER TAG: DELETE END **/
+
+/** Cryptographically secure random bytes.
+*   Each thread has its own ChaCha20 generator, seeded from getrandom() and reseeded after every
+*   MiB of output and after fork(). The key is replaced after every refill,
+*   so earlier output can't be recovered from the state.
+*   \param  buf         Store the random bytes.
+*   \param  len         How many bytes.
+*   \return SUCCEEDED on success.
+*           FAILED if the operating system can't provide a seed.
+**/
+Status random_bytes(byte *buf, size_t len);
+
+/** AUTOHEADER TAG: DELETE BEGIN **/
+#define RANDOM_RESEED_INTERVAL (1 << 20)
+
+// ChaCha20 block function (RFC 8439), 'state' is the 16 input words.
+void chacha20_block(const uint32_t *state, byte *out);
+
+#endif
+/** AUTOHEADER TAG: DELETE END **/
@@ -0,0 +1,72 @@
+/** AUTOHEADER TAG: DELETE BEGIN **/
+#ifndef _CRYPTO_RIPEMD160_
+#define _CRYPTO_RIPEMD160_
+
+#include "internal/common.h"
+/** AUTOHEADER TAG: DELETE END **/
+
+/** RIPEMD-160 kernels.
+*   The scalar kernel hashes one message at a time,
+*   the SSE4.1, AVX2 and AVX-512 kernels hash 4, 8 and 16 messages side by side.
+**/
+typedef enum ripemd160_impl {
+	RIPEMD160_AUTO   = 0x00, // The best kernels the CPU supports.
+	RIPEMD160_SCALAR = 0x01,
+	RIPEMD160_SSE41  = 0x03,
+	RIPEMD160_AVX2   = 0x04,
+	RIPEMD160_AVX512 = 0x05,
+} RIPEMD160_IMPL;
+
+/** Select the kernel used by all ripemd160 and hash160 functions, the best one is selected by CPUID at load time.
+*   Messages that don't fill the lanes of a multi-lane kernel go to the narrower kernels, then the scalar one.
+*   Not thread-safe, call it before hashing from multiple threads.
+*   \param  impl        The kernel, RIPEMD160_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status ripemd160_select(RIPEMD160_IMPL impl);
+
+/** Get the kernel in use. **/
+RIPEMD160_IMPL ripemd160_selected(void);
+
+/** RIPEMD-160 digest.
+*   \param  data        The message.
+*   \param  len         Length of the message.
+*   \param  digest      Store the 20 bytes digest.
+**/
+void ripemd160(const byte *data, size_t len, byte *digest);
+
+/** RIPEMD-160 digests of many messages of the same length.
+*   \param  data        The messages, message i starts at data + i * stride.
+*   \param  stride      Distance in bytes between two messages.
+*   \param  len         Length of each message.
+*   \param  count       How many messages.
+*   \param  digests     Store the 20 bytes digests, packed.
+**/
+void ripemd160_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests);
+
+/** HASH160 digest, ripemd160(sha256(data)).
+*   \param  data        The message, usually a 33 or 65 bytes public key.
+*   \param  len         Length of the message.
+*   \param  digest      Store the 20 bytes digest.
+**/
+void hash160(const byte *data, size_t len, byte *digest);
+
+/** HASH160 digests of many messages of the same length, both hashes run on the multi-lane kernels.
+*   Parameters are the same as ripemd160_batch().
+**/
+void hash160_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests);
+
+/** AUTOHEADER TAG: DELETE BEGIN **/
+extern const uint32_t ripemd160_iv[5];
+
+// One-message kernel, hash 'nblocks' consecutive 64 bytes blocks into 'state'.
+void ripemd160_transform_scalar(uint32_t *state, const byte *blocks, size_t nblocks);
+
+// Multi-lane kernels, hash one block per lane. Word i of lane j is state[i * lanes + j].
+void ripemd160_transform_x4(uint32_t *state, const byte **blocks);
+void ripemd160_transform_x8(uint32_t *state, const byte **blocks);
+void ripemd160_transform_x16(uint32_t *state, const byte **blocks);
+
+#endif
+/** AUTOHEADER TAG: DELETE END **/
\ No newline at end of file
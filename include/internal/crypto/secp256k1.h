@@ -0,0 +1,100 @@
+/** AUTOHEADER TAG: DELETE BEGIN **/
+#ifndef _CRYPTO_SECP256K1_
+#define _CRYPTO_SECP256K1_
+
+#include "internal/common.h"
+#include "internal/crypto/uint256.h"
+/** AUTOHEADER TAG: DELETE END **/
+
+#define SECP256K1_BATCH_SIZE 256 // Keys sharing one field inversion.
+
+/** Check a secp256k1 private key.
+*   \param  seckey      32 bytes big-endian scalar.
+*   \return true if the scalar is in [1, n-1].
+**/
+bool secp256k1_seckey_verify(const byte *seckey);
+
+/** Generate secp256k1 private keys, uniform in [1, n-1], from random_bytes().
+*   \param  seckeys     Store the private keys, 32 bytes each, packed.
+*   \param  count       How many private keys.
+*   \return SUCCEEDED on success.
+*           FAILED if no random bytes are available.
+**/
+Status secp256k1_seckey_generate(byte *seckeys, size_t count);
+
+/** Public key of a secp256k1 private key, seckey * G.
+*   The multiples of G are precomputed once, on the first call.
+*   The table lookups and the additions don't depend on the private key's bits.
+*   \param  seckey      32 bytes big-endian scalar.
+*   \param  pub         Store the public key, 33 bytes if compressed else 65 bytes.
+*   \param  compress    Whether the public key is compressed.
+*   \return SUCCEEDED on success.
+*           FAILED if the scalar is not in [1, n-1].
+**/
+Status secp256k1_pubkey_create(const byte *seckey, byte *pub, bool compress);
+
+/** Public keys of many private keys.
+*   Keys are multiplied in blocks of SECP256K1_BATCH_SIZE and each block shares one field inversion.
+*   \param  seckeys     The private keys, 32 bytes each, packed.
+*   \param  count       How many private keys.
+*   \param  pubs        Store the public keys, 33 bytes each if compressed else 65 bytes, packed.
+*                       The public key of an invalid private key is zero-filled.
+*   \param  compress    Whether the public keys are compressed.
+*   \param  statuses    Store each key's status, SUCCEEDED or FAILED if the scalar is not in [1, n-1].
+*   \return how many private keys are valid.
+**/
+size_t secp256k1_pubkey_create_batch(const byte *seckeys, size_t count, byte *pubs, bool compress, Status *statuses);
+
+/** AUTOHEADER TAG: DELETE BEGIN **/
+// Field elements mod p = 2^256 - 2^32 - 977, always fully reduced.
+typedef Uint256 FieldElement;
+
+// Point in affine coordinates, the point at infinity is not represented.
+typedef struct affine_point_st AffinePoint;
+struct affine_point_st {
+	FieldElement x, y;
+};
+
+// Point in Jacobian coordinates, (x, y) = (X / Z^2, Y / Z^3).
+typedef struct jacobian_point_st JacobianPoint;
+struct jacobian_point_st {
+	FieldElement x, y, z;
+	bool infinity;
+};
+
+extern const AffinePoint secp256k1_g;
+
+// Field arithmetic.
+void secp256k1_fe_set_bytes(FieldElement *r, const byte *bytes);
+void secp256k1_fe_get_bytes(const FieldElement *a, byte *bytes);
+void secp256k1_fe_add(FieldElement *r, const FieldElement *a, const FieldElement *b);
+void secp256k1_fe_sub(FieldElement *r, const FieldElement *a, const FieldElement *b);
+void secp256k1_fe_mul(FieldElement *r, const FieldElement *a, const FieldElement *b);
+void secp256k1_fe_sqr(FieldElement *r, const FieldElement *a);
+void secp256k1_fe_inv(FieldElement *r, const FieldElement *a);
+// r[i] = 1 / a[i] with one inversion, 'r' must not alias 'a' and no a[i] may be zero.
+void secp256k1_fe_inv_batch(FieldElement *r, const FieldElement *a, size_t count);
+
+// Group arithmetic, 'r' may alias the inputs.
+void secp256k1_gej_double(JacobianPoint *r, const JacobianPoint *a);
+void secp256k1_gej_add(JacobianPoint *r, const JacobianPoint *a, const JacobianPoint *b);
+void secp256k1_gej_add_ge(JacobianPoint *r, const JacobianPoint *a, const AffinePoint *b);
+void secp256k1_ge_set_gej(AffinePoint *r, const JacobianPoint *a);
+// Convert 'count' points with one inversion, 'r' must not alias 'a'.
+void secp256k1_ge_set_gej_batch(AffinePoint *r, const JacobianPoint *a, size_t count);
+void secp256k1_ge_serialize(const AffinePoint *a, byte *pub, bool compress);
+
+// seckey * G in Jacobian coordinates, 'seckey' must be in [1, n-1].
+void secp256k1_ecmult_gen(JacobianPoint *r, const byte *seckey);
+
+// r[i] = p + (i + 1) * G for i < count, count <= SECP256K1_BATCH_SIZE, with one inversion.
+// A sum at infinity comes out zeroed, keep p + count * G from reaching n * G.
+void secp256k1_ge_add_g_multiples(AffinePoint *r, const AffinePoint *p, size_t count);
+
+// Scalar helpers for walking key ranges: n - 1 - seckey (saturated, 0 if seckey >= n),
+// and seckey += v without reduction, the caller keeps the sum below n.
+uint64_t secp256k1_seckey_room(const byte *seckey);
+void secp256k1_seckey_add(byte *seckey, uint64_t v);
+
+#endif
+/** AUTOHEADER TAG: DELETE END **/
\ No newline at end of file
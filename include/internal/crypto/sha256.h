@@ -0,0 +1,75 @@
+/** AUTOHEADER TAG: DELETE BEGIN **/
+#ifndef _CRYPTO_SHA256_
+#define _CRYPTO_SHA256_
+
+#include "internal/common.h"
+/** AUTOHEADER TAG: DELETE END **/
+
+/** SHA-256 kernels.
+*   The scalar and SHA-NI kernels hash one message at a time,
+*   the SSE4.1, AVX2 and AVX-512 kernels hash 4, 8 and 16 messages side by side.
+**/
+typedef enum sha256_impl {
+	SHA256_AUTO   = 0x00, // The best kernels the CPU supports.
+	SHA256_SCALAR = 0x01,
+	SHA256_SHANI  = 0x02,
+	SHA256_SSE41  = 0x03,
+	SHA256_AVX2   = 0x04,
+	SHA256_AVX512 = 0x05,
+} SHA256_IMPL;
+
+/** Select the kernel used by all sha256 functions, the best one is selected by CPUID at load time.
+*   Messages that don't fill the lanes of a multi-lane kernel go to the narrower kernels, then the scalar one.
+*   Not thread-safe, call it before hashing from multiple threads.
+*   \param  impl        The kernel, SHA256_AUTO for the best one.
+*   \return SUCCEEDED on success.
+*           FAILED if the CPU doesn't support the kernel.
+**/
+Status sha256_select(SHA256_IMPL impl);
+
+/** Get the kernel in use. **/
+SHA256_IMPL sha256_selected(void);
+
+/** SHA-256 digest.
+*   \param  data        The message.
+*   \param  len         Length of the message.
+*   \param  digest      Store the 32 bytes digest.
+**/
+void sha256(const byte *data, size_t len, byte *digest);
+
+/** Double SHA-256 digest, sha256(sha256(data)).
+*   \param  data        The message.
+*   \param  len         Length of the message.
+*   \param  digest      Store the 32 bytes digest.
+**/
+void sha256d(const byte *data, size_t len, byte *digest);
+
+/** SHA-256 digests of many messages of the same length.
+*   \param  data        The messages, message i starts at data + i * stride.
+*   \param  stride      Distance in bytes between two messages.
+*   \param  len         Length of each message.
+*   \param  count       How many messages.
+*   \param  digests     Store the 32 bytes digests, packed.
+**/
+void sha256_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests);
+
+/** Double SHA-256 digests of many messages of the same length.
+*   Parameters are the same as sha256_batch().
+**/
+void sha256d_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests);
+
+/** AUTOHEADER TAG: DELETE BEGIN **/
+extern const uint32_t sha256_k[64];
+extern const uint32_t sha256_iv[8];
+
+// One-message kernels, hash 'nblocks' consecutive 64 bytes blocks into 'state'.
+void sha256_transform_scalar(uint32_t *state, const byte *blocks, size_t nblocks);
+void sha256_transform_shani(uint32_t *state, const byte *blocks, size_t nblocks);
+
+// Multi-lane kernels, hash one block per lane. Word i of lane j is state[i * lanes + j].
+void sha256_transform_x4(uint32_t *state, const byte **blocks);
+void sha256_transform_x8(uint32_t *state, const byte **blocks);
+void sha256_transform_x16(uint32_t *state, const byte **blocks);
+
+#endif
+/** AUTOHEADER TAG: DELETE END **/
\ No newline at end of file
@@ -0,0 +1,75 @@
+/** AUTOHEADER TAG: DELETE BEGIN **/
+#ifndef _CRYPTO_UINT256_
+#define _CRYPTO_UINT256_
+
+#include "internal/common.h"
+/** AUTOHEADER TAG: DELETE END **/
+
+/*
+*  Fixed-width 256-bit unsigned integers for the secp256k1 field and scalar math.
+*  Values live on the stack, nothing is allocated, and no branch or memory access depends on
+*  the values, so secret keys can go through every function.
+*/
+
+// Four little-endian 64-bit limbs.
+typedef struct uint256_st Uint256;
+struct uint256_st {
+	uint64_t n[4];
+};
+
+// Eight little-endian 64-bit limbs, a full product.
+typedef struct uint512_st Uint512;
+struct uint512_st {
+	uint64_t n[8];
+};
+
+extern const Uint256 uint256_p; // Field prime, 2^256 - 2^32 - 977.
+extern const Uint256 uint256_n; // Group order.
+
+/** Load and store 32 bytes big-endian. **/
+void uint256_set_bytes(Uint256 *r, const byte *bytes);
+void uint256_get_bytes(const Uint256 *a, byte *bytes);
+
+void uint256_set_u64(Uint256 *r, uint64_t v);
+bool uint256_is_zero(const Uint256 *a);
+
+/** Compare two integers.
+*   \return -1, 0 or 1 as 'a' is less than, equal to or greater than 'b'.
+**/
+int uint256_cmp(const Uint256 *a, const Uint256 *b);
+
+/** r = a + b (mod 2^256), 'r' may alias the inputs.
+*   \return the carry, 0 or 1.
+**/
+uint64_t uint256_add(Uint256 *r, const Uint256 *a, const Uint256 *b);
+
+/** r = a - b (mod 2^256), 'r' may alias the inputs.
+*   \return the borrow, 1 if a < b.
+**/
+uint64_t uint256_sub(Uint256 *r, const Uint256 *a, const Uint256 *b);
+
+/** Full 512-bit product, r = a * b. **/
+void uint256_mul(Uint512 *r, const Uint256 *a, const Uint256 *b);
+void uint256_sqr(Uint512 *r, const Uint256 *a);
+
+/** Reduce a 512-bit integer mod p, folding with 2^256 = 2^32 + 977 (mod p). **/
+void uint256_reduce_p(Uint256 *r, const Uint512 *a);
+
+/** Reduce a 512-bit integer mod n, folding with 2^256 = 2^256 - n (mod n), a 129-bit constant. **/
+void uint256_reduce_n(Uint256 *r, const Uint512 *a);
+
+/** Reduce a 256-bit integer, one conditional subtraction as p and n are above 2^255. **/
+void uint256_mod_p(Uint256 *r, const Uint256 *a);
+void uint256_mod_n(Uint256 *r, const Uint256 *a);
+
+/** Arithmetic mod p and mod n, the inputs must be reduced and so is the result. 'r' may alias the inputs. **/
+void uint256_add_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_sub_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_mul_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_add_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_sub_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b);
+void uint256_mul_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b);
+
+/** AUTOHEADER TAG: DELETE BEGIN **/
+#endif
+/** AUTOHEADER TAG: DELETE END **/
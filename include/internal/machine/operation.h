@@ -66,5 +66,8 @@ Status EXC_OP_EQUALVERIFY(CStack *stack);
 // Arithmetic
 Status EXC_OP_1ADD(CStack *stack);
 
+// Crypto
+Status EXC_OP_HASH160(CStack *stack);
+
 #endif
 /** AUTOHEADER TAG: DELETE END **/
\ No newline at end of file
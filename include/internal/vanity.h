@@ -0,0 +1,81 @@
+/** AUTOHEADER TAG: DELETE BEGIN **/
+#ifndef _BTC_VANITY_
+#define _BTC_VANITY_
+
+#include "internal/common.h"
+#include "internal/address.h"
+/** AUTOHEADER TAG: DELETE END **/
+
+/* 0x1080 ~ 0x109f : Vanity */
+#define VANITY_INVALID_PATTERN     (void *)0x1080 // Bad character, too long, or no address can match.
+#define VANITY_PATTERN_TOO_BROAD   (void *)0x1081 // Too many case variants.
+#define VANITY_THREAD_FAILED       (void *)0x1082
+
+typedef enum vanity_match {
+	VANITY_PREFIX         = 0x01, // Base58 address prefix, e.g. "1Love".
+	VANITY_PREFIX_NOCASE  = 0x02, // Base58 address prefix, any letter case.
+	VANITY_HASH160_PREFIX = 0x03, // Hexadecimal hash160 prefix, e.g. "0000".
+} VANITY_MATCH;
+
+typedef struct vanity_stats_st VanityStats;
+struct vanity_stats_st {
+	uint64_t keys;          // Keys tested.
+	double seconds;         // Elapsed time.
+	double keys_per_second;
+};
+
+typedef struct vanity_config_st VanityConfig;
+struct vanity_config_st {
+	const uint8_t *pattern; // NUL-terminated.
+	VANITY_MATCH match;
+	bool compress;          // Whether the public keys are compressed.
+	ADDRESS_TYPE addr_type;
+	uint32_t threads;       // Worker threads, 0 for one per online CPU.
+	size_t max_hits;        // Stop after this many hits, at least 1.
+	uint64_t max_keys;      // Stop after about this many keys, 0 for no limit.
+	// Called from the calling thread about once a second, may be NULL.
+	void (*progress)(const VanityStats *stats, void *arg);
+	void *progress_arg;
+};
+
+typedef struct vanity_hit_st VanityHit;
+struct vanity_hit_st {
+	byte priv_raw[32];
+	byte pub_raw[65];      // 33 bytes used if compressed.
+	uint8_t address[ADDRESS_SLOT_SIZE];
+};
+
+/** Search for keys whose address or hash160 starts with a pattern.
+*   Every worker walks its own range of consecutive keys from a random start.
+*   The pattern is turned into ranges of hash160 values once, so candidates are compared
+*   as hash160s and only the hits are Base58 encoded.
+*   \param  config      The search.
+*   \param  hits        Store the hits, room for config->max_hits.
+*   \param  hit_count   Store how many hits were found.
+*   \param  stats       Store the keys tested and the speed, may be NULL.
+*   \return SUCCEEDED when the search stops on max_hits or max_keys, or every worker ran out of keys.
+*           FAILED when config->max_hits is 0 or no random start key can be drawn.
+*           VANITY_INVALID_PATTERN, VANITY_PATTERN_TOO_BROAD or VANITY_THREAD_FAILED.
+**/
+Status vanity_search(const VanityConfig *config, VanityHit *hits, size_t *hit_count, VanityStats *stats);
+
+/** AUTOHEADER TAG: DELETE BEGIN **/
+// A range of hash160 values, both ends included, big-endian.
+typedef struct vanity_range_st VanityRange;
+struct vanity_range_st {
+	byte lo[20], hi[20];
+};
+
+/** Turn a pattern into sorted, disjoint ranges of hash160 values.
+*   Ranges of Base58 prefixes are rounded out to whole hash160s, the hits still need their
+*   address checked.
+*   \return how many ranges were stored in '*ranges' (malloc'ed, free it), 0 on error with 'status' set.
+**/
+size_t vanity_ranges(const uint8_t *pattern, VANITY_MATCH match, ADDRESS_TYPE addr_type, VanityRange **ranges,
+	Status *status);
+
+// Whether a hash160 is in one of the ranges.
+bool vanity_ranges_match(const VanityRange *ranges, size_t count, const byte *hash160);
+
+#endif
+/** AUTOHEADER TAG: DELETE END **/
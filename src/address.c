@@ -1,73 +1,32 @@
-#include <time.h>
+#include <stdlib.h>
 #include <string.h>
-#include <openssl/bn.h>
-#include <openssl/ec.h>
-#include <openssl/sha.h>
-#include <openssl/ripemd.h>
 #include "internal/codec/base.h"
 #include "internal/codec/strings.h"
+#include "internal/crypto/sha256.h"
+#include "internal/crypto/ripemd160.h"
+#include "internal/crypto/secp256k1.h"
 #include "internal/common.h"
 #include "internal/address.h"
 
-void ecdsa_secp256k1_generate_private_key(byte *priv_raw)
+Status ecdsa_secp256k1_generate_private_key(byte *priv_raw)
 {
-	uint8_t bin[256];
-	uint8_t hexarray[64];
-	int16_t item, i = 0;
-
-	// Get ns level time stamp for random seed.
-	// Function 'clock_gettime' only works on Linux.
-	struct timespec nstime;
-	clock_gettime(CLOCK_MONOTONIC, &nstime);
-
-	// Generate binary private key.
-	srand(nstime.tv_nsec);
-	for (uint8_t k = 0; k < 256; ++k)
-		bin[k] = rand()%2;
-
-	// Convert binary private key to raw byte array.
-	do{	item = (bin[i] + 1) * 1000 + (bin[i+1] + 1) * 100 + (bin[i+2] + 1) * 10 + (bin[i+3] + 1);
-		hexarray[i/4] = selector(item);
-		i += 4;
-	}while(i < 256);
-
-	hexstr_to_bytearr(hexarray, 64, priv_raw);
+	return secp256k1_seckey_generate(priv_raw, 1);
 }
+
+Status ecdsa_secp256k1_generate_private_keys(byte *priv_raws, size_t count)
+{
+	return secp256k1_seckey_generate(priv_raws, count);
+}
+
 Status ecdsa_secp256k1_privkey_to_pubkey(byte *priv_raw, byte *pub_raw, bool compress)
-{	
-	point_conversion_form_t forms[] = {
-		POINT_CONVERSION_UNCOMPRESSED,
-		POINT_CONVERSION_COMPRESSED
-	};
-	EC_KEY *keys = EC_KEY_new_by_curve_name(714);
-	const EC_GROUP *group = EC_KEY_get0_group(keys);       // Struct group store the G and calculation rules
-	EC_POINT *pubkey_bn = EC_POINT_new(group);             // Public key is a point on curve
-	BN_CTX *ctx = BN_CTX_new();
-
-	// Convert private key from raw byte array to BIGNUM.
-	uint8_t hexstr[64];
-	BIGNUM *privkey_bn = BN_new();
-	bytearr_to_hexstr(priv_raw, 32, hexstr);
-	BN_hex2bn(&privkey_bn, (const char*)hexstr);
-
-	// Generate public key.
-	EC_POINT_mul(group, pubkey_bn, privkey_bn, NULL, NULL, ctx);
-	EC_KEY_set_private_key(keys, privkey_bn);
-	EC_KEY_set_public_key(keys, pubkey_bn);
-
-	// Convert public key from BIGNUM to raw byte array.
-	EC_KEY_set_conv_form(keys, forms[compress?1:0]);
-	uint8_t pub_len;
-	uint8_t *ptr_pubkey_raw = pub_raw;
-	pub_len = i2o_ECPublicKey(keys, &ptr_pubkey_raw);
-	if (pub_len != 33 && pub_len != 65)
-		return FAILED;
+{
+	return secp256k1_pubkey_create(priv_raw, pub_raw, compress);
+}
 
-	BN_free(privkey_bn);
-	EC_POINT_free(pubkey_bn);
-	BN_CTX_free(ctx);
-	EC_KEY_free(keys);
-	return SUCCEEDED;
+size_t ecdsa_secp256k1_privkey_to_pubkey_batch(byte *priv_raws, size_t count, byte *pub_raws, bool compress,
+	Status *statuses)
+{
+	return secp256k1_pubkey_create_batch(priv_raws, count, pub_raws, compress, statuses);
 }
 
 void raw_to_wif(byte *priv_raw, uint8_t *priv_wif, bool compress, NETWORK_TYPE network)
@@ -103,9 +62,8 @@ void raw_to_wif(byte *priv_raw, uint8_t *priv_wif, bool compress, NETWORK_TYPE n
 		extended[i] = priv_raw[i-1];
 
 	// Step 2 : Double sha256 the extended key for checksum.
-	byte first_sha256[32], second_sha256[32];
-	SHA256(extended, extended_length, first_sha256);
-	SHA256(first_sha256, 32, second_sha256);
+	byte second_sha256[32];
+	sha256d(extended, extended_length, second_sha256);
 
 	// Step 3 : Append the first four byte checksum to the extended key.
 	for (uint8_t i = 0; i < extended_length; ++i)
@@ -119,48 +77,40 @@ void raw_to_wif(byte *priv_raw, uint8_t *priv_wif, bool compress, NETWORK_TYPE n
 
 Status wif_to_raw(uint8_t *priv_wif, byte *priv_raw)
 {
-	size_t decoded_len = base58decode(priv_wif, strlen((const char *)priv_wif), NULL);
-	if (decoded_len != 37 && decoded_len != 38)
-		return FAILED;
-	else if (decoded_len == (size_t)-1)
-		return FAILED;
-
-	byte decoded[decoded_len];
-	base58decode(priv_wif, strlen((const char *)priv_wif), decoded);
-
-	byte to_sha256[decoded_len - 4], checksum_origin[4];
-	for (uint8_t i = 0; i < (decoded_len - 4); ++i)
-		to_sha256[i] = decoded[i];
-	for (uint8_t i = 0; i < 4; ++i)
-		checksum_origin[i] = decoded[decoded_len - 4 + i];
-
-	byte first_sha256[32], second_sha256[32];
-	SHA256(to_sha256, decoded_len - 4, first_sha256);
-	SHA256(first_sha256, 32, second_sha256);
+	size_t wif_len = strlen((const char *)priv_wif), decoded_len = 38;
+	byte decoded[38], second_sha256[32];
 
-	for (uint8_t i = 0; i < 4; ++i)
+	// 38 bytes with the compress suffix, 37 without.
+	size_t ret = base58decode_fixed(priv_wif, wif_len, decoded, 38);
+	if (ret == (size_t)-2)
 	{
-		if (checksum_origin[i] != second_sha256[i])
-			return FAILED;
+		decoded_len = 37;
+		ret = base58decode_fixed(priv_wif, wif_len, decoded, 37);
 	}
+	if (ret != 0)
+		return FAILED;
 
-	for (uint8_t i = 0; i < 32; ++i)
-		priv_raw[i] = to_sha256[i+1];
+	sha256d(decoded, decoded_len - 4, second_sha256);
+	if (memcmp(decoded + decoded_len - 4, second_sha256, 4) != 0)
+		return FAILED;
+
+	memcpy(priv_raw, decoded + 1, 32);
 
 	return SUCCEEDED;
 }
 
-// fix it, the prefix 0x00 are ignored.
+// The dice rolls are a number, so the leading '0's are skipped and the key is padded to 32 bytes instead.
 Status b6_to_hex(uint8_t *b6, size_t b6_len, byte *priv_raw)
 {
-	size_t raw_len = base6decode(b6, b6_len, NULL);
-	if (raw_len == (size_t)-1)
+	while (b6_len > 0 && *b6 == '0')
+		++b6, --b6_len;
+
+	byte copy[32];
+	size_t raw_len;
+	if (base6_decode(b6, b6_len, copy, sizeof(copy), &raw_len) != SUCCEEDED)
 		return FAILED;
 	size_t prefix_zero_count = 32 - raw_len;
 
-	byte copy[raw_len];
-	base6decode(b6, b6_len, copy);
-
 	for (uint8_t i = 0; i < prefix_zero_count; ++i)
 		priv_raw[i] = 0x00;
 	for (uint8_t i = 0; i < raw_len; ++i)
@@ -169,83 +119,243 @@ Status b6_to_hex(uint8_t *b6, size_t b6_len, byte *priv_raw)
 	return SUCCEEDED;
 }
 
-void pub_to_address(byte *pub_raw, uint8_t *address, bool compress, ADDRESS_TYPE addr_type)
+byte address_prefix(ADDRESS_TYPE addr_type)
 {
-	byte pub_sha256[32], pub_ripemd160[20];
-
-	byte ripemd160_result_prefixed[21], first_checksum_sha[32], second_checksum_sha[32], to_base58[25];
-
-	// Step 1 : hash160 the public key.
-	SHA256(pub_raw, compress ? 33 : 65, pub_sha256);
-	RIPEMD160(pub_sha256, 32, pub_ripemd160);
-
-	// Step 2 : Extend the hashed public key with prefix address_type byte.
 	switch (addr_type)
 	{
-		case MAINNET_P2PKH: ripemd160_result_prefixed[0] = PREFIX_ADDR_MAINNET_P2PKH; break;
-		case MAINNET_P2SH:  ripemd160_result_prefixed[0] = PREFIX_ADDR_MAINNET_P2SH;  break;
-		case TESTNET_P2PKH: ripemd160_result_prefixed[0] = PREFIX_ADDR_TESTNET_P2PKH; break;
-		case TESTNET_P2SH:  ripemd160_result_prefixed[0] = PREFIX_ADDR_TESTNET_P2SH;  break;
+		case MAINNET_P2SH:  return PREFIX_ADDR_MAINNET_P2SH;
+		case TESTNET_P2PKH: return PREFIX_ADDR_TESTNET_P2PKH;
+		case TESTNET_P2SH:  return PREFIX_ADDR_TESTNET_P2SH;
+		default:            return PREFIX_ADDR_MAINNET_P2PKH;
 	}
-	for (int32_t i = 0; i < 20; ++i)
-		ripemd160_result_prefixed[i + 1] = pub_ripemd160[i];
+}
 
-	// Step 3 : Double sha256 the extended byte array for checksum.
-	SHA256(ripemd160_result_prefixed, 21, first_checksum_sha);
+void pub_to_address(byte *pub_raw, uint8_t *address, bool compress, ADDRESS_TYPE addr_type)
+{
+	byte second_checksum_sha[32], to_base58[25];
 
-	SHA256(first_checksum_sha, 32, second_checksum_sha);
+	// Step 1 : hash160 the public key, behind the prefix address_type byte.
+	to_base58[0] = address_prefix(addr_type);
+	hash160(pub_raw, compress ? 33 : 65, to_base58 + 1);
 
-	// Step 4 : Append the checksum to the extended hashed public key.
-	for (int32_t i = 0; i < 21; ++i)
-		to_base58[i] = ripemd160_result_prefixed[i];
-	for (int32_t i = 0; i < 4; ++i)
-		to_base58[21 + i] = second_checksum_sha[i];
+	// Step 2 : Double sha256 the extended byte array for checksum.
+	sha256d(to_base58, 21, second_checksum_sha);
 
-	// Step 5 : Base58 encode the 'to_base' payload, get an address.
+	// Step 3 : Append the checksum to the extended hashed public key.
+	memcpy(to_base58 + 21, second_checksum_sha, 4);
+
+	// Step 4 : Base58 encode the 'to_base' payload, get an address.
 	base58encode(to_base58, 25, address);
 }
 
-// fix it.
+// Addresses are checked in blocks, so the checksums of a whole block are hashed together.
+#define ADDRESS_BLOCK_SIZE 64
+
+// Decode an address to its 25 bytes payload: prefix(1) + hash160(20) + checksum(4).
+static Status address_decode(uint8_t *address, size_t len, byte *decoded)
+{
+	if (len < 26 || len > 35)
+		return ADDRESS_INVALID_LENGTH;
+
+	size_t ret = base58decode_fixed(address, len, decoded, 25);
+	if (ret == (size_t)-1)
+		return ADDRESS_INVALID_CHARACTER;
+	else if (ret != 0)
+		return ADDRESS_INVALID_LENGTH;
+
+	return SUCCEEDED;
+}
+
+// Check the checksums of a block of decoded addresses and get the hash160 values.
+static size_t address_block_to_hash160(byte (*decoded)[25], size_t count, byte *hash160s, Status *statuses)
+{
+	byte checksums[ADDRESS_BLOCK_SIZE][32];
+	size_t valid = 0;
+
+	sha256d_batch(decoded[0], 25, 21, count, checksums[0]);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (statuses[i] != SUCCEEDED)
+			continue;
+		if (memcmp(decoded[i] + 21, checksums[i], 4) != 0)
+		{
+			statuses[i] = ADDRESS_INVALID_CHECKSUM;
+			continue;
+		}
+		memcpy(hash160s + i * 20, decoded[i] + 1, 20);
+		valid++;
+	}
+	return valid;
+}
+
 Status address_to_hash160(uint8_t *address, byte *hash160)
 {
-	// Get and check the decoded data's length.
-	size_t decoded_len = base58decode(address, strlen((char*)address), NULL);
-	
-	if (decoded_len != 25)
-		return FAILED;
-	else if (decoded_len == (size_t)-1)
+	Status status;
+	byte decoded[1][25];
+
+	status = address_decode(address, strlen((char*)address), decoded[0]);
+	if (status != SUCCEEDED)
 		return FAILED;
 
-	// b58decode the address.
-	byte decoded[decoded_len];
-	base58decode(address, strlen((char*)address), decoded);
-	
-	// Separate the hash160 part and checksum part.
-	byte hash160_origin[21], checksum_origin[4];
-	for (int32_t i = 0; i < 21; ++i)
-		hash160_origin[i] = decoded[i];
+	// Double sha256 the hash160 and check the checksum.
+	return address_block_to_hash160(decoded, 1, hash160, &status) ? SUCCEEDED : FAILED;
+}
 
-	for (int32_t i = 0; i < 4; ++i)
-		checksum_origin[i] = decoded[decoded_len-4+i];
+size_t address_to_hash160_batch(uint8_t **addresses, size_t count, byte *hash160s, Status *statuses)
+{
+	byte decoded[ADDRESS_BLOCK_SIZE][25];
+	size_t valid = 0;
 
-	// Double sha256 the hash160 and check the checksum.
-	byte first_sha256[32], second_sha256[32];
-	SHA256(hash160_origin, 21, first_sha256);
-	SHA256(first_sha256, 32, second_sha256);
+	for (size_t start = 0; start < count; start += ADDRESS_BLOCK_SIZE)
+	{
+		size_t block = count - start < ADDRESS_BLOCK_SIZE ? count - start : ADDRESS_BLOCK_SIZE;
 
-	for (int32_t i = 0; i < 4; ++i)
+		for (size_t i = 0; i < block; ++i)
+		{
+			uint8_t *address = addresses[start + i];
+			statuses[start + i] = address_decode(address, strlen((char*)address), decoded[i]);
+			if (statuses[start + i] != SUCCEEDED)
+				memset(decoded[i], 0, 25);
+		}
+		valid += address_block_to_hash160(decoded, block, hash160s + start * 20, statuses + start);
+	}
+	return valid;
+}
+
+size_t address_to_hash160_lines(uint8_t *buffer, size_t buffer_len, byte *hash160s, Status *statuses,
+	size_t capacity, size_t *count)
+{
+	byte decoded[ADDRESS_BLOCK_SIZE][25];
+	size_t valid = 0, read = 0, block = 0;
+	uint8_t *cursor = buffer, *end = buffer + buffer_len;
+
+	while (cursor < end && read + block < capacity)
+	{
+		uint8_t *line_end = (uint8_t *)memchr(cursor, '\n', end - cursor);
+		if (line_end == NULL)
+			line_end = end;
+
+		size_t len = line_end - cursor;
+		if (len && cursor[len - 1] == '\r')
+			len--;
+		if (len)
+		{
+			statuses[read + block] = address_decode(cursor, len, decoded[block]);
+			if (statuses[read + block] != SUCCEEDED)
+				memset(decoded[block], 0, 25);
+			if (++block == ADDRESS_BLOCK_SIZE)
+			{
+				valid += address_block_to_hash160(decoded, block, hash160s + read * 20, statuses + read);
+				read += block;
+				block = 0;
+			}
+		}
+		cursor = line_end + 1;
+	}
+	if (block)
+	{
+		valid += address_block_to_hash160(decoded, block, hash160s + read * 20, statuses + read);
+		read += block;
+	}
+
+	*count = read;
+	return valid;
+}
+
+// Base58Check encode a block of hash160 values into address slots.
+static void hash160_block_to_address(byte (*hash160s)[20], size_t count, uint8_t *addresses, ADDRESS_TYPE addr_type)
+{
+	byte to_base58[ADDRESS_BLOCK_SIZE][25], checksums[ADDRESS_BLOCK_SIZE][32];
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		to_base58[i][0] = address_prefix(addr_type);
+		memcpy(to_base58[i] + 1, hash160s[i], 20);
+	}
+	sha256d_batch(to_base58[0], 25, 21, count, checksums[0]);
+	for (size_t i = 0; i < count; ++i)
 	{
-		if (checksum_origin[i] != second_sha256[i])
-			return FAILED;
+		memcpy(to_base58[i] + 21, checksums[i], 4);
+		base58encode(to_base58[i], 25, addresses + i * ADDRESS_SLOT_SIZE);
 	}
+}
+
+void pub_to_address_batch(byte *pub_raws, size_t count, uint8_t *addresses, bool compress, ADDRESS_TYPE addr_type)
+{
+	byte hash160s[ADDRESS_BLOCK_SIZE][20];
+	size_t pub_len = compress ? 33 : 65;
 
-	// Get the hash160 value if checksum is correct.
-	for (int32_t i = 0; i < 20; ++i)
-		hash160[i] = hash160_origin[i+1];
+	for (size_t start = 0; start < count; start += ADDRESS_BLOCK_SIZE)
+	{
+		size_t block = count - start < ADDRESS_BLOCK_SIZE ? count - start : ADDRESS_BLOCK_SIZE;
 
+		hash160_batch(pub_raws + start * pub_len, pub_len, pub_len, block, hash160s[0]);
+		hash160_block_to_address(hash160s, block, addresses + start * ADDRESS_SLOT_SIZE, addr_type);
+	}
+}
+
+Status key_walker_init(KeyWalker *walker, const byte *start)
+{
+	if (secp256k1_pubkey_create(start, walker->pub_raw, false) != SUCCEEDED)
+		return FAILED;
+
+	memcpy(walker->priv_raw, start, 32);
+	walker->exhausted = false;
 	return SUCCEEDED;
 }
 
+size_t key_walker_next(KeyWalker *walker, size_t count, byte *pub_raws, byte *hash160s, uint8_t *addresses,
+	bool compress, ADDRESS_TYPE addr_type)
+{
+	AffinePoint points[SECP256K1_BATCH_SIZE + 1];
+	byte pubs[SECP256K1_BATCH_SIZE * 65], hashes[ADDRESS_BLOCK_SIZE][20];
+	size_t pub_len = compress ? 33 : 65, produced = 0;
+
+	while (produced < count && !walker->exhausted)
+	{
+		size_t block = count - produced < SECP256K1_BATCH_SIZE ? count - produced : SECP256K1_BATCH_SIZE;
+		uint64_t room = secp256k1_seckey_room(walker->priv_raw);
+
+		// Stop at n - 1, the point after it would be at infinity.
+		size_t steps = block;
+		if (room < block)
+		{
+			block = room + 1;
+			steps = room;
+			walker->exhausted = true;
+		}
+
+		// points[0] is the walker's point, points[i] = points[0] + i * G, points[block] is the next one.
+		secp256k1_fe_set_bytes(&points[0].x, walker->pub_raw + 1);
+		secp256k1_fe_set_bytes(&points[0].y, walker->pub_raw + 33);
+		secp256k1_ge_add_g_multiples(points + 1, points, steps);
+
+		byte *out = pub_raws ? pub_raws + produced * pub_len : pubs;
+		for (size_t i = 0; i < block; ++i)
+			secp256k1_ge_serialize(&points[i], out + i * pub_len, compress);
+
+		for (size_t start = 0; start < block && (hash160s || addresses); start += ADDRESS_BLOCK_SIZE)
+		{
+			size_t sub = block - start < ADDRESS_BLOCK_SIZE ? block - start : ADDRESS_BLOCK_SIZE;
+
+			hash160_batch(out + start * pub_len, pub_len, pub_len, sub, hashes[0]);
+			if (hash160s)
+				memcpy(hash160s + (produced + start) * 20, hashes[0], sub * 20);
+			if (addresses)
+				hash160_block_to_address(hashes, sub, addresses + (produced + start) * ADDRESS_SLOT_SIZE, addr_type);
+		}
+
+		if (!walker->exhausted)
+		{
+			secp256k1_ge_serialize(&points[block], walker->pub_raw, false);
+			secp256k1_seckey_add(walker->priv_raw, block);
+		}
+		produced += block;
+	}
+	return produced;
+}
+
 Status privkey_validation(uint8_t *key, size_t len, PRIVKEY_FORMAT format);
 
 uint8_t selector(uint16_t item)
@@ -277,7 +387,12 @@ P2PKH_Main_Address * new_P2PKH_Main(bool compress)
 	P2PKH_Main_Address *new = (P2PKH_Main_Address *)calloc(1, sizeof(P2PKH_Main_Address));
 	if (!new) return MEMORY_ALLOCATE_FAILED;
 
-	ecdsa_secp256k1_generate_private_key(new->root.priv_raw);
+	if (ecdsa_secp256k1_generate_private_key(new->root.priv_raw) != SUCCEEDED)
+	{
+		memset(new, 0, sizeof(P2PKH_Main_Address));
+		free(new);
+		return FAILED;
+	}
 	ecdsa_secp256k1_privkey_to_pubkey(new->root.priv_raw, compress?new->root.pubc_raw:new->root.pub_raw, compress);
 	raw_to_wif(new->root.priv_raw, new->b58_address, compress, MAINNET);
 	new->compress = compress;
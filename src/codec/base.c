@@ -1,11 +1,13 @@
+#include <stdlib.h>
 #include <string.h>
-#include <openssl/bn.h>
-#include <openssl/sha.h>
 #include "internal/codec/base.h"
-#include "internal/codec/strings.h"
+#include "internal/crypto/bigint.h"
+#include "internal/crypto/sha256.h"
 
 const uint8_t base6table[6] =
 	{'0', '1', '2', '3', '4', '5'};
+const uint8_t base10table[10] =
+	{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
 const uint8_t base58table[58] =
 	{'1', '2', '3', '4', '5', '6', '7', '8', '9','A', 'B', 'C', 'D', 'E', 'F',
 	'G', 'H', 'J', 'K', 'L', 'M', 'N', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W',
@@ -18,465 +20,1445 @@ const uint8_t base64table[64] =
 	't', 'u', 'v', 'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7',
 	'8', '9', '+', '/'};
 
-size_t base6encode(byte *payload, size_t payload_len, uint8_t *encoded)
+/******************** Divide-and-conquer radix conversion ********************/
+/*
+*  The codecs below fold the number in one limb at a time, O(n^2). From each radix's thresholds in
+*  bytes or digits on they split it instead: with c the largest power of the base in a 32-bit limb and
+*  P_i = c^(2^i), a number is hi * P_i + lo, and hi and lo are converted on their own. The powers
+*  are squared once per conversion and d_mul and d_div do the splitting, so the time is
+*  O(M(n) log n) on top of Bigint's multiplication.
+*/
+#define RADIX_DC_LEAF   16 // Limbs, the quadratic way below.
+#define RADIX_DC_LEVELS 40
+
+typedef struct radix_st Radix;
+struct radix_st {
+	uint32_t base;
+	uint32_t chunk; // Digits per limb, c = base^chunk.
+	uint32_t power; // c.
+	size_t encode_threshold; // Bytes of value.
+	size_t decode_threshold; // Digits.
+};
+
+// Base6 and decimal have a 64-bit quadratic path, so they switch much later than Base58.
+static const Radix base6_radix = {.base = 6, .chunk = 12, .power = 2176782336u,
+	.encode_threshold = 24576, .decode_threshold = 98304};
+static const Radix base10_radix = {.base = 10, .chunk = 9, .power = 1000000000u,
+	.encode_threshold = 24576, .decode_threshold = 65536};
+static const Radix base58_radix = {.base = 58, .chunk = 5, .power = 656356768u,
+	.encode_threshold = 2048, .decode_threshold = 2800};
+
+// P_i for i < count, without top zero limbs, P_i has chunk << i digits.
+typedef struct radix_powers_st RadixPowers;
+struct radix_powers_st {
+	const Radix *radix;
+	LimbDivisor divisor; // For c.
+	uint32_t *p[RADIX_DC_LEVELS];
+	uint32_t len[RADIX_DC_LEVELS];
+	uint32_t count;
+};
+
+static void radix_powers_free(RadixPowers *pw)
+{
+	for (uint32_t i = 0; i < pw->count; ++i)
+		free(pw->p[i]);
+}
+
+// Square up to P_(count - 1).
+static Status radix_powers_new(RadixPowers *pw, const Radix *radix, uint32_t count)
 {
-	uint8_t payload_hexstr[payload_len*2];
-	uint8_t raw_encoded[payload_len*2];
+	Status status = SUCCEEDED;
+	pw->radix = radix;
+	limb_divisor_init(&pw->divisor, radix->power);
+	pw->count = 0;
+	for (uint32_t i = 0; i < count && status == SUCCEEDED; ++i)
+	{
+		uint32_t len = i ? 2 * pw->len[i - 1] : 1;
+		uint32_t *p = (uint32_t *)malloc(len * sizeof(uint32_t));
+		if (!p)
+		{
+			status = MEMORY_ALLOCATE_FAILED;
+			break;
+		}
+		pw->p[pw->count++] = p;
+		if (i == 0)
+			p[0] = radix->power;
+		else
+			status = d_mul(pw->p[i - 1], pw->len[i - 1], pw->p[i - 1], pw->len[i - 1], p);
+		while (len > 1 && p[len - 1] == 0)
+			--len;
+		pw->len[i] = len;
+	}
+	if (status != SUCCEEDED)
+		radix_powers_free(pw);
+	return status;
+}
 
-	BIGNUM *bn  = BN_new();     BIGNUM *bn0 = BN_new();     BIGNUM *bn6 = BN_new();
-	BIGNUM *dv  = BN_new();     BIGNUM *rem = BN_new();
-	BN_CTX *ctx = BN_CTX_new();
+// The digits of a[0, len) < P_level, exactly chunk << level of them, most significant first.
+// 'a' is used up.
+static Status radix_dc_split(const RadixPowers *pw, uint32_t *a, uint32_t len, uint32_t level, uint8_t *digits)
+{
+	const uint32_t base = pw->radix->base, chunk = pw->radix->chunk;
+	size_t count = (size_t)chunk << level;
 
-	// Convert the payload from byte array to hex string.
-	if (bytearr_to_hexstr(payload, payload_len, payload_hexstr) != 0)
-		return -1; // 0xffffffffffffffff
+	while (len > 0 && a[len - 1] == 0)
+		--len;
+	if (len <= RADIX_DC_LEAF || level == 0)
+	{
+		// Peel c off the bottom, chunk digits at a time.
+		uint8_t *out = digits + count;
+		for (size_t k = 0; k < count; k += chunk)
+		{
+			uint32_t rem = len ? d_div_1(a, len, &pw->divisor, a) : 0;
+			while (len > 0 && a[len - 1] == 0)
+				--len;
+			for (uint32_t j = 0; j < chunk; ++j, rem /= base)
+				*--out = (uint8_t)(rem % base);
+		}
+		return SUCCEEDED;
+	}
+
+	// a = q * P_(level - 1) + r, q and r both below P_(level - 1).
+	const uint32_t *p = pw->p[level - 1], p_len = pw->len[level - 1];
+	size_t half = count / 2;
+	if (len < p_len)
+	{
+		memset(digits, 0, half);
+		return radix_dc_split(pw, a, len, level - 1, digits + half);
+	}
+	uint32_t q_len = len - p_len + 1;
+	uint32_t *q = (uint32_t *)malloc(((size_t)q_len + p_len) * sizeof(uint32_t));
+	if (!q)
+		return MEMORY_ALLOCATE_FAILED;
+	uint32_t *r = q + q_len;
+	Status status = d_div(a, len, p, p_len, q, r);
+	if (status == SUCCEEDED)
+		status = radix_dc_split(pw, q, q_len, level - 1, digits);
+	if (status == SUCCEEDED)
+		status = radix_dc_split(pw, r, p_len, level - 1, digits + half);
+	free(q);
+	return status;
+}
 
-	BN_hex2bn(&bn, (const char*)payload_hexstr);
-	BN_set_word(bn0,0);
-	BN_set_word(bn6,6);
-	BN_set_word(dv,1);
+// r[0, len / chunk + 1) = the value of the digits d[0, len), most significant first.
+static Status radix_dc_join(const RadixPowers *pw, const uint8_t *d, size_t len, uint32_t *r)
+{
+	const uint32_t base = pw->radix->base, chunk = pw->radix->chunk;
+	const size_t r_len = len / chunk + 1;
 
-	// Get the raw encoded payload (need to be reversed).
-	size_t encoded_len = 0;
-	while(BN_cmp(dv, bn0) > 0)
+	if (len <= (size_t)chunk * RADIX_DC_LEAF)
 	{
-		BN_div(dv, rem, bn, bn6, ctx);
-		BN_copy(bn, dv);
-		raw_encoded[encoded_len] = base6table[BN_get_word(rem)];
-		encoded_len++;
+		// Horner's method, a chunk of digits per pass, the first one takes what is left over.
+		size_t used = 0;
+		for (size_t i = 0, n = len % chunk ? len % chunk : chunk; i < len; n = chunk)
+		{
+			uint64_t carry = 0, scale = 1;
+			for (size_t end = i + n; i < end; ++i)
+			{
+				carry = carry * base + d[i];
+				scale *= base;
+			}
+			for (size_t j = 0; j < used; ++j)
+			{
+				uint64_t cur = (uint64_t)r[j] * scale + carry;
+				r[j] = (uint32_t)cur;
+				carry = cur >> 32;
+			}
+			if (carry)
+				r[used++] = (uint32_t)carry;
+		}
+		memset(r + used, 0, (r_len - used) * sizeof(uint32_t));
+		return SUCCEEDED;
 	}
 
-	if (encoded == NULL) {
-		// Free Memory, Bug Fixed Apr. 29 2018
-		BN_free(bn);         BN_free(bn0);        BN_free(bn6);
-		BN_free(dv);         BN_free(rem);
-		BN_CTX_free(ctx);
+	// The low part takes the largest chunk << level digits that leaves some for the high part.
+	uint32_t level = 0;
+	while (((size_t)chunk << (level + 1)) < len)
+		++level;
+	size_t lo_digits = (size_t)chunk << level, hi_digits = len - lo_digits;
+	const uint32_t *p = pw->p[level], p_len = pw->len[level];
+	size_t hi_len = hi_digits / chunk + 1, lo_len = lo_digits / chunk + 1;
+
+	uint32_t *hi = (uint32_t *)malloc((hi_len + lo_len) * sizeof(uint32_t));
+	if (!hi)
+		return MEMORY_ALLOCATE_FAILED;
+	uint32_t *lo = hi + hi_len;
+	Status status = radix_dc_join(pw, d, hi_digits, hi);
+	if (status == SUCCEEDED)
+		status = radix_dc_join(pw, d + hi_digits, lo_digits, lo);
+	while (hi_len > 1 && hi[hi_len - 1] == 0)
+		--hi_len;
+	if (status == SUCCEEDED)
+		status = d_mul(hi, (uint32_t)hi_len, p, p_len, r);
+	if (status == SUCCEEDED)
+	{
+		// r = hi * P + lo, lo < P.
+		memset(r + hi_len + p_len, 0, (r_len - hi_len - p_len) * sizeof(uint32_t));
+		uint64_t c = 0;
+		for (size_t i = 0; i < r_len && (i < lo_len || c); ++i)
+		{
+			c += (uint64_t)r[i] + (i < lo_len ? lo[i] : 0);
+			r[i] = (uint32_t)c;
+			c >>= 32;
+		}
+	}
+	free(hi);
+	return status;
+}
 
-		return encoded_len;
+/** Digits of the big-endian data[0, len) without leading zero digits, in a new buffer.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+static Status radix_dc_encode(const Radix *radix, const byte *data, size_t len, uint8_t **digits, size_t *digits_len)
+{
+	uint32_t n = (uint32_t)((len + 3) / 4), level = 0;
+	uint32_t *a = (uint32_t *)malloc(n * sizeof(uint32_t));
+	if (!a)
+		return MEMORY_ALLOCATE_FAILED;
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		uint32_t w = 0;
+		for (size_t j = 0, m = i + 1 < n ? 4 : len - i * 4; j < m; ++j)
+			w |= (uint32_t)data[len - 1 - i * 4 - j] << (j * 8);
+		a[i] = w;
 	}
 
-	for (size_t i = 0; i < encoded_len; ++i)
-		encoded[encoded_len - 1 -i] = raw_encoded[i];
-	encoded[encoded_len] = '\0';
+	// a < 2^(32n) < P_level, log2(c) > 29 and 32/29 < 9/8.
+	while (((size_t)1 << level) < (size_t)n + n / 8 + 1)
+		++level;
 
-	BN_free(bn);         BN_free(bn0);        BN_free(bn6);
-	BN_free(dv);         BN_free(rem);
-	BN_CTX_free(ctx);
+	RadixPowers pw;
+	Status status = radix_powers_new(&pw, radix, level);
+	if (status != SUCCEEDED)
+	{
+		free(a);
+		return status;
+	}
+	size_t count = (size_t)radix->chunk << level;
+	uint8_t *out = (uint8_t *)malloc(count);
+	if (!out)
+		status = MEMORY_ALLOCATE_FAILED;
+	else
+		status = radix_dc_split(&pw, a, n, level, out);
+	radix_powers_free(&pw);
+	free(a);
+	if (status != SUCCEEDED)
+	{
+		free(out);
+		return status;
+	}
 
-	return 0;
+	size_t zeros = 0;
+	while (zeros < count && out[zeros] == 0)
+		++zeros;
+	memmove(out, out + zeros, count - zeros);
+	*digits = out;
+	*digits_len = count - zeros;
+	return SUCCEEDED;
 }
 
-size_t base6decode(uint8_t *payload, size_t payload_len, byte *decoded)
+/** Big-endian bytes of the digit values d[0, len) without leading 0x00 bytes, in a new buffer.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+static Status radix_dc_decode(const Radix *radix, const uint8_t *d, size_t len, byte **bytes, size_t *bytes_len)
 {
-	uint8_t raw_payload[payload_len];
+	uint32_t level = 0;
+	while (((size_t)radix->chunk << (level + 1)) < len)
+		++level;
+
+	RadixPowers pw;
+	Status status = radix_powers_new(&pw, radix, level + 1);
+	if (status != SUCCEEDED)
+		return status;
+	size_t r_len = len / radix->chunk + 1;
+	uint32_t *r = (uint32_t *)malloc(r_len * sizeof(uint32_t));
+	byte *out = (byte *)malloc(r_len * 4);
+	if (!r || !out)
+		status = MEMORY_ALLOCATE_FAILED;
+	else
+		status = radix_dc_join(&pw, d, len, r);
+	radix_powers_free(&pw);
+	if (status != SUCCEEDED)
+	{
+		free(r);
+		free(out);
+		return status;
+	}
+
+	size_t n = r_len * 4;
+	while (n > 0 && !(r[(n - 1) / 4] >> ((n - 1) % 4 * 8) & 0xff))
+		--n;
+	for (size_t i = 0; i < n; ++i)
+		out[n - 1 - i] = (byte)(r[i / 4] >> (i % 4 * 8));
+	free(r);
+	*bytes = out;
+	*bytes_len = n;
+	return SUCCEEDED;
+}
 
-	// Check Validation.
-	for (size_t i = 0; i < payload_len; ++i)
+// radix_dc_encode written out as the single-pass encoders do, after 'zeros' leading table[0]s.
+static Status radix_dc_encode_string(const Radix *radix, const uint8_t *table, const byte *data, size_t len,
+	size_t zeros, uint8_t *encoded, size_t capacity, size_t *encoded_len)
+{
+	uint8_t *digits;
+	size_t digits_len;
+	Status status = radix_dc_encode(radix, data, len, &digits, &digits_len);
+	if (status != SUCCEEDED)
+		return status;
+
+	*encoded_len = zeros + digits_len;
+	if (capacity <= zeros + digits_len)
+		status = CODEC_BUFFER_TOO_SMALL;
+	else
 	{
-		size_t j = 0;
-		for ( ; j < 6; ++j)
+		memset(encoded, table[0], zeros);
+		for (size_t i = 0; i < digits_len; ++i)
+			encoded[zeros + i] = table[digits[i]];
+		encoded[zeros + digits_len] = '\0';
+	}
+	free(digits);
+	return status;
+}
+
+// radix_dc_decode of the characters after the 'zeros' leading ones, mapped by 'map' or by
+// subtracting '0' if it is NULL.
+static Status radix_dc_decode_string(const Radix *radix, const int8_t *map, const uint8_t *payload, size_t len,
+	size_t zeros, byte *decoded, size_t capacity, size_t *decoded_len)
+{
+	uint8_t *digits = (uint8_t *)malloc(len ? len : 1);
+	if (!digits)
+		return MEMORY_ALLOCATE_FAILED;
+	for (size_t i = 0; i < len; ++i)
+	{
+		int value = map ? map[payload[i]] : payload[i] - '0';
+		if (value < 0 || value >= (int)radix->base)
 		{
-			if (payload[i] == base6table[j])
+			free(digits);
+			return CODEC_INVALID_CHARACTER;
+		}
+		digits[i] = (uint8_t)value;
+	}
+
+	byte *bytes;
+	size_t bytes_len;
+	Status status = radix_dc_decode(radix, digits, len, &bytes, &bytes_len);
+	free(digits);
+	if (status != SUCCEEDED)
+		return status;
+
+	*decoded_len = zeros + bytes_len;
+	if (capacity < zeros + bytes_len)
+		status = CODEC_BUFFER_TOO_SMALL;
+	else
+	{
+		memset(decoded, 0x00, zeros);
+		memcpy(decoded + zeros, bytes, bytes_len);
+	}
+	free(bytes);
+	return status;
+}
+
+/******************** Base6 and decimal ********************/
+/*
+*  Numbers are held in 64-bit limbs and converted a chunk of digits at a time, the largest power
+*  of the base below 2^64: 24 Base6 or 19 decimal digits. Encoding divides the limbs by that power
+*  with Moller and Granlund's precomputed reciprocal, as d_div_1 does for 32-bit limbs, so a limb
+*  costs two multiplications. Decoding is Horner's method on the chunks.
+*  Like Base58, every leading 0x00 byte stands for one leading '0' character.
+*/
+static const uint64_t base6_powers[25] = {1ULL, 6ULL, 36ULL, 216ULL, 1296ULL, 7776ULL, 46656ULL, 279936ULL,
+	1679616ULL, 10077696ULL, 60466176ULL, 362797056ULL, 2176782336ULL, 13060694016ULL, 78364164096ULL,
+	470184984576ULL, 2821109907456ULL, 16926659444736ULL, 101559956668416ULL, 609359740010496ULL,
+	3656158440062976ULL, 21936950640377856ULL, 131621703842267136ULL, 789730223053602816ULL,
+	4738381338321616896ULL};
+static const uint64_t base10_powers[20] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+	10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL};
+
+// A chunk power shifted until its top bit is set, and floor((2^128 - 1) / d) - 2^64.
+typedef struct radix_divisor_st RadixDivisor;
+struct radix_divisor_st {
+	uint64_t d;
+	uint64_t v;
+	uint32_t shift;
+};
+
+static const RadixDivisor base6_divisor = {.d = 0x83843971c2000000, .v = 0xf24f62335024a295, .shift = 1};
+static const RadixDivisor base10_divisor = {.d = 0x8ac7230489e80000, .v = 0xd83c94fb6d2ac34a, .shift = 0};
+
+// (u1, u0) / d for a normalized 'd' and u1 < d, the remainder goes to 'r'.
+static inline uint64_t radix_div_2by1(uint64_t u1, uint64_t u0, uint64_t d, uint64_t v, uint64_t *r)
+{
+	unsigned __int128 q = (unsigned __int128)v * u1 + ((unsigned __int128)u1 << 64 | u0) + ((unsigned __int128)1 << 64);
+	uint64_t q1 = (uint64_t)(q >> 64), q0 = (uint64_t)q;
+	uint64_t rem = u0 - q1 * d;
+	uint64_t mask = 0 - (uint64_t)(rem > q0);
+	q1 += mask;
+	rem += d & mask;
+	if (rem >= d) // Rare.
+	{
+		++q1;
+		rem -= d;
+	}
+	*r = rem;
+	return q1;
+}
+
+// 'base', 'chunk' and 'group' are constants after inlining, so the digit splits are multiplications
+// too. A chunk is split into groups of up to 'group' digits that fit 32 bits.
+static inline __attribute__((always_inline))
+Status radix_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len,
+	uint32_t base, uint32_t chunk, uint32_t group, const uint64_t *powers, const RadixDivisor *divisor,
+	size_t (*digits_bound)(size_t), const Radix *radix, const uint8_t *table)
+{
+	const uint32_t s = divisor->shift;
+	size_t zeros = 0;
+	while (zeros < payload_len && payload[zeros] == 0x00)
+		++zeros;
+
+	size_t value_len = payload_len - zeros, words = (value_len + 7) / 8;
+	if (value_len >= radix->encode_threshold)
+		return radix_dc_encode_string(radix, table, payload + zeros, value_len, zeros, encoded, capacity, encoded_len);
+
+	// Little-endian limbs, the top one takes what is left over.
+	uint64_t limbs[words + 1];
+	const byte *p = payload + payload_len;
+	for (size_t i = 0; i < words; ++i)
+	{
+		uint64_t w = 0;
+		for (size_t j = 0, n = i + 1 < words ? 8 : value_len - i * 8; j < n; ++j)
+			w |= (uint64_t)*--p << (j * 8);
+		limbs[i] = w;
+	}
+
+	// Divide by a chunk power until nothing is left, the digits come out least significant first.
+	// Sized by the value, the leading zeros are written straight to 'encoded'.
+	uint8_t digits[digits_bound(value_len) + chunk];
+	size_t len = 0, used = words;
+	while (used > 0)
+	{
+		// Divide limbs << s by d, shifting the limbs on the way.
+		uint64_t rem = s ? limbs[used - 1] >> (64 - s) : 0;
+		for (size_t i = used; i-- > 0;)
+		{
+			uint64_t u0 = s ? limbs[i] << s | (i ? limbs[i - 1] >> (64 - s) : 0) : limbs[i];
+			limbs[i] = radix_div_2by1(rem, u0, divisor->d, divisor->v, &rem);
+		}
+		rem >>= s;
+
+		for (uint32_t k = 0; k < chunk; k += group)
+		{
+			uint32_t n = chunk - k < group ? chunk - k : group, h = n / 2;
+			uint32_t g = (uint32_t)(rem % powers[n]);
+			rem /= powers[n];
+
+			// Two halves of the group, two short dependency chains instead of one long one.
+			uint32_t lo = g % (uint32_t)powers[h], hi = g / (uint32_t)powers[h];
+			for (uint32_t j = 0; j < h; ++j, lo /= base, hi /= base)
 			{
-				raw_payload[i] = j;
-				break;
+				digits[len + j] = (uint8_t)(lo % base);
+				digits[len + h + j] = (uint8_t)(hi % base);
 			}
+			if (n % 2)
+				digits[len + n - 1] = (uint8_t)hi;
+			len += n;
 		}
-		if (j == 6)
-			return -1; // 0xffffffffffffffff
-	}
-	/*
-	*  Convert b6 value array to a big number.
-	*  to_add = b6_value * 6 ^ power;
-	*  to_add = b6_value * powered;
-	*  bignum = bignum + to_add;
-	*/
-	BIGNUM *bn     = BN_new();   BIGNUM *bn6     = BN_new();   BIGNUM *b6value = BN_new();
-	BN_is_zero(bn);              BN_set_word(bn6, 6);
-
-	BIGNUM *power  = BN_new();   BIGNUM *powered = BN_new();
-
-	BIGNUM *to_add = BN_new();   BIGNUM *buffer  = BN_new();
-	BN_is_zero(to_add);          BN_is_zero(buffer);
-
-	BN_CTX *ctx1 = BN_CTX_new(); BN_CTX *ctx2 = BN_CTX_new();
-
-	for (size_t i = 0; i < payload_len; ++i)
-	{
-		BN_set_word(b6value, raw_payload[i]);
-		BN_set_word(power, payload_len - 1 - i);
-		BN_exp(powered, bn6, power, ctx1);
-		BN_mul(to_add, b6value, powered, ctx2);
-		BN_add(bn, buffer, to_add);
-		BN_swap(bn, buffer);
-	}
-	BN_swap(bn, buffer);
-
-	// Convert the big number to hexadecimal string.
-	char *raw_decoded_hexstr;
-	raw_decoded_hexstr = BN_bn2hex(bn);
-
-	// Convert raw decoded hexadecimal string to byte array.
-	int32_t decoded_len = strlen((const char *)raw_decoded_hexstr) / 2;
-	if (decoded == NULL) {
-		// Free Memory, Bug Fixed Apr. 29 2018
-		BN_free(bn);             BN_free(bn6);            BN_free(b6value);
-		BN_free(power);          BN_free(powered);
-		BN_free(to_add);         BN_free(buffer);
-		BN_CTX_free(ctx1);       BN_CTX_free(ctx2);
-		free(raw_decoded_hexstr);
+		while (used > 0 && limbs[used - 1] == 0)
+			--used;
+	}
+	while (len > 0 && digits[len - 1] == 0)
+		--len;
 
-		return decoded_len;
+	*encoded_len = zeros + len;
+	if (capacity <= zeros + len)
+		return CODEC_BUFFER_TOO_SMALL;
+
+	memset(encoded, '0', zeros);
+	for (size_t i = 0; i < len; ++i)
+		encoded[zeros + i] = '0' + digits[len - 1 - i];
+	encoded[zeros + len] = '\0';
+
+	return SUCCEEDED;
+}
+
+static inline __attribute__((always_inline))
+Status radix_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len,
+	uint32_t base, uint32_t chunk, const uint64_t *powers, size_t (*limbs_bound)(size_t), const Radix *radix)
+{
+	size_t zeros = 0;
+	while (zeros < payload_len && payload[zeros] == '0')
+		++zeros;
+	if (payload_len - zeros >= radix->decode_threshold)
+		return radix_dc_decode_string(radix, NULL, payload + zeros, payload_len - zeros, zeros, decoded, capacity,
+			decoded_len);
+
+	// Little-endian limbs, Horner's method on groups of up to 'chunk' digits.
+	size_t used = 0;
+	uint64_t limbs[limbs_bound(payload_len - zeros)];
+	for (size_t i = zeros; i < payload_len; )
+	{
+		size_t n = payload_len - i < chunk ? payload_len - i : chunk;
+		uint64_t carry = 0;
+		for (size_t end = i + n; i < end; ++i)
+		{
+			uint8_t d = payload[i] - '0';
+			if (d >= base)
+				return CODEC_INVALID_CHARACTER;
+			carry = carry * base + d;
+		}
+		for (size_t j = 0; j < used; ++j)
+		{
+			unsigned __int128 cur = (unsigned __int128)limbs[j] * powers[n] + carry;
+			limbs[j] = (uint64_t)cur;
+			carry = (uint64_t)(cur >> 64);
+		}
+		if (carry)
+			limbs[used++] = carry;
 	}
 
-	hexstr_to_bytearr((uint8_t*)raw_decoded_hexstr, strlen((const char *)raw_decoded_hexstr), decoded);
+	size_t value_len = used * 8;
+	if (used > 0)
+	{
+		uint64_t top = limbs[used - 1];
+		while (top >> (value_len * 8 - (used - 1) * 64 - 8) == 0)
+			--value_len;
+	}
 
-	BN_free(bn);             BN_free(bn6);            BN_free(b6value);
-	BN_free(power);          BN_free(powered);
-	BN_free(to_add);         BN_free(buffer);
-	BN_CTX_free(ctx1);       BN_CTX_free(ctx2);
-	free(raw_decoded_hexstr);
+	*decoded_len = zeros + value_len;
+	if (capacity < zeros + value_len)
+		return CODEC_BUFFER_TOO_SMALL;
 
-	return 0;
+	memset(decoded, 0x00, zeros);
+	for (size_t i = 0; i < value_len; ++i)
+		decoded[zeros + value_len - 1 - i] = (byte)(limbs[i / 8] >> (i % 8 * 8));
+
+	return SUCCEEDED;
 }
 
-size_t base58encode(byte *payload, size_t payload_len, uint8_t *encoded)
+// Digits for a value of n bytes, and limbs for a value of n digits.
+static inline size_t base6_digits_bound(size_t n) { return BASE6_ENCODE_BOUND(n); }
+static inline size_t base6_limbs_bound(size_t n) { return n * 21 / 500 + 2; } // log(6)/log(2^64) < 21/500.
+static inline size_t base10_digits_bound(size_t n) { return BASE10_ENCODE_BOUND(n); }
+static inline size_t base10_limbs_bound(size_t n) { return n * 53 / 1000 + 2; } // log(10)/log(2^64) < 53/1000.
+
+Status base6_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len)
+{
+	return radix_encode(payload, payload_len, encoded, capacity, encoded_len, 6, 24, 12, base6_powers, &base6_divisor,
+		base6_digits_bound, &base6_radix, base6table);
+}
+
+Status base6_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len)
 {
-	uint8_t payload_hexstr[payload_len*2];
-	uint8_t raw_encoded[payload_len*2];
+	return radix_decode(payload, payload_len, decoded, capacity, decoded_len, 6, 24, base6_powers,
+		base6_limbs_bound, &base6_radix);
+}
 
-	BIGNUM *bn  = BN_new();     BIGNUM *bn0 = BN_new();     BIGNUM *bn58 = BN_new();
+Status base10_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len)
+{
+	return radix_encode(payload, payload_len, encoded, capacity, encoded_len, 10, 19, 9, base10_powers,
+		&base10_divisor, base10_digits_bound, &base10_radix, base10table);
+}
 
-	BIGNUM *dv  = BN_new();     BIGNUM *rem = BN_new();
+Status base10_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len)
+{
+	return radix_decode(payload, payload_len, decoded, capacity, decoded_len, 10, 19, base10_powers,
+		base10_limbs_bound, &base10_radix);
+}
 
-	BN_CTX *ctx = BN_CTX_new();
+size_t base6encode(byte *payload, size_t payload_len, uint8_t *encoded)
+{
+	size_t encoded_len;
+	Status status = base6_encode(payload, payload_len, encoded, encoded ? SIZE_MAX : 0, &encoded_len);
+
+	if (status == MEMORY_ALLOCATE_FAILED)
+		return -1; // 0xffffffffffffffff
+
+	return encoded ? 0 : encoded_len;
+}
+
+size_t base6decode(uint8_t *payload, size_t payload_len, byte *decoded)
+{
+	size_t decoded_len;
+	Status status = base6_decode(payload, payload_len, decoded, decoded ? SIZE_MAX : 0, &decoded_len);
+
+	if (status == CODEC_INVALID_CHARACTER || status == MEMORY_ALLOCATE_FAILED)
+		return -1; // 0xffffffffffffffff
+
+	return decoded ? 0 : decoded_len;
+}
+
+/*
+*  Base58 conversion works on fixed-width limbs instead of BIGNUM.
+*  Encoding keeps the number in base 58^5 limbs (58^5 < 2^30), so one limb
+*  times 2^32 plus a carry still fits in a uint64_t and a whole 32-bit word
+*  of payload is folded in per pass. Decoding is the mirror image: groups of
+*  five base58 digits are folded into base 2^32 limbs.
+*/
+#define B58_LIMB_DIGITS 5
+#define B58_LIMB_BASE   656356768ULL // 58^5
+
+static const uint32_t base58power[B58_LIMB_DIGITS + 1] =
+	{1, 58, 3364, 195112, 11316496, 656356768};
+
+// Character to base58 value, -1 for non-base58 characters.
+static const int8_t base58map[256] = {
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1, 0, 1, 2, 3, 4, 5, 6, 7, 8,-1,-1,-1,-1,-1,-1,
+	-1, 9,10,11,12,13,14,15,16,-1,17,18,19,20,21,-1,
+	22,23,24,25,26,27,28,29,30,31,32,-1,-1,-1,-1,-1,
+	-1,33,34,35,36,37,38,39,40,41,42,43,-1,44,45,46,
+	47,48,49,50,51,52,53,54,55,56,57,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+};
+
+// 2^(32k) in base 58^5 limbs, little-endian.
+static const uint32_t base58_enc_table[10][11] = {
+	{0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x1544be40, 0x00000006, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x1876f860, 0x200dae91, 0x0000002a, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x15496a20, 0x1736462b, 0x079c6fed, 0x00000118, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x01459b80, 0x20e0b614, 0x16fec3f5, 0x1356ec41, 0x00000729, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x113a2a60, 0x0ec692c1, 0x118629da, 0x0039085b, 0x1cf90ce9, 0x00002edd, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x092983e0, 0x189f7125, 0x0c77e70f, 0x05745def, 0x070ec677, 0x268548ad, 0x000132ac, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x169cd8c0, 0x086e27a2, 0x0ccaec46, 0x2416692a, 0x11e406fa, 0x1a0d6d7a, 0x049a5488, 0x0007d6c7, 0x00000000, 0x00000000, 0x00000000},
+	{0x1e06eb40, 0x2551553e, 0x08244d6e, 0x09c6bdb3, 0x0b98e602, 0x1ea28cb2, 0x01d8ae5e, 0x136b23b6, 0x00334ba5, 0x00000000, 0x00000000},
+	{0x02ae1780, 0x19a2d7f4, 0x098b5463, 0x2241ad4a, 0x1817a90c, 0x0c8bb2a8, 0x23773f75, 0x08dc1226, 0x118f1743, 0x014fa8dd, 0x00000000},
+};
+
+// (58^5)^k in base 2^32 limbs, little-endian.
+static const uint32_t base58_dec_table[11][11] = {
+	{0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x271f35a0, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0xc7fba400, 0x05fa8624, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0xf23a8000, 0x734501d8, 0x00e9e506, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x01100000, 0x9aaf5053, 0xb5f0f288, 0x0023be67, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0xfa000000, 0x5869f408, 0xc6e94dde, 0x5809369c, 0x0005765d, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x40000000, 0x1ceaa75e, 0xec548c47, 0x6d5a3847, 0xb2a25e00, 0x0000d5b2, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x00000000, 0x4778de28, 0x07e6a558, 0xcbc0907d, 0xb5a6d367, 0x469deca6, 0x000020a8, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x00000000, 0xb0612100, 0x28f6af73, 0xc19c48e6, 0x7ba4a062, 0xe28ed535, 0x9df9dbf7, 0x000004fd, 0x00000000, 0x00000000, 0x00000000},
+	{0x00000000, 0x5789a000, 0x8b61c39c, 0x40e1c0ee, 0xd38cf0d6, 0x22b96164, 0xdd3bfe9c, 0x3ed2d1fb, 0x000000c3, 0x00000000, 0x00000000},
+	{0x00000000, 0x94240000, 0xdbde30e0, 0xfe28bd95, 0x33c72111, 0x3c76d592, 0x4f67e70f, 0xb5705045, 0xd65f9f8d, 0x0000001d, 0x00000000},
+};
+
+/*
+*  Fixed-size Base58. For the payload sizes used by addresses and WIF the
+*  number of 32-bit words and base 58^5 limbs is known, so the conversion is
+*  a matrix product with the tables above: every word (limb) adds its value
+*  times the weight of each output limb (word), with no division in the
+*  inner loop. For these sizes the column sums, carries included, stay below
+*  2^64, so a single carry pass at the end normalizes them.
+*  The functions are inlined with constant sizes, the compiler unrolls each
+*  instance.
+*/
+#define B58_MAX_WORDS 11
+#define B58_MAX_LIMBS 11
+
+// Base58 encode a 'len' byte payload, 'words' = ceil(len / 4), 'limbs' base 58^5 limbs hold any value.
+static inline __attribute__((always_inline))
+Status base58encode_sized(const byte *payload, size_t len, size_t words, size_t limbs, uint8_t *encoded,
+	size_t capacity, size_t *encoded_len)
+{
+	uint32_t word[B58_MAX_WORDS];
+	uint64_t acc[B58_MAX_LIMBS] = {0};
+	size_t head = len - (words - 1) * 4;
+
+	// Big-endian payload to words, the first one takes the head bytes.
+	word[0] = 0;
+	for (size_t k = 0; k < head; ++k)
+		word[0] = (word[0] << 8) | payload[k];
+	for (size_t i = 1; i < words; ++i)
+	{
+		const byte *p = payload + head + (i - 1) * 4;
+		word[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+	}
+
+	for (size_t i = 0; i < words; ++i)
+	{
+		const uint32_t *weight = base58_enc_table[words - 1 - i];
+		for (size_t j = 0; j < limbs; ++j)
+			acc[j] += (uint64_t)word[i] * weight[j];
+	}
+	for (size_t j = 0; j + 1 < limbs; ++j)
+	{
+		acc[j + 1] += acc[j] / B58_LIMB_BASE;
+		acc[j] %= B58_LIMB_BASE;
+	}
 
-	// Get leading 0x00 byte count.
 	size_t leading_zero_count = 0;
-	for (size_t i = 0; i < payload_len; ++i)
+	while (leading_zero_count < len && payload[leading_zero_count] == 0x00)
+		leading_zero_count++;
+
+	// Only the most significant limb left can carry leading zero digits.
+	size_t top = limbs, top_digits = 0;
+	while (top && acc[top - 1] == 0)
+		top--;
+	if (top)
+	{
+		while (top_digits < B58_LIMB_DIGITS && acc[top - 1] >= base58power[top_digits])
+			top_digits++;
+	}
+	size_t total = leading_zero_count + (top ? (top - 1) * B58_LIMB_DIGITS + top_digits : 0);
+
+	*encoded_len = total;
+	if (capacity <= total)
+		return CODEC_BUFFER_TOO_SMALL;
+
+	for (size_t i = 0; i < leading_zero_count; ++i)
+		encoded[i] = '1';
+
+	uint8_t *cursor = encoded + total;
+	for (size_t j = 0; j + 1 < top; ++j)
+	{
+		uint32_t limb = acc[j];
+		for (size_t k = 0; k < B58_LIMB_DIGITS; ++k)
+		{
+			*--cursor = base58table[limb % 58];
+			limb /= 58;
+		}
+	}
+	for (uint32_t limb = top ? acc[top - 1] : 0; cursor > encoded + leading_zero_count; limb /= 58)
+		*--cursor = base58table[limb % 58];
+	encoded[total] = '\0';
+
+	return SUCCEEDED;
+}
+
+// Base58 decode to exactly 'decoded_len' bytes, sizes as for base58encode_sized,
+// 'value_words' base 2^32 words hold any value of 'limbs' limbs.
+static inline __attribute__((always_inline))
+size_t base58decode_sized(const uint8_t *payload, size_t payload_len, byte *decoded, size_t decoded_len,
+	size_t words, size_t limbs, size_t value_words)
+{
+	uint32_t limb[B58_MAX_LIMBS] = {0};
+	uint64_t acc[B58_MAX_WORDS + 1] = {0};
+	size_t head = decoded_len - (words - 1) * 4;
+	int8_t bad = 0;
+
+	if (payload_len > limbs * B58_LIMB_DIGITS)
 	{
-		if (payload[i] == 0x00)
-			leading_zero_count += 1;
-		else break;
+		for (size_t i = 0; i < payload_len; ++i)
+			bad |= base58map[payload[i]];
+		return bad < 0 ? -1 : -2; // 0xffffffffffffffff, 0xfffffffffffffffe
 	}
 
-	// Convert the payload from string to a big number.
-	if (bytearr_to_hexstr(payload, payload_len, payload_hexstr) != 0)
+	// Digits to limbs, five per limb, the first limb takes the head digits.
+	size_t groups = (payload_len + B58_LIMB_DIGITS - 1) / B58_LIMB_DIGITS;
+	const uint8_t *digit = payload;
+	for (size_t g = 0; g < groups; ++g)
+	{
+		size_t n = g ? B58_LIMB_DIGITS : payload_len - (groups - 1) * B58_LIMB_DIGITS;
+		uint32_t value = 0;
+		for (size_t k = 0; k < n; ++k)
+		{
+			int8_t d = base58map[*digit++];
+			bad |= d;
+			value = value * 58 + d;
+		}
+		limb[groups - 1 - g] = value;
+	}
+	if (bad < 0)
 		return -1; // 0xffffffffffffffff
 
-	BN_hex2bn(&bn, (const char*)payload_hexstr);
-	BN_set_word(bn0,0);
-	BN_set_word(bn58,58);
-	BN_set_word(dv,1);
+	for (size_t j = 0; j < limbs; ++j)
+	{
+		const uint32_t *weight = base58_dec_table[j];
+		for (size_t i = 0; i < value_words; ++i)
+			acc[i] += (uint64_t)limb[j] * weight[i];
+	}
+	for (size_t i = 0; i < value_words; ++i)
+	{
+		acc[i + 1] += acc[i] >> 32;
+		acc[i] &= 0xffffffff;
+	}
+
+	// The value must fit in 'decoded_len' bytes.
+	for (size_t i = words; i <= value_words; ++i)
+		if (acc[i])
+			return -2; // 0xfffffffffffffffe
+	if (head < 4 && acc[words - 1] >> (head * 8))
+		return -2; // 0xfffffffffffffffe
 
-	// Get the raw encoded payload (need to be reversed).
-	size_t raw_encoded_len = 0;
-	while(BN_cmp(dv, bn0) > 0)
-	{	
-		BN_div(dv, rem, bn, bn58, ctx);
-		BN_copy(bn, dv);
-		raw_encoded[raw_encoded_len] = base58table[BN_get_word(rem)];
-		raw_encoded_len++;
+	for (size_t k = 0; k < head; ++k)
+		decoded[k] = acc[words - 1] >> ((head - 1 - k) * 8);
+	for (size_t i = 1; i < words; ++i)
+	{
+		byte *p = decoded + head + (i - 1) * 4;
+		uint32_t w = acc[words - 1 - i];
+		p[0] = w >> 24; p[1] = w >> 16; p[2] = w >> 8; p[3] = w;
 	}
 
-	// Add the leading '1' charater and reverse the raw encoded data.
-	size_t encoded_len = raw_encoded_len + leading_zero_count;
+	// Leading '1's and leading 0x00 bytes must match one to one.
+	size_t leading_one_count = 0, leading_zero_count = 0;
+	while (leading_one_count < payload_len && payload[leading_one_count] == '1')
+		leading_one_count++;
+	while (leading_zero_count < decoded_len && decoded[leading_zero_count] == 0x00)
+		leading_zero_count++;
+	if (leading_one_count != leading_zero_count)
+		return -2; // 0xfffffffffffffffe
 
-	if (encoded == NULL) {
-		// Free Memory, Bug Fixed Apr. 29 2018
-		BN_free(bn);         BN_free(bn0);        BN_free(bn58);
-		BN_free(dv);         BN_free(rem);
-		BN_CTX_free(ctx);
+	return 0;
+}
 
-		return encoded_len;
+Status base58_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len)
+{
+	// hash160 with prefix, address, compressed public key, WIF and compressed WIF.
+	switch (payload_len)
+	{
+		case 21: return base58encode_sized(payload, 21, 6, 6, encoded, capacity, encoded_len);
+		case 25: return base58encode_sized(payload, 25, 7, 7, encoded, capacity, encoded_len);
+		case 33: return base58encode_sized(payload, 33, 9, 10, encoded, capacity, encoded_len);
+		case 37: return base58encode_sized(payload, 37, 10, 11, encoded, capacity, encoded_len);
+		case 38: return base58encode_sized(payload, 38, 10, 11, encoded, capacity, encoded_len);
 	}
 
+	// Get leading 0x00 byte count.
+	size_t leading_zero_count = 0;
+	while (leading_zero_count < payload_len && payload[leading_zero_count] == 0x00)
+		leading_zero_count++;
+
+	const byte *data = payload + leading_zero_count;
+	size_t data_len = payload_len - leading_zero_count;
+	if (data_len >= base58_radix.encode_threshold)
+		return radix_dc_encode_string(&base58_radix, base58table, data, data_len, leading_zero_count, encoded,
+			capacity, encoded_len);
+
+	// log(256)/log(58) < 1.38, each limb holds 5 digits.
+	uint64_t limbs[(data_len * 138 / 100 + 1) / B58_LIMB_DIGITS + 1];
+	size_t limbs_len = 0;
+
+	// Fold the payload in, one big-endian 32-bit word per pass.
+	// The first word takes the (data_len % 4) head bytes.
+	size_t head = data_len % 4 ? data_len % 4 : 4;
+	for (size_t i = 0; i < data_len; i += head, head = 4)
+	{
+		uint64_t carry = 0;
+		for (size_t k = 0; k < head; ++k)
+			carry = (carry << 8) | data[i + k];
+		uint8_t shift = head * 8;
+
+		for (size_t j = 0; j < limbs_len; ++j)
+		{
+			uint64_t t = (limbs[j] << shift) + carry;
+			limbs[j] = t % B58_LIMB_BASE;
+			carry = t / B58_LIMB_BASE;
+		}
+		while (carry)
+		{
+			limbs[limbs_len++] = carry % B58_LIMB_BASE;
+			carry /= B58_LIMB_BASE;
+		}
+	}
+
+	// Only the most significant limb can carry leading zero digits.
+	size_t top_digits = 0;
+	if (limbs_len)
+	{
+		uint64_t top = limbs[limbs_len - 1];
+		while (top_digits < B58_LIMB_DIGITS && top >= base58power[top_digits])
+			top_digits++;
+	}
+	size_t raw_encoded_len = limbs_len ? (limbs_len - 1) * B58_LIMB_DIGITS + top_digits : 0;
+	size_t total = raw_encoded_len + leading_zero_count;
+
+	*encoded_len = total;
+	if (capacity <= total)
+		return CODEC_BUFFER_TOO_SMALL;
+
 	for (size_t i = 0; i < leading_zero_count; ++i)
 		encoded[i] = '1';
 
-	for (size_t i = 0; i < raw_encoded_len; ++i)
-		encoded[encoded_len - 1 -i] = raw_encoded[i];
-	encoded[encoded_len] = '\0';
+	// Write the digits from the least significant end.
+	uint8_t *cursor = encoded + total;
+	for (size_t j = 0; j < limbs_len; ++j)
+	{
+		uint64_t limb = limbs[j];
+		size_t digits = (j == limbs_len - 1) ? top_digits : B58_LIMB_DIGITS;
+		for (size_t k = 0; k < digits; ++k)
+		{
+			*--cursor = base58table[limb % 58];
+			limb /= 58;
+		}
+	}
+	encoded[total] = '\0';
 
-	BN_free(bn);         BN_free(bn0);        BN_free(bn58);
-	BN_free(dv);         BN_free(rem);
-	BN_CTX_free(ctx);
+	return SUCCEEDED;
+}
 
-	return 0;
+size_t base58encode(byte *payload, size_t payload_len, uint8_t *encoded)
+{
+	size_t encoded_len;
+	Status status = base58_encode(payload, payload_len, encoded, encoded ? SIZE_MAX : 0, &encoded_len);
+
+	if (status == MEMORY_ALLOCATE_FAILED)
+		return -1; // 0xffffffffffffffff
+
+	return encoded ? 0 : encoded_len;
 }
 
-size_t base58decode(uint8_t *payload, size_t payload_len, byte *decoded)
+Status base58_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len)
 {
 	// Get the count of leading '1' charater.
 	size_t leading_one_count = 0;
+	while (leading_one_count < payload_len && payload[leading_one_count] == '1')
+		leading_one_count++;
+
+	const uint8_t *digits = payload + leading_one_count;
+	size_t digits_len = payload_len - leading_one_count;
+	if (digits_len >= base58_radix.decode_threshold)
+		return radix_dc_decode_string(&base58_radix, base58map, digits, digits_len, leading_one_count, decoded,
+			capacity, decoded_len);
+
+	// log(58)/log(2^32) < 0.19, one extra limb for rounding.
+	uint32_t limbs[digits_len * 19 / 100 + 2];
+	size_t limbs_len = 0;
+
+	// Fold the digits in, five digits per pass.
+	// The first group takes the (digits_len % 5) head digits.
+	size_t head = digits_len % B58_LIMB_DIGITS ? digits_len % B58_LIMB_DIGITS : B58_LIMB_DIGITS;
+	for (size_t i = 0; i < digits_len; i += head, head = B58_LIMB_DIGITS)
+	{
+		uint64_t carry = 0;
+		for (size_t k = 0; k < head; ++k)
+		{
+			int8_t value = base58map[digits[i + k]];
+			if (value < 0)
+				return CODEC_INVALID_CHARACTER;
+			carry = carry * 58 + value;
+		}
+		uint64_t multiplier = base58power[head];
 
-	for (size_t i = 0; ; ++i)
+		for (size_t j = 0; j < limbs_len; ++j)
+		{
+			uint64_t t = limbs[j] * multiplier + carry;
+			limbs[j] = (uint32_t)t;
+			carry = t >> 32;
+		}
+		if (carry)
+			limbs[limbs_len++] = (uint32_t)carry;
+	}
+
+	// Only the most significant limb can carry leading zero bytes.
+	size_t top_bytes = 0;
+	if (limbs_len)
 	{
-		if (payload[i] == '1')
-			leading_one_count++;
-		else break;
+		uint32_t top = limbs[limbs_len - 1];
+		while (top_bytes < 4 && (top >> (top_bytes * 8)))
+			top_bytes++;
 	}
+	size_t raw_decoded_len = limbs_len ? (limbs_len - 1) * 4 + top_bytes : 0;
+	size_t total = raw_decoded_len + leading_one_count;
 
-	size_t raw_payload_len = payload_len - leading_one_count;
-	uint8_t raw_payload[raw_payload_len];
+	*decoded_len = total;
+	if (capacity < total)
+		return CODEC_BUFFER_TOO_SMALL;
 
-	// Get the leading '1' striped raw payload.
-	for (size_t i = 0; i < payload_len; ++i)
-		raw_payload[i] = payload[leading_one_count + i];
+	// Add the leading 0x00 byte.
+	for (size_t i = 0; i < leading_one_count; ++i)
+		decoded[i] = 0x00;
 
-	// Get b58 value of each charaters in raw payload string, and check the validation.
-	for (size_t i = 0; i < raw_payload_len; ++i)
+	// Write the bytes from the least significant end.
+	byte *cursor = decoded + total;
+	for (size_t j = 0; j < limbs_len; ++j)
 	{
-		size_t j = 0;
-		for ( ; j < 58; ++j)
+		uint32_t limb = limbs[j];
+		size_t bytes = (j == limbs_len - 1) ? top_bytes : 4;
+		for (size_t k = 0; k < bytes; ++k)
 		{
-			if (raw_payload[i] == base58table[j])
-			{
-				raw_payload[i] = j;
-				break;
-			}
+			*--cursor = (byte)limb;
+			limb >>= 8;
 		}
-		if (j == 58)
-			return -1; // 0xffffffffffffffff
-	}
-	/*
-	*  Convert b58 value array to a big number.
-	*  to_add = b58_value * 58 ^ power;
-	*  to_add = b58_value * powered;
-	*  bignum = bignum + to_add;
-	*/
-	BIGNUM *bn     = BN_new();   BIGNUM *bn58    = BN_new();   BIGNUM *b58value = BN_new();
-	BN_is_zero(bn);              BN_set_word(bn58, 58);
-
-	BIGNUM *power  = BN_new();   BIGNUM *powered = BN_new();
-
-	BIGNUM *to_add = BN_new();   BIGNUM *buffer  = BN_new();
-	BN_is_zero(to_add);          BN_is_zero(buffer);
-
-	BN_CTX *ctx1 = BN_CTX_new(); BN_CTX *ctx2 = BN_CTX_new();
-
-	for (size_t i = 0; i < raw_payload_len; ++i)
-	{
-		BN_set_word(b58value, raw_payload[i]);
-		BN_set_word(power, raw_payload_len - 1 - i);
-		BN_exp(powered, bn58, power, ctx1);
-		BN_mul(to_add, b58value, powered, ctx2);
-		BN_add(bn, buffer, to_add);
-		BN_swap(bn, buffer);
-	}
-	BN_swap(bn, buffer);
-
-	// Convert the big number to hexadecimal string.
-	char *raw_decoded_hexstr;
-	raw_decoded_hexstr = BN_bn2hex(bn);
-
-	// Convert raw decoded hexadecimal string to byte array.
-	size_t decoded_len = strlen((const char *)raw_decoded_hexstr) / 2 + leading_one_count;
-	if (decoded == NULL) {
-		// Free Memory, Bug Fixed Apr. 29 2018
-		BN_free(bn);             BN_free(bn58);           BN_free(b58value);
-		BN_free(power);          BN_free(powered);
-		BN_free(to_add);         BN_free(buffer);
-		BN_CTX_free(ctx1);       BN_CTX_free(ctx2);
-		free(raw_decoded_hexstr);
+	}
 
-		return decoded_len;
+	return SUCCEEDED;
+}
+
+size_t base58decode(uint8_t *payload, size_t payload_len, byte *decoded)
+{
+	size_t decoded_len;
+	Status status = base58_decode(payload, payload_len, decoded, decoded ? SIZE_MAX : 0, &decoded_len);
+
+	if (status == CODEC_INVALID_CHARACTER || status == MEMORY_ALLOCATE_FAILED)
+		return -1; // 0xffffffffffffffff
+
+	return decoded ? 0 : decoded_len;
+}
+
+size_t base58decode_fixed(uint8_t *payload, size_t payload_len, byte *decoded, size_t decoded_len)
+{
+	switch (decoded_len)
+	{
+		case 21: return base58decode_sized(payload, payload_len, decoded, 21, 6, 6, 6);
+		case 25: return base58decode_sized(payload, payload_len, decoded, 25, 7, 7, 7);
+		case 33: return base58decode_sized(payload, payload_len, decoded, 33, 9, 10, 10);
+		case 37: return base58decode_sized(payload, payload_len, decoded, 37, 10, 11, 11);
+		case 38: return base58decode_sized(payload, payload_len, decoded, 38, 10, 11, 11);
 	}
 
-	hexstr_to_bytearr((uint8_t*)raw_decoded_hexstr, strlen((const char *)raw_decoded_hexstr), decoded);
+	size_t leading_one_count = 0;
+	while (leading_one_count < payload_len && payload[leading_one_count] == '1')
+		leading_one_count++;
+	if (leading_one_count > decoded_len)
+		return -2; // 0xfffffffffffffffe
+
+	const uint8_t *digits = payload + leading_one_count;
+	size_t digits_len = payload_len - leading_one_count;
+	size_t value_len = decoded_len - leading_one_count;
+
+	// Limbs are little-endian, one spare limb catches the overflow.
+	size_t limbs_len = value_len / 4 + 1;
+	uint32_t limbs[limbs_len];
+	memset(limbs, 0, sizeof(limbs));
+
+	size_t head = digits_len % B58_LIMB_DIGITS ? digits_len % B58_LIMB_DIGITS : B58_LIMB_DIGITS;
+	for (size_t i = 0; i < digits_len; i += head, head = B58_LIMB_DIGITS)
+	{
+		uint64_t carry = 0;
+		for (size_t k = 0; k < head; ++k)
+		{
+			int8_t value = base58map[digits[i + k]];
+			if (value < 0)
+				return -1; // 0xffffffffffffffff
+			carry = carry * 58 + value;
+		}
+		uint64_t multiplier = base58power[head];
+
+		for (size_t j = 0; j < limbs_len; ++j)
+		{
+			uint64_t t = limbs[j] * multiplier + carry;
+			limbs[j] = (uint32_t)t;
+			carry = t >> 32;
+		}
+		if (carry)
+			return -2; // 0xfffffffffffffffe
+	}
+
+	// The value must fill exactly 'value_len' bytes, no more and no less.
+	uint32_t top = limbs[value_len / 4] >> (value_len % 4 * 8);
+	if (top != 0)
+		return -2; // 0xfffffffffffffffe
+	if (value_len && !((limbs[(value_len - 1) / 4] >> ((value_len - 1) % 4 * 8)) & 0xff))
+		return -2; // 0xfffffffffffffffe
 
-	// Add the leading 0x00 byte.
-	for (size_t i = 0; i < decoded_len; ++i)
-		decoded[decoded_len - 1 -i] = decoded[decoded_len - 1 - leading_one_count -i];
 	for (size_t i = 0; i < leading_one_count; ++i)
 		decoded[i] = 0x00;
-
-	BN_free(bn);             BN_free(bn58);           BN_free(b58value);
-	BN_free(power);          BN_free(powered);
-	BN_free(to_add);         BN_free(buffer);
-	BN_CTX_free(ctx1);       BN_CTX_free(ctx2);
-	free(raw_decoded_hexstr);
+	for (size_t i = 0; i < value_len; ++i)
+		decoded[decoded_len - 1 - i] = (byte)(limbs[i / 4] >> (i % 4 * 8));
 
 	return 0;
 }
 
-size_t base58check_encode(byte *payload, size_t payload_len, uint8_t *encoded)
+#define BASE58_CHECK_STACK 128 // Bytes, addresses and WIF keys stay on the stack, larger payloads go to the heap.
+
+Status base58_check_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity,
+	size_t *encoded_len)
 {
-	int32_t to_base58_len = payload_len + 4;
-	byte first_sha256[32], second_sha256[32], to_base58[to_base58_len];
+	byte second_sha256[32], stack[BASE58_CHECK_STACK], *to_base58 = stack;
+	Status status;
+
+	if (payload_len + 4 > sizeof(stack))
+	{
+		to_base58 = (byte *)malloc(payload_len + 4);
+		if (to_base58 == NULL)
+			return MEMORY_ALLOCATE_FAILED;
+	}
 
-	SHA256(payload, payload_len, first_sha256);
-	SHA256(first_sha256, 32, second_sha256);
+	sha256d(payload, payload_len, second_sha256);
+	memcpy(to_base58, payload, payload_len);
+	memcpy(to_base58 + payload_len, second_sha256, 4);
+
+	status = base58_encode(to_base58, payload_len + 4, encoded, capacity, encoded_len);
+	if (to_base58 != stack)
+		free(to_base58);
+	return status;
+}
+
+Status base58_check_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity,
+	size_t *decoded_len)
+{
+	byte second_sha256[32], stack[BASE58_CHECK_STACK], *b58decoded = stack;
+	size_t b58decoded_bound = BASE58_DECODE_BOUND(payload_len) + 1, b58decoded_len;
+	Status status;
+
+	if (b58decoded_bound > sizeof(stack))
+	{
+		b58decoded = (byte *)malloc(b58decoded_bound);
+		if (b58decoded == NULL)
+			return MEMORY_ALLOCATE_FAILED;
+	}
+
+	status = base58_decode(payload, payload_len, b58decoded, b58decoded_bound, &b58decoded_len);
+	if (status == SUCCEEDED && b58decoded_len < 4)
+		status = CODEC_INVALID_CHECKSUM;
+	if (status == SUCCEEDED)
+	{
+		size_t data_len = b58decoded_len - 4;
+		sha256d(b58decoded, data_len, second_sha256);
+		if (memcmp(b58decoded + data_len, second_sha256, 4) != 0)
+			status = CODEC_INVALID_CHECKSUM;
+		else
+		{
+			*decoded_len = data_len;
+			if (capacity < data_len)
+				status = CODEC_BUFFER_TOO_SMALL;
+			else
+				memcpy(decoded, b58decoded, data_len);
+		}
+	}
 
-	for (int32_t i = 0; i < payload_len; ++i)
-		to_base58[i] = payload[i];
-	for (int32_t i = 0; i < 4; ++i)
-		to_base58[payload_len + i] = second_sha256[i];
+	if (b58decoded != stack)
+		free(b58decoded);
+	return status;
+}
 
-	if (encoded == NULL)
-		return base58encode(to_base58, to_base58_len, NULL);
+size_t base58check_encode(byte *payload, size_t payload_len, uint8_t *encoded)
+{
+	size_t encoded_len;
+	Status status = base58_check_encode(payload, payload_len, encoded, encoded ? SIZE_MAX : 0, &encoded_len);
 
-	size_t ret = base58encode(to_base58, to_base58_len, encoded);
-	if (ret == 0xffffffffffffffff)
+	if (status == MEMORY_ALLOCATE_FAILED)
 		return -1; // 0xffffffffffffffff
 
-	return 0;
+	return encoded ? 0 : encoded_len;
 }
 
 size_t base58check_decode(uint8_t *payload, size_t payload_len, byte *decoded)
 {
-	int32_t b58decoded_len = base58decode(payload, payload_len, NULL);
-	if (b58decoded_len == -1)
+	size_t decoded_len = 0;
+	Status status = base58_check_decode(payload, payload_len, decoded, decoded ? SIZE_MAX : 0, &decoded_len);
+
+	if (status == CODEC_INVALID_CHARACTER || status == MEMORY_ALLOCATE_FAILED)
 		return -1; // 0xffffffffffffffff
-	int32_t data_len = b58decoded_len-4;
-	byte b58decoded[b58decoded_len];
+	else if (status == CODEC_INVALID_CHECKSUM)
+		return -2; // 0xfffffffffffffffe
 
-	base58decode(payload, payload_len, b58decoded);
+	return decoded ? 0 : decoded_len;
+}
 
-	byte payload_data[data_len], payload_checksum[4];
-	byte first_sha256[32], second_sha256[32];
+/******************** Base64 ********************/
+// Character to base64 value, 0xff for '=' and non-base64 characters.
+static const uint8_t base64map[256] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,   62, 0xff, 0xff, 0xff,   63,
+	  52,   53,   54,   55,   56,   57,   58,   59,   60,   61, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff,    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+	  15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff,   26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+	  41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static inline void base64_encode_group(const byte *group, uint8_t *out)
+{
+	out[0] = base64table[group[0] >> 2];
+	out[1] = base64table[((group[0] & 0x03) << 4) | (group[1] >> 4)];
+	out[2] = base64table[((group[1] & 0x0f) << 2) | (group[2] >> 6)];
+	out[3] = base64table[group[2] & 0x3f];
+}
 
-	for (int32_t i = 0; i < data_len; ++i)
-		payload_data[i] = b58decoded[i];
-	for (int32_t i = 0; i < 4; ++i)
-		payload_checksum[i] = b58decoded[data_len+i];
+// 'count' (2 ~ 4) sextets to count - 1 bytes.
+static inline size_t base64_decode_quantum(const uint8_t *values, uint8_t count, byte *out)
+{
+	uint32_t bits = 0;
+	for (uint8_t i = 0; i < 4; ++i)
+		bits = (bits << 6) | (i < count ? values[i] : 0);
+
+	out[0] = bits >> 16;
+	if (count > 2) out[1] = bits >> 8;
+	if (count > 3) out[2] = bits;
+	return count - 1;
+}
 
-	SHA256(payload_data, data_len, first_sha256);
-	SHA256(first_sha256, 32, second_sha256);
+size_t base64_encode_scalar(const byte *data, size_t len, uint8_t *out)
+{
+	size_t i;
+	for (i = 0; i + 3 <= len; i += 3, out += 4)
+		base64_encode_group(data + i, out);
+	return i;
+}
 
-	for (int32_t i = 0; i < 4; ++i)
+size_t base64_decode_scalar(const uint8_t *str, size_t len, byte *out)
+{
+	size_t i;
+	for (i = 0; i + 4 <= len; i += 4, out += 3)
 	{
-		if (payload_checksum[i] != second_sha256[i])
-			return -1; // 0xffffffffffffffff
+		uint8_t a = base64map[str[i]], b = base64map[str[i+1]];
+		uint8_t c = base64map[str[i+2]], d = base64map[str[i+3]];
+		if ((a | b | c | d) & 0x80)
+			break;
+		uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+		out[0] = bits >> 16;
+		out[1] = bits >> 8;
+		out[2] = bits;
 	}
+	return i;
+}
 
-	if (decoded == NULL)
-		return data_len;
-	else {
-		for (int i = 0; i < data_len; ++i) {
-			decoded[i] = payload_data[i];
-		}
-		return 0;
+static BASE64_IMPL base64_selected_impl = BASE64_AUTO;
+static size_t (*base64_encode_kernel)(const byte *, size_t, uint8_t *) = &base64_encode_scalar;
+static size_t (*base64_decode_kernel)(const uint8_t *, size_t, byte *) = &base64_decode_scalar;
+
+Status base64_select(BASE64_IMPL impl)
+{
+	__builtin_cpu_init();
+	if (impl == BASE64_AUTO)
+	{
+		base64_select(__builtin_cpu_supports("avx2") ? BASE64_AVX2 : BASE64_SCALAR);
+		base64_selected_impl = BASE64_AUTO;
+		return SUCCEEDED;
 	}
 
-	return 0;
+	switch (impl)
+	{
+		case BASE64_SCALAR:
+			base64_encode_kernel = &base64_encode_scalar;
+			base64_decode_kernel = &base64_decode_scalar;
+			break;
+		case BASE64_AVX2:
+			if (!__builtin_cpu_supports("avx2"))
+				return FAILED;
+			base64_encode_kernel = &base64_encode_avx2;
+			base64_decode_kernel = &base64_decode_avx2;
+			break;
+		default:
+			return FAILED;
+	}
+	base64_selected_impl = impl;
+	return SUCCEEDED;
 }
 
-size_t base64encode(byte *payload, size_t payload_len, uint8_t *encoded)
+BASE64_IMPL base64_selected(void)
 {
-	int32_t encoded_len;
-	int32_t ending = payload_len % 3;
+	return base64_selected_impl;
+}
+
+// Select the kernels once when the library is loaded.
+__attribute__((constructor)) static void base64_init(void)
+{
+	base64_select(BASE64_AUTO);
+}
 
-	if (encoded == NULL)
+void base64_encode_init(Base64Stream *stream)
+{
+	memset(stream, 0, sizeof(Base64Stream));
+}
+
+size_t base64_encode_update(Base64Stream *stream, const byte *data, size_t len, uint8_t *encoded)
+{
+	size_t i = 0, n = 0, done;
+
+	// Complete the group left over from the last call.
+	while (stream->pending_len && i < len)
 	{
-		if (ending != 0)
+		stream->pending[stream->pending_len++] = data[i++];
+		if (stream->pending_len == 3)
 		{
-			encoded_len = payload_len / 3 * 4 + 4;
-			return encoded_len;
-		}
-		else{
-			encoded_len = payload_len / 3 * 4;
-			return encoded_len;
+			base64_encode_group(stream->pending, encoded);
+			stream->pending_len = 0;
+			n = 4;
 		}
 	}
 
-	for (int32_t i = 0; i < payload_len - ending; i+=3)
-	{
-		int32_t num = i + i / 3;
-		encoded[num] = base64table[payload[i] >> 2];
-		encoded[num+1] = base64table[((payload[i] & 0x03) << 4) | (payload[i+1] >> 4)];
-		encoded[num+2] = base64table[((payload[i+1] & 0x0f) << 2) | (payload[i+2] >> 6)];
-		encoded[num+3] = base64table[payload[i+2] & 0x3f];
-	}
+	// The kernel takes the bulk, the scalar loop the groups it leaves.
+	done = base64_encode_kernel(data + i, len - i, encoded + n);
+	done += base64_encode_scalar(data + i + done, len - i - done, encoded + n + done / 3 * 4);
+	i += done;
+	n += done / 3 * 4;
 
-	if (ending != 0)
-	{	
-		int32_t start = (payload_len - ending)/3 + (payload_len - ending);
-		byte buffer[3] = {0x00, 0x00, 0x00};
-		for (int32_t i = 0; i < ending; ++i)
-			buffer[i] = payload[payload_len - ending + i];
+	while (i < len)
+		stream->pending[stream->pending_len++] = data[i++];
 
-		encoded[start] = base64table[buffer[0] >> 2] == 'A' ? '=' : base64table[buffer[0] >> 2];
-		encoded[start+1] = base64table[((buffer[0] & 0x03) << 4) | (buffer[1] >> 4)];
-		encoded[start+2] = base64table[((buffer[1] & 0x0f) << 2) | (buffer[2] >> 6)] == 'A' ? '=' : base64table[((buffer[1] & 0x0f) << 2) | (buffer[2] >> 6)];
-		encoded[start+3] = base64table[buffer[2] & 0x3f] == 'A' ? '=' : base64table[buffer[2] & 0x3f];
-		encoded[start+4] = '\0';
-
-		return 0;
-	}
-	else return 0;
+	return n;
 }
 
-size_t base64decode(uint8_t *payload, size_t payload_len, byte *decoded)
+size_t base64_encode_final(Base64Stream *stream, uint8_t *encoded)
 {
-	int32_t ending = 0;
-	for (int32_t i = payload_len - 1; i >= 0; --i )
-	{
-		if (payload[i] == '=')
-			ending++;
-		else break;
-	}
+	uint8_t pending_len = stream->pending_len;
 
-	int32_t decoded_len = ending ? (payload_len - 4) / 4 * 3 + 3 - ending : payload_len / 4 * 3;
+	if (pending_len == 0)
+		return 0;
 
-	if (decoded == NULL)
-		return decoded_len;
+	memset(stream->pending + pending_len, 0, 3 - pending_len);
+	base64_encode_group(stream->pending, encoded);
+	for (uint8_t i = pending_len + 1; i < 4; ++i)
+		encoded[i] = '=';
+	base64_encode_init(stream);
+
+	return 4;
+}
 
-	int32_t payload_copy_len = (ending == 0 ? payload_len : payload_len - 4);
-	byte payload_copy[payload_copy_len];
+void base64_decode_init(Base64Stream *stream)
+{
+	memset(stream, 0, sizeof(Base64Stream));
+}
+
+Status base64_decode_update(Base64Stream *stream, const uint8_t *str, size_t len, byte *decoded, size_t *decoded_len)
+{
+	size_t i = 0, n = 0, done;
 
-	// Get b64 value of each charaters in payload string, and check the validation.
-	for (int32_t i = 0; i < payload_copy_len; ++i)
+	while (i < len)
 	{
-		int32_t j = 0;
-		for ( ; j < 64; ++j)
+		// Whole quanta go through the kernels, they stop before a '=' or a bad character.
+		if (stream->pending_len == 0 && stream->padding == 0 && !stream->finished)
 		{
-			if (payload[i] == base64table[j])
-			{
-				payload_copy[i] = j;
+			done = base64_decode_kernel(str + i, len - i, decoded + n);
+			done += base64_decode_scalar(str + i + done, len - i - done, decoded + n + done / 4 * 3);
+			i += done;
+			n += done / 4 * 3;
+			if (i == len)
 				break;
-			}
 		}
-		if (j == 64)
-			return -1; // 0xffffffffffffffff
-	}
 
-	for (int32_t i = 0; i < payload_copy_len; i+=4)
-	{
-		int32_t num = i - i / 4;
-		decoded[num] = (payload_copy[i] << 2) | ((payload_copy[i+1] & 0x30) >> 4);
-		decoded[num+1] = ((payload_copy[i+1] & 0x0F) << 4) | ((payload_copy[i+2] & 0x3C) >> 2);
-		decoded[num+2] = ((payload_copy[i+2] & 0x03) << 6) | (payload_copy[i+3] & 0x3F);
+		// One character at a time up to the end of the quantum.
+		uint8_t c = str[i++];
+		if (stream->finished)
+			return BASE64_INVALID_PADDING;
+		if (c == '=')
+		{
+			// Only the last two characters of a quantum may be padding.
+			if (stream->pending_len + stream->padding < 2)
+				return BASE64_INVALID_PADDING;
+			stream->padding++;
+		}
+		else if (base64map[c] == 0xff)
+			return BASE64_INVALID_CHARACTER;
+		else if (stream->padding)
+			return BASE64_INVALID_PADDING;
+		else
+			stream->pending[stream->pending_len++] = base64map[c];
+
+		if (stream->pending_len + stream->padding == 4)
+		{
+			n += base64_decode_quantum(stream->pending, stream->pending_len, decoded + n);
+			stream->finished = stream->padding != 0;
+			stream->pending_len = 0;
+			stream->padding = 0;
+		}
 	}
 
-	if (ending != 0)
+	*decoded_len = n;
+	return SUCCEEDED;
+}
+
+Status base64_decode_final(Base64Stream *stream, byte *decoded, size_t *decoded_len)
+{
+	*decoded_len = 0;
+
+	// A quantum cut inside its padding, or a lone character, can't be decoded.
+	if (stream->padding || stream->pending_len == 1)
+		return BASE64_INVALID_PADDING;
+	// An unpadded last quantum.
+	if (stream->pending_len)
+		*decoded_len = base64_decode_quantum(stream->pending, stream->pending_len, decoded);
+	base64_decode_init(stream);
+
+	return SUCCEEDED;
+}
+
+Status base64_encode(const byte *payload, size_t payload_len, uint8_t *encoded, size_t capacity, size_t *encoded_len)
+{
+	Base64Stream stream;
+	size_t len;
+
+	*encoded_len = BASE64_ENCODED_LEN(payload_len);
+	if (capacity <= *encoded_len)
+		return CODEC_BUFFER_TOO_SMALL;
+
+	base64_encode_init(&stream);
+	len = base64_encode_update(&stream, payload, payload_len, encoded);
+	len += base64_encode_final(&stream, encoded + len);
+	encoded[len] = '\0';
+
+	return SUCCEEDED;
+}
+
+Status base64_decode(const uint8_t *payload, size_t payload_len, byte *decoded, size_t capacity, size_t *decoded_len)
+{
+	Base64Stream stream;
+	size_t chars = payload_len, len, tail_len;
+	Status status;
+
+	// The length follows from the padding. Bad input stops the decoder before it writes more.
+	while (chars && payload_len - chars < 2 && payload[chars - 1] == '=')
+		chars--;
+	*decoded_len = chars / 4 * 3 + (chars % 4 ? chars % 4 - 1 : 0);
+	if (capacity < *decoded_len)
+		return CODEC_BUFFER_TOO_SMALL;
+
+	base64_decode_init(&stream);
+	status = base64_decode_update(&stream, payload, payload_len, decoded, &len);
+	if (status != SUCCEEDED)
+		return status;
+	status = base64_decode_final(&stream, decoded + len, &tail_len);
+	if (status != SUCCEEDED)
+		return status;
+
+	*decoded_len = len + tail_len;
+	return SUCCEEDED;
+}
+
+size_t base64encode(byte *payload, size_t payload_len, uint8_t *encoded)
+{
+	size_t encoded_len;
+
+	base64_encode(payload, payload_len, encoded, encoded ? SIZE_MAX : 0, &encoded_len);
+
+	return encoded ? 0 : encoded_len;
+}
+
+size_t base64decode(uint8_t *payload, size_t payload_len, byte *decoded)
+{
+	size_t decoded_len;
+	Status status;
+
+	if (decoded == NULL)
 	{
-		byte payload_copy_end[4] = {0x00, 0x00, 0x00, 0x00};
-		for (int32_t i = 0; i < 4-ending; ++i)
-		{
-			int32_t j = 0;
-			for ( ; j < 64; ++j)
-			{
-				if (payload[payload_copy_len + i] == base64table[j])
-				{
-					payload_copy_end[i] = j;
-					break;
-				}
-			}	
-		}
-		decoded[payload_copy_len - payload_copy_len / 4] = (payload_copy_end[0] << 2) | ((payload_copy_end[1] & 0x30) >> 4);
-		decoded[payload_copy_len - payload_copy_len / 4 + 1] = ((payload_copy_end[1] & 0x0F) << 4) | ((payload_copy_end[2] & 0x3C) >> 2);
+		base64_decode(payload, payload_len, NULL, 0, &decoded_len);
+		return decoded_len;
 	}
 
-	decoded[decoded_len] = '\0';
+	status = base64_decode(payload, payload_len, decoded, SIZE_MAX, &decoded_len);
+	if (status != SUCCEEDED)
+		return -1; // 0xffffffffffffffff
 
 	return 0;
 }
 
+/******************** Base 2^8 / 2^16 / 2^32 ********************/
+/*
+*  The digits are little-endian and so are the x86 words, a number has the same bytes in every
+*  one of these bases. A conversion moves the payload as is and zeroes the rest of the last digit,
+*  memmove does it at full vector width and lets 'converted' be 'payload' itself.
+*/
+static inline void radix_repack(const void *payload, size_t payload_size, void *converted, size_t converted_size)
+{
+	size_t copy_size = payload_size < converted_size ? payload_size : converted_size;
+
+	memmove(converted, payload, copy_size);
+	memset((byte *)converted + copy_size, 0x00, converted_size - copy_size);
+}
+
 size_t base2p8_to_base2p32(uint8_t *payload, size_t payload_len, uint32_t *converted)
 {
 	size_t remain = payload_len % 4;
-	size_t converted_len = (payload_len / 4) + (payload_len % 4 ? 1 : 0);
+	size_t converted_len = (payload_len + 3) / 4;
 
 	// If remains are all 0, the length after conversion should minus 1.
 	size_t i;
@@ -490,30 +1472,24 @@ size_t base2p8_to_base2p32(uint8_t *payload, size_t payload_len, uint32_t *conve
 
 	// If null return the length after conversion.
 	if (converted == NULL)
-	{
 		return converted_len;
-	}
-
-	// Fill the array with zero to prevent errors while bits operating.
-	memset(converted, 0x00, converted_len * sizeof(uint32_t));
 
-	for (int i = 0; i < payload_len; ++i)
-	{
-		converted[i/4] |= (i%4) ? payload[i]<<(8*(i%4)) : payload[i];
-	}
+	radix_repack(payload, payload_len, converted, converted_len * sizeof(uint32_t));
 
 	return 0;
 }
 
 size_t base2p32_to_base2p8(uint32_t *payload, size_t payload_len, uint8_t *converted)
 {
-	uint32_t payload_last = payload[payload_len-1];
+	uint32_t payload_last = payload_len ? payload[payload_len-1] : 0;
 	size_t converted_len = (payload_len * 4);
 
 	// If the last element of payload is 0, the length after conversion should minus 4.
 	// If the last element of payload is smaller than a specific number,
 	// the length after conversion should be shortter, usually 1 to 3.
-	if (!payload_last)
+	if (!payload_len)
+		converted_len = 0;
+	else if (!payload_last)
 		converted_len -= 4;
 	else if (payload_last < (1<<8))
 		converted_len -= 3;
@@ -524,101 +1500,50 @@ size_t base2p32_to_base2p8(uint32_t *payload, size_t payload_len, uint8_t *conve
 
 	// If null return the length after conversion.
 	if (converted == NULL)
-	{
 		return converted_len;
-	}
-
-	// Fill the array with zero to prevent errors while bits operating.
-	memset(converted, 0x00, converted_len * sizeof(uint16_t));  // Necessary.
 
-	for (int i = 0; i < payload_len; ++i)
-	{
-		if ( !(i == payload_len - 1 && payload_last == 0) )
-		{
-			converted[i*4] = payload[i] << 24 >> 24;
-		}
-		if ( !(i == payload_len - 1 && payload_last < (1<<8)) )
-		{
-			converted[i*4+1] = payload[i] << 16 >> 24;
-		}
-		if ( !(i == payload_len - 1 && payload_last < (1<<16)) )
-		{
-			converted[i*4+2] = payload[i] << 8 >> 24;
-		}
-		if ( !(i == payload_len - 1 && payload_last < (1<<24)) )
-		{
-			converted[i*4+3] = payload[i] >> 24;
-		}
-	}
+	radix_repack(payload, payload_len * sizeof(uint32_t), converted, converted_len);
 
 	return 0;
 }
 
 size_t base2p16_to_base2p32(uint16_t *payload, size_t payload_len, uint32_t *converted)
 {
-	size_t remain = payload_len % 2;
 	size_t converted_len = (payload_len / 2) + (payload_len % 2);
 
-	// If remains are all 0, the length after conversion should minus 1.
-	size_t i;
-	for (i = 0; i < remain; ++i)
-	{
-		if (payload[payload_len-remain+i])
-			break;
-	}
-	if (i == remain && remain != 0)
+	// If the remain is 0, the length after conversion should minus 1.
+	if (payload_len % 2 && !payload[payload_len-1])
 		--converted_len;
 
 	// If null return the length after conversion.
 	if (converted == NULL)
-	{
 		return converted_len;
-	}
 
-	// Fill the array with zero to prevent errors while bits operating.
-	memset(converted, 0x00, converted_len * sizeof(uint32_t));
-
-	for (int i = 0; i < payload_len; ++i)
-	{
-		converted[i/2] |= (i%2) ? payload[i]<<16 : payload[i];
-	}
+	radix_repack(payload, payload_len * sizeof(uint16_t), converted, converted_len * sizeof(uint32_t));
 
 	return 0;
 }
 
 size_t base2p32_to_base2p16(uint32_t *payload, size_t payload_len, uint16_t *converted)
 {
-	uint32_t payload_last = payload[payload_len-1];
+	uint32_t payload_last = payload_len ? payload[payload_len-1] : 0;
 	size_t converted_len = payload_len * 2;
 
 	// If the last element of payload is 0, the length after conversion should minus 2.
 	// Else if the last element of payload is smaller than a specific number,
 	// the length after conversion should minus 1.
-	if (!payload_last)
+	if (!payload_len)
+		converted_len = 0;
+	else if (!payload_last)
 		converted_len -= 2;
 	else
 		converted_len -= payload_last < (1<<16) ? 1 : 0;
 
 	// If null return the length after conversion.
 	if (converted == NULL)
-	{
 		return converted_len;
-	}
 
-	// Fill the array with zero to prevent errors while bits operating.
-	memset(converted, 0x00, converted_len * sizeof(uint16_t));
-
-	for (int i = 0; i < payload_len; ++i)
-	{
-		if ( !(i == payload_len - 1 && payload_last == 0) )
-		{
-			converted[i*2] = payload[i] << 16 >> 16;
-		}
-		if ( !(i == payload_len - 1 && payload_last < (1<<16)) )
-		{
-			converted[i*2+1] = payload[i] >> 16;
-		}
-	}
+	radix_repack(payload, payload_len * sizeof(uint32_t), converted, converted_len * sizeof(uint16_t));
 
 	return 0;
-}
\ No newline at end of file
+}
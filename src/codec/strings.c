@@ -16,73 +16,147 @@ int32_t get_strlen(uint8_t *string)
 	return length;
 }
 **/
-// fix it
-Status hexstr_to_bytearr(uint8_t *str, size_t str_len, byte *arr)
+/******************** Hexadecimal ********************/
+const uint8_t hex_digits[2][16] = {
+	{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'},
+	{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'},
+};
+
+// Nibble value of every character, 0xff for non-hexadecimal characters.
+static const uint8_t hex_values[256] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+size_t hex_encode_scalar(const byte *arr, size_t arr_len, uint8_t *str, const uint8_t *digits)
 {
-	uint8_t high, low;
+	for (size_t i = 0; i < arr_len; ++i)
+	{
+		str[i*2]   = digits[arr[i] >> 4];
+		str[i*2+1] = digits[arr[i] & 0x0f];
+	}
+	return arr_len;
+}
 
-	if (str_len % 2 == 1)
-		return FAILED;
+size_t hex_decode_scalar(const uint8_t *str, size_t arr_len, byte *arr)
+{
+	size_t i = 0;
 
-	for (size_t i = 0; i < str_len; i+=2)
+	// Check a run of bytes at a time, stop before the run with the first bad character.
+	while (i < arr_len)
 	{
-		high = str[i];
-		low = str[i+1];
-
-		if (high >= '0' && high <= '9')
-			high = high - '0';
-		else if (high >= 'A' && high <= 'F')
-			high = high - 'A' + 10;
-		else if (high >= 'a' && high <= 'f')
-			high = high - 'a' + 10;
-		else return FAILED;
-
-		if (low >= '0' && low <= '9')
-			low = low - '0';
-		else if (low >= 'A' && low <= 'F')
-			low = low - 'A' + 10;
-		else if (low >= 'a' && low <= 'f')
-			low = low - 'a' + 10;
-		else return FAILED;
-
-		arr[i/2] = (high << 4) | low;
+		size_t end = arr_len - i < 32 ? arr_len : i + 32;
+		uint8_t bad = 0;
+		for (size_t j = i; j < end; ++j)
+		{
+			uint8_t high = hex_values[str[j*2]], low = hex_values[str[j*2+1]];
+			bad |= high | low;
+			arr[j] = (high << 4) | (low & 0x0f);
+		}
+		if (bad & 0x80)
+			break;
+		i = end;
 	}
+	return i;
+}
 
-	return SUCCEEDED;
+/******************** Kernel selection ********************/
+static HEX_IMPL selected = HEX_AUTO;
+static size_t (*encode)(const byte *, size_t, uint8_t *, const uint8_t *) = &hex_encode_scalar;
+static size_t (*decode)(const uint8_t *, size_t, byte *) = &hex_decode_scalar;
+
+static bool cpu_supports(HEX_IMPL impl)
+{
+	__builtin_cpu_init();
+	switch (impl)
+	{
+		case HEX_SCALAR: return true;
+		case HEX_SSSE3:  return __builtin_cpu_supports("ssse3");
+		case HEX_AVX2:   return __builtin_cpu_supports("avx2");
+		default: return false;
+	}
 }
 
-// fix it
-Status bytearr_to_hexstr(byte *arr, size_t arr_len, uint8_t *str)
+Status hex_select(HEX_IMPL impl)
 {
-	uint8_t high, low;
+	if (impl == HEX_AUTO)
+	{
+		hex_select(cpu_supports(HEX_AVX2) ? HEX_AVX2 : cpu_supports(HEX_SSSE3) ? HEX_SSSE3 : HEX_SCALAR);
+		selected = HEX_AUTO;
+		return SUCCEEDED;
+	}
+	if (!cpu_supports(impl))
+		return FAILED;
 
-	for (size_t i = 0; i < arr_len; ++i)
+	switch (impl)
 	{
-		if (arr[i] > 0xFF || arr[i] < 0x00)
-			return FAILED;
+		case HEX_SSSE3: encode = &hex_encode_ssse3;  decode = &hex_decode_ssse3;  break;
+		case HEX_AVX2:  encode = &hex_encode_avx2;   decode = &hex_decode_avx2;   break;
+		default:        encode = &hex_encode_scalar; decode = &hex_decode_scalar; break;
+	}
+	selected = impl;
+	return SUCCEEDED;
+}
 
-		high = arr[i];
-		low = arr[i];
+HEX_IMPL hex_selected(void)
+{
+	return selected;
+}
 
-		high = high >> 4;
-		low = low << 4;
-		low = low >> 4;
+// Select the kernels once when the library is loaded.
+__attribute__((constructor)) static void hex_init(void)
+{
+	hex_select(HEX_AUTO);
+}
 
-		if (high >= 0x00 && high <= 0x09)
-			str[i*2] = high + 0x30;
-		else if (high >= 0X0A && high <= 0x0F)
-			str[i*2] = high + 0x37;
+/******************** Conversion ********************/
+Status hexstr_to_bytearr(const uint8_t *str, size_t str_len, byte *arr)
+{
+	size_t arr_len = str_len / 2, done;
 
-		if (low >= 0x00 && low <= 0x09)
-			str[i*2+1] = low + 0x30;
-		else if (low >= 0X0A && low <= 0X0F)
-			str[i*2+1] = low + 0x37;
-	}
+	if (str_len % 2 == 1)
+		return HEXSTR_ODD_LENGTH;
+
+	// The SIMD kernels stop before a block with a bad character, the scalar one finds it.
+	done = decode(str, arr_len, arr);
+	done += hex_decode_scalar(str + done * 2, arr_len - done, arr + done);
+	if (done != arr_len)
+		return HEXSTR_INVALID_CHARACTER;
+
+	return SUCCEEDED;
+}
+
+Status bytearr_to_hexstr_case(const byte *arr, size_t arr_len, uint8_t *str, HEX_CASE hex_case)
+{
+	const uint8_t *digits = hex_digits[hex_case == HEX_LOWER];
+	size_t done;
+
+	done = encode(arr, arr_len, str, digits);
+	hex_encode_scalar(arr + done, arr_len - done, str + done * 2, digits);
 	str[arr_len*2] = '\0';
 
 	return SUCCEEDED;
 }
 
+Status bytearr_to_hexstr(const byte *arr, size_t arr_len, uint8_t *str)
+{
+	return bytearr_to_hexstr_case(arr, arr_len, str, HEX_UPPER);
+}
+
 void bytearr_reverse(byte *arr, size_t size)
 {
 	size_t len = 0;
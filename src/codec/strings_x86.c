@@ -0,0 +1,113 @@
+#include <immintrin.h>
+#include "internal/codec/strings.h"
+
+/******************** SSSE3 ********************/
+// 16 bytes to 32 characters per iteration.
+__attribute__((target("ssse3")))
+size_t hex_encode_ssse3(const byte *arr, size_t arr_len, uint8_t *str, const uint8_t *digits)
+{
+	const __m128i table = _mm_loadu_si128((const __m128i *)digits);
+	const __m128i nibble = _mm_set1_epi8(0x0f);
+	size_t i;
+
+	for (i = 0; i + 16 <= arr_len; i += 16)
+	{
+		__m128i bytes = _mm_loadu_si128((const __m128i *)(arr + i));
+		__m128i high = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+		__m128i low = _mm_shuffle_epi8(table, _mm_and_si128(bytes, nibble));
+		_mm_storeu_si128((__m128i *)(str + i * 2), _mm_unpacklo_epi8(high, low));
+		_mm_storeu_si128((__m128i *)(str + i * 2 + 16), _mm_unpackhi_epi8(high, low));
+	}
+	return i;
+}
+
+// Nibble values of 16 characters, 'valid' gets 0xff for every hexadecimal character.
+__attribute__((target("ssse3")))
+static inline __m128i nibbles_ssse3(__m128i chars, __m128i *valid)
+{
+	__m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+	__m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	// Unsigned x <= max as min(x, max) == x.
+	__m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+	__m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+	*valid = _mm_or_si128(is_digit, is_letter);
+	return _mm_or_si128(_mm_and_si128(is_digit, digit),
+		_mm_andnot_si128(is_digit, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+// 32 characters to 16 bytes per iteration, stop before a block with a bad character.
+__attribute__((target("ssse3")))
+size_t hex_decode_ssse3(const uint8_t *str, size_t arr_len, byte *arr)
+{
+	// (high, low) pairs to high * 16 + low.
+	const __m128i weights = _mm_set1_epi16(0x0110);
+	size_t i;
+
+	for (i = 0; i + 16 <= arr_len; i += 16)
+	{
+		__m128i valid0, valid1;
+		__m128i n0 = nibbles_ssse3(_mm_loadu_si128((const __m128i *)(str + i * 2)), &valid0);
+		__m128i n1 = nibbles_ssse3(_mm_loadu_si128((const __m128i *)(str + i * 2 + 16)), &valid1);
+		if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xffff)
+			break;
+		__m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(n0, weights), _mm_maddubs_epi16(n1, weights));
+		_mm_storeu_si128((__m128i *)(arr + i), bytes);
+	}
+	return i;
+}
+
+/******************** AVX2 ********************/
+// 32 bytes to 64 characters per iteration.
+__attribute__((target("avx2")))
+size_t hex_encode_avx2(const byte *arr, size_t arr_len, uint8_t *str, const uint8_t *digits)
+{
+	const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)digits));
+	const __m256i nibble = _mm256_set1_epi8(0x0f);
+	size_t i;
+
+	for (i = 0; i + 32 <= arr_len; i += 32)
+	{
+		__m256i bytes = _mm256_loadu_si256((const __m256i *)(arr + i));
+		__m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+		__m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(bytes, nibble));
+		// The unpacks work within 128-bit lanes, put the halves back in order.
+		__m256i lo = _mm256_unpacklo_epi8(high, low), hi = _mm256_unpackhi_epi8(high, low);
+		_mm256_storeu_si256((__m256i *)(str + i * 2), _mm256_permute2x128_si256(lo, hi, 0x20));
+		_mm256_storeu_si256((__m256i *)(str + i * 2 + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i nibbles_avx2(__m256i chars, __m256i *valid)
+{
+	__m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+	__m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	__m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+	__m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+
+	*valid = _mm256_or_si256(is_digit, is_letter);
+	return _mm256_blendv_epi8(_mm256_add_epi8(letter, _mm256_set1_epi8(10)), digit, is_digit);
+}
+
+// 64 characters to 32 bytes per iteration, stop before a block with a bad character.
+__attribute__((target("avx2")))
+size_t hex_decode_avx2(const uint8_t *str, size_t arr_len, byte *arr)
+{
+	const __m256i weights = _mm256_set1_epi16(0x0110);
+	size_t i;
+
+	for (i = 0; i + 32 <= arr_len; i += 32)
+	{
+		__m256i valid0, valid1;
+		__m256i n0 = nibbles_avx2(_mm256_loadu_si256((const __m256i *)(str + i * 2)), &valid0);
+		__m256i n1 = nibbles_avx2(_mm256_loadu_si256((const __m256i *)(str + i * 2 + 32)), &valid1);
+		if (_mm256_movemask_epi8(_mm256_and_si256(valid0, valid1)) != -1)
+			break;
+		// The pack interleaves the 128-bit lanes of both inputs, restore the byte order.
+		__m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(n0, weights), _mm256_maddubs_epi16(n1, weights));
+		_mm256_storeu_si256((__m256i *)(arr + i), _mm256_permute4x64_epi64(bytes, 0xd8));
+	}
+	return i;
+}
@@ -1,8 +1,12 @@
 #include "internal/crypto/ntt.h"
 #include "internal/crypto/bigint.h"
 #include "internal/codec/strings.h"
+#include "internal/codec/base.h"
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+typedef unsigned __int128 uint128_t;
 
 // Vertical calculation O(n)
 // r's max length = the longest + 1.
@@ -96,52 +100,687 @@ void d_sub(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len,
 	}
 }
 
-// NTT algorithm O(nlogn)
-// r's max length = a_len + b_len.
-// Using base32768 (2^15)
-void d_mul(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r)
+/******************** Multiplication ********************/
+/*
+*  d_mul picks the algorithm by the length of the shorter operand: schoolbook below
+*  karatsuba_threshold, Karatsuba above it, and the NTT from ntt_threshold on. Longer operands
+*  are cut into pieces. d_mul_parallel splits the NTT transforms across threads from
+*  parallel_threshold on. The defaults come from the Bigint bench.
+*/
+static BigintMulConfig mul_config = {
+	.karatsuba_threshold = 32,
+	.ntt_threshold       = 2048,
+	.parallel_threshold  = 16384,
+};
+
+// The product length the three-prime NTT transforms in one go.
+#define NTT_MAX_TOTAL_LIMBS ((size_t)1 << NTT_MAX_LOG)
+
+void Bigint_mul_config_set(const BigintMulConfig *config)
+{
+	mul_config = *config;
+	// Karatsuba needs pieces that shrink.
+	if (mul_config.karatsuba_threshold < 4)
+		mul_config.karatsuba_threshold = 4;
+}
+
+void Bigint_mul_config_get(BigintMulConfig *config)
+{
+	*config = mul_config;
+}
+
+// r[0, n) += a[0, n) * b, returns the carry limb.
+static inline uint32_t limbs_addmul_1(uint32_t *r, const uint32_t *a, uint32_t n, uint32_t b)
 {
-	// Base2^32 to Base2^15
-	
-	
-	// Get expanded length.
-	uint32_t expand_len = 1;
-	while (expand_len <= 2 * a_len || expand_len <= 2 * b_len)
-		expand_len <<= 1;
+	uint64_t c = 0;
+	uint32_t i = 0;
+
+	for (; i + 4 <= n; i += 4)
+	{
+		c += (uint64_t)a[i] * b + r[i];         r[i] = (uint32_t)c;         c >>= 32;
+		c += (uint64_t)a[i + 1] * b + r[i + 1]; r[i + 1] = (uint32_t)c;     c >>= 32;
+		c += (uint64_t)a[i + 2] * b + r[i + 2]; r[i + 2] = (uint32_t)c;     c >>= 32;
+		c += (uint64_t)a[i + 3] * b + r[i + 3]; r[i + 3] = (uint32_t)c;     c >>= 32;
+	}
+	for (; i < n; ++i)
+	{
+		c += (uint64_t)a[i] * b + r[i];
+		r[i] = (uint32_t)c;
+		c >>= 32;
+	}
+	return (uint32_t)c;
+}
 
-	// Expand.
-	uint64_t expand_a[expand_len];
-	uint64_t expand_b[expand_len];
-	memset(expand_a, 0, expand_len * sizeof(uint64_t));
-	memset(expand_b, 0, expand_len * sizeof(uint64_t));
+// r[0, a_len) = a + b, a_len >= b_len, returns the carry.
+static uint32_t limbs_add(uint32_t *r, const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len)
+{
+	uint64_t c = 0;
 	for (uint32_t i = 0; i < a_len; ++i)
 	{
-		expand_a[i] = a[i];
+		c += (uint64_t)a[i] + (i < b_len ? b[i] : 0);
+		r[i] = (uint32_t)c;
+		c >>= 32;
+	}
+	return (uint32_t)c;
+}
+
+// r[0, r_len) += b[0, b_len), r_len >= b_len, the carry runs to the end of 'r'.
+static void limbs_add_to(uint32_t *r, uint32_t r_len, const uint32_t *b, uint32_t b_len)
+{
+	uint64_t c = 0;
+	uint32_t i = 0;
+	for (; i < b_len; ++i)
+	{
+		c += (uint64_t)r[i] + b[i];
+		r[i] = (uint32_t)c;
+		c >>= 32;
 	}
-	for (uint32_t i = 0; i < b_len; ++i)
+	for (; c && i < r_len; ++i)
 	{
-		expand_b[i] = b[i];
+		c += r[i];
+		r[i] = (uint32_t)c;
+		c >>= 32;
 	}
+}
 
-	// Convert.
-	ntt(expand_a, expand_len, false);
-	ntt(expand_b, expand_len, false);
-	for (uint32_t i = 0; i < expand_len; ++i)
-		expand_a[i] = expand_a[i] * expand_b[i] % P;
-	ntt(expand_a, expand_len, true);
+// r[0, r_len) -= b[0, b_len), r_len >= b_len, 'r' must not go below zero.
+static void limbs_sub_from(uint32_t *r, uint32_t r_len, const uint32_t *b, uint32_t b_len)
+{
+	uint64_t borrow = 0;
+	uint32_t i = 0;
+	for (; i < b_len; ++i)
+	{
+		uint64_t d = (uint64_t)r[i] - b[i] - borrow;
+		r[i] = (uint32_t)d;
+		borrow = (d >> 32) & 1;
+	}
+	for (; borrow && i < r_len; ++i)
+	{
+		borrow = r[i] == 0;
+		r[i] -= 1;
+	}
+}
 
-	// Base2^15 to Base2^32
-	for (uint32_t i = 0; i < expand_len; ++i)
+// r[0, a_len + b_len) = a * b, one row per limb of 'b'.
+static void d_mul_schoolbook(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r)
+{
+	memset(r, 0, a_len * sizeof(uint32_t));
+	for (uint32_t j = 0; j < b_len; ++j)
+		r[a_len + j] = limbs_addmul_1(r + j, a, a_len, b[j]);
+}
+
+// Limbs of scratch d_mul_karatsuba() needs for n-limb operands.
+static size_t karatsuba_scratch_len(uint32_t n)
+{
+	size_t len = 0;
+	while (n >= mul_config.karatsuba_threshold)
 	{
-		printf("%08x ", expand_a[i]);
-	}printf("\n");
+		uint32_t l = (n + 1) / 2;
+		len += 4 * (size_t)(l + 1);
+		n = l + 1;
+	}
+	return len;
 }
 
-// Vertical calculation O(n^2)
-// r's max length = the longest.
-void d_div(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r)
+/*
+*  r[0, 2n) = a[0, n) * b[0, n). With a = a0 + a1 * B^l, the middle term
+*  a0 * b1 + a1 * b0 = (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1 costs one product instead of two.
+*/
+static void d_mul_karatsuba(const uint32_t *a, const uint32_t *b, uint32_t n, uint32_t *r, uint32_t *scratch)
+{
+	if (n < mul_config.karatsuba_threshold)
+	{
+		d_mul_schoolbook(a, n, b, n, r);
+		return;
+	}
+
+	uint32_t l = (n + 1) / 2, h = n - l;
+	uint32_t *sa = scratch, *sb = scratch + l + 1, *z1 = scratch + 2 * (l + 1), *next = z1 + 2 * (l + 1);
+
+	sa[l] = limbs_add(sa, a, l, a + l, h);
+	sb[l] = limbs_add(sb, b, l, b + l, h);
+	d_mul_karatsuba(sa, sb, l + 1, z1, next);
+	d_mul_karatsuba(a, b, l, r, next);
+	d_mul_karatsuba(a + l, b + l, h, r + 2 * l, next);
+
+	limbs_sub_from(z1, 2 * (l + 1), r, 2 * l);
+	limbs_sub_from(z1, 2 * (l + 1), r + 2 * l, 2 * h);
+	// The middle term is below B^(l + h + 1), its top limbs past the end of 'r' are zero.
+	uint32_t z1_len = 2 * (l + 1) < 2 * n - l ? 2 * (l + 1) : 2 * n - l;
+	limbs_add_to(r + l, 2 * n - l, z1, z1_len);
+}
+
+// One plan per prime for products up to 'r_len' limbs, four-step ones when the transforms are
+// split across threads.
+static Status ntt_plans_new(NttPlan *plans[NTT_PRIME_COUNT], size_t r_len, uint32_t threads)
+{
+	uint32_t len = 1;
+	while (len < r_len)
+		len <<= 1;
+
+	for (uint32_t k = 0; k < NTT_PRIME_COUNT; ++k)
+	{
+		bool four_step = len >= (1u << NTT_FOUR_STEP_LOG) || threads > 1;
+		plans[k] = four_step ? new_NttPlan_four_step(len, k) : new_NttPlan(len, k);
+		if (plans[k] == MEMORY_ALLOCATE_FAILED)
+		{
+			while (k--)
+				delete_NttPlan(plans[k]);
+			return MEMORY_ALLOCATE_FAILED;
+		}
+	}
+	return SUCCEEDED;
+}
+
+static void ntt_plans_delete(NttPlan *plans[NTT_PRIME_COUNT])
+{
+	for (uint32_t k = 0; k < NTT_PRIME_COUNT; ++k)
+		delete_NttPlan(plans[k]);
+}
+
+/*
+*  The exact product of 32-bit limbs: the NTT mod three primes, then Garner's CRT
+*  x = x0 + p0 * v1 + p0 * p1 * v2 per coefficient, carried out into the limbs.
+*  The plans are at least a_len + b_len long, the transforms run on up to 'threads' threads.
+*/
+static Status d_mul_ntt(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r,
+	NttPlan *const plans[NTT_PRIME_COUNT], uint32_t threads)
+{
+	size_t r_len = (size_t)a_len + b_len;
+	uint32_t len = plans[0]->len;
+
+	uint32_t *fa = (uint32_t *)malloc((size_t)len * 2 * sizeof(uint32_t));
+	uint32_t *x = (uint32_t *)malloc(r_len * NTT_PRIME_COUNT * sizeof(uint32_t));
+	if (!fa || !x)
+	{
+		free(fa);
+		free(x);
+		return MEMORY_ALLOCATE_FAILED;
+	}
+	uint32_t *fb = fa + len;
+
+	for (uint32_t k = 0; k < NTT_PRIME_COUNT; ++k)
+	{
+		// The primes are above 2^32 / 3, two subtractions reduce a limb.
+		const uint32_t p = plans[k]->p;
+		for (uint32_t i = 0; i < a_len; ++i)
+		{
+			uint32_t d = a[i] >= p ? a[i] - p : a[i];
+			fa[i] = d >= p ? d - p : d;
+		}
+		memset(fa + a_len, 0, (len - a_len) * sizeof(uint32_t));
+		for (uint32_t i = 0; i < b_len; ++i)
+		{
+			uint32_t d = b[i] >= p ? b[i] - p : b[i];
+			fb[i] = d >= p ? d - p : d;
+		}
+		memset(fb + b_len, 0, (len - b_len) * sizeof(uint32_t));
+
+		ntt_execute_parallel(plans[k], fa, false, threads);
+		ntt_execute_parallel(plans[k], fb, false, threads);
+		ntt_mul(plans[k], fa, fb);
+		ntt_execute_parallel(plans[k], fa, true, threads);
+
+		memcpy(x + k * r_len, fa, r_len * sizeof(uint32_t));
+	}
+
+	const uint64_t p0 = NTT_P0, p1 = NTT_P1, p2 = NTT_P2;
+	const uint64_t inv_p0 = quick_power_mod(p0, p1 - 2, p1);               // 1 / p0 (mod p1)
+	const uint64_t inv_p0p1 = quick_power_mod(p0 * p1 % p2, p2 - 2, p2);   // 1 / (p0 * p1) (mod p2)
+	const uint32_t *x0 = x, *x1 = x + r_len, *x2 = x + 2 * r_len;
+	uint128_t c = 0;
+	for (size_t i = 0; i < r_len; ++i)
+	{
+		uint64_t v1 = (x1[i] + p1 - x0[i] % p1) % p1 * inv_p0 % p1;
+		uint64_t s = (x0[i] + p0 % p2 * v1) % p2;
+		uint64_t v2 = (x2[i] + p2 - s) % p2 * inv_p0p1 % p2;
+		c += x0[i] + (uint128_t)p0 * v1 + (uint128_t)(p0 * p1) * v2;
+		r[i] = (uint32_t)c;
+		c >>= 32;
+	}
+
+	free(fa);
+	free(x);
+	return SUCCEEDED;
+}
+
+static Status d_mul_threads(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r,
+	uint32_t threads)
 {
+	// 'a' is the longer one.
+	if (a_len < b_len)
+	{
+		const uint32_t *t = a; a = b; b = t;
+		uint32_t t_len = a_len; a_len = b_len; b_len = t_len;
+	}
+
+	if (b_len < mul_config.karatsuba_threshold)
+	{
+		d_mul_schoolbook(a, a_len, b, b_len, r);
+		return SUCCEEDED;
+	}
+	bool ntt_pieces = b_len >= mul_config.ntt_threshold && 2 * (size_t)b_len <= NTT_MAX_TOTAL_LIMBS;
+	NttPlan *plans[NTT_PRIME_COUNT];
+	Status status = SUCCEEDED;
+	if (ntt_pieces && (size_t)a_len + b_len <= NTT_MAX_TOTAL_LIMBS)
+	{
+		if ((status = ntt_plans_new(plans, (size_t)a_len + b_len, threads)) == SUCCEEDED)
+		{
+			status = d_mul_ntt(a, a_len, b, b_len, r, plans, threads);
+			ntt_plans_delete(plans);
+		}
+		return status;
+	}
 
+	// Pieces of 'a' summed into 'r', as long as 'b' for Karatsuba or as long as the NTT takes,
+	// the pieces share the plans. One allocation holds all the scratch.
+	uint32_t step = ntt_pieces ? (uint32_t)(NTT_MAX_TOTAL_LIMBS - b_len) : b_len;
+	size_t scratch_len = ntt_pieces ? 0 : karatsuba_scratch_len(b_len);
+	if (ntt_pieces && ntt_plans_new(plans, NTT_MAX_TOTAL_LIMBS, threads) != SUCCEEDED)
+		return MEMORY_ALLOCATE_FAILED;
+	uint32_t *scratch = (uint32_t *)malloc((scratch_len + (size_t)step + b_len) * sizeof(uint32_t));
+	if (!scratch)
+	{
+		if (ntt_pieces)
+			ntt_plans_delete(plans);
+		return MEMORY_ALLOCATE_FAILED;
+	}
+	uint32_t *piece = scratch + scratch_len;
+
+	memset(r, 0, ((size_t)a_len + b_len) * sizeof(uint32_t));
+	for (uint32_t i = 0; i < a_len; i += step)
+	{
+		uint32_t m = a_len - i < step ? a_len - i : step;
+		if (ntt_pieces)
+			status = d_mul_ntt(a + i, m, b, b_len, piece, plans, threads);
+		else if (m == b_len)
+			d_mul_karatsuba(a + i, b, b_len, piece, scratch);
+		else
+			status = d_mul_threads(b, b_len, a + i, m, piece, threads);
+		if (status != SUCCEEDED)
+			break;
+		limbs_add_to(r + i, a_len + b_len - i, piece, m + b_len);
+	}
+
+	if (ntt_pieces)
+		ntt_plans_delete(plans);
+	free(scratch);
+	return status;
+}
+
+Status d_mul(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r)
+{
+	return d_mul_threads(a, a_len, b, b_len, r, 1);
+}
+
+Status d_mul_parallel(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *r,
+	uint32_t threads)
+{
+	if (threads == 0)
+	{
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = cpus > 0 ? (uint32_t)cpus : 1;
+	}
+	if ((a_len < b_len ? a_len : b_len) < mul_config.parallel_threshold)
+		threads = 1;
+	return d_mul_threads(a, a_len, b, b_len, r, threads);
+}
+
+/******************** Division ********************/
+/*
+*  One-limb divisors go through Moller and Granlund's reciprocal, two multiplications per limb
+*  instead of a hardware division. Longer ones use Knuth's Algorithm D, and from
+*  DIV_NEWTON_THRESHOLD limbs on a reciprocal of the divisor from Newton's iteration, so a block
+*  of quotient limbs costs two d_mul calls.
+*/
+#define DIV_NEWTON_THRESHOLD 2048
+#define DIV_RECIP_THRESHOLD  64 // Algorithm D for reciprocals below.
+
+// The limbs without the top zero ones, at least one.
+static uint32_t limbs_len(const uint32_t *a, uint32_t len)
+{
+	while (len > 1 && a[len - 1] == 0)
+		--len;
+	return len;
+}
+
+// -1, 0 or 1 as a[0, a_len) is less than, equal to or greater than b[0, b_len).
+static int limbs_cmp(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len)
+{
+	a_len = limbs_len(a, a_len);
+	b_len = limbs_len(b, b_len);
+	if (a_len != b_len)
+		return a_len < b_len ? -1 : 1;
+	for (uint32_t i = a_len; i-- > 0;)
+		if (a[i] != b[i])
+			return a[i] < b[i] ? -1 : 1;
+	return 0;
+}
+
+// r[0, n) = a << s, 0 <= s < 32, returns the bits shifted out.
+static uint32_t limbs_lshift(uint32_t *r, const uint32_t *a, uint32_t n, uint32_t s)
+{
+	if (s == 0)
+	{
+		memmove(r, a, n * sizeof(uint32_t));
+		return 0;
+	}
+	uint32_t out = a[n - 1] >> (32 - s);
+	for (uint32_t i = n - 1; i > 0; --i)
+		r[i] = a[i] << s | a[i - 1] >> (32 - s);
+	r[0] = a[0] << s;
+	return out;
+}
+
+// r[0, n) = a >> s, 0 <= s < 32.
+static void limbs_rshift(uint32_t *r, const uint32_t *a, uint32_t n, uint32_t s)
+{
+	if (s == 0)
+	{
+		memmove(r, a, n * sizeof(uint32_t));
+		return;
+	}
+	for (uint32_t i = 0; i + 1 < n; ++i)
+		r[i] = a[i] >> s | a[i + 1] << (32 - s);
+	r[n - 1] = a[n - 1] >> s;
+}
+
+void limb_divisor_init(LimbDivisor *d, uint32_t divisor)
+{
+	d->shift = (uint32_t)__builtin_clz(divisor);
+	d->d = divisor << d->shift;
+	d->v = (uint32_t)(UINT64_MAX / d->d - ((uint64_t)1 << 32)); // floor((B^2 - 1) / d) - B.
+}
+
+// (u1, u0) / d for a normalized 'd' and u1 < d, the remainder goes to 'r'.
+static inline uint32_t div_2by1(uint32_t u1, uint32_t u0, uint32_t d, uint32_t v, uint32_t *r)
+{
+	// (q1, q0) = v * u1 + (u1 + 1, u0), q1 is the quotient or one above it.
+	uint64_t q = (uint64_t)v * u1 + ((uint64_t)u1 << 32 | u0) + ((uint64_t)1 << 32);
+	uint32_t q1 = (uint32_t)(q >> 32), q0 = (uint32_t)q;
+	uint32_t rem = u0 - q1 * d;
+	uint32_t mask = 0 - (uint32_t)(rem > q0);
+	q1 += mask;
+	rem += d & mask;
+	if (rem >= d) // Rare.
+	{
+		++q1;
+		rem -= d;
+	}
+	*r = rem;
+	return q1;
+}
+
+uint32_t d_div_1(const uint32_t *a, uint32_t len, const LimbDivisor *d, uint32_t *q)
+{
+	const uint32_t s = d->shift;
+	uint32_t r = 0;
+
+	if (len == 0)
+		return 0;
+	if (s == 0)
+	{
+		for (uint32_t i = len; i-- > 0;)
+		{
+			uint32_t qi = div_2by1(r, a[i], d->d, d->v, &r);
+			if (q)
+				q[i] = qi;
+		}
+		return r;
+	}
+
+	// Divide a << s by d << s, shifting the limbs on the way.
+	r = a[len - 1] >> (32 - s);
+	for (uint32_t i = len; i-- > 0;)
+	{
+		uint32_t u0 = a[i] << s | (i ? a[i - 1] >> (32 - s) : 0);
+		uint32_t qi = div_2by1(r, u0, d->d, d->v, &r);
+		if (q)
+			q[i] = qi;
+	}
+	return r >> s;
+}
+
+// r[0, n) -= a[0, n) * b, returns the borrow limb.
+static inline uint32_t limbs_submul_1(uint32_t *r, const uint32_t *a, uint32_t n, uint32_t b)
+{
+	uint64_t c = 0;
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		c += (uint64_t)a[i] * b;
+		uint32_t lo = (uint32_t)c;
+		c >>= 32;
+		c += r[i] < lo;
+		r[i] -= lo;
+	}
+	return (uint32_t)c;
+}
+
+// Algorithm D: q[0, u_len - n) = u / v for a normalized 'v' of n >= 2 limbs, u[u_len - 1] < v[n - 1].
+// The remainder is left in u[0, n).
+static void d_div_knuth(uint32_t *u, uint32_t u_len, const uint32_t *v, uint32_t n, uint32_t *q)
+{
+	const uint32_t v1 = v[n - 1], v2 = v[n - 2];
+	LimbDivisor top;
+	limb_divisor_init(&top, v1);
+
+	for (uint32_t j = u_len - n; j-- > 0;)
+	{
+		uint32_t *w = u + j;
+		uint32_t u2 = w[n], u1 = w[n - 1], u0 = w[n - 2];
+		uint32_t qhat, r;
+		uint64_t rhat;
+
+		// Estimate from the top two limbs, then fix it with the next one: at most two too big.
+		if (u2 >= v1)
+		{
+			qhat = UINT32_MAX;
+			rhat = (uint64_t)u1 + v1;
+		}
+		else
+		{
+			qhat = div_2by1(u2, u1, v1, top.v, &r);
+			rhat = r;
+		}
+		while (rhat >> 32 == 0 && (uint64_t)qhat * v2 > (rhat << 32 | u0))
+		{
+			--qhat;
+			rhat += v1;
+		}
+
+		// w[0, n] -= qhat * v, went below zero if qhat was one too big: add 'v' back.
+		uint32_t c = limbs_submul_1(w, v, n, qhat);
+		uint32_t top = w[n];
+		w[n] = top - c;
+		if (top < c)
+		{
+			--qhat;
+			w[n] += limbs_add(w, w, n, v, n);
+		}
+		q[j] = qhat;
+	}
+}
+
+// r[0, a_len + n + 1) = a * x[0, n + 1) for a reciprocal from d_recip, its top limb a small one.
+// The low limbs alone keep the product at a_len + n limbs, a length the NTT takes without doubling.
+static Status d_mul_recip(const uint32_t *a, uint32_t a_len, const uint32_t *x, uint32_t n, uint32_t *r)
+{
+	Status status = d_mul(a, a_len, x, n, r);
+	if (status != SUCCEEDED)
+		return status;
+	r[a_len + n] = limbs_addmul_1(r + n, a, a_len, x[n]);
+	return SUCCEEDED;
+}
+
+// x[0, n + 1) = floor((B^(2n) - 1) / v) for a normalized 'v' of n >= 2 limbs, B^n <= x < 2 B^n.
+static Status d_recip(const uint32_t *v, uint32_t n, uint32_t *x)
+{
+	Status status;
+
+	if (n < DIV_RECIP_THRESHOLD)
+	{
+		uint32_t *u = (uint32_t *)malloc((2 * (size_t)n + 1) * sizeof(uint32_t));
+		if (!u)
+			return MEMORY_ALLOCATE_FAILED;
+		memset(u, 0xff, 2 * (size_t)n * sizeof(uint32_t));
+		u[2 * n] = 0;
+		d_div_knuth(u, 2 * n + 1, v, n, x);
+		free(u);
+		return SUCCEEDED;
+	}
+
+	// The top h limbs give x0 = y * B^l with y = recip(v_hi), good to about h limbs. One Newton
+	// step, x1 = x0 + x0 * e / B^(2n) with e = B^(2n) - v * x0, doubles that, and a few units are
+	// left to fix. |e| < 2 B^(n + l), and its limbs below B^(n - 1) don't reach x1.
+	const uint32_t h = (n + 1) / 2, l = n - h;
+	uint32_t *p = (uint32_t *)malloc(((2 * (size_t)n + 1) + ((size_t)n + 3)) * sizeof(uint32_t));
+	if (!p)
+		return MEMORY_ALLOCATE_FAILED;
+	uint32_t *t = p + 2 * n + 1, *y = x + l;
+
+	memset(x, 0, l * sizeof(uint32_t));
+	if ((status = d_recip(v + l, h, y)) != SUCCEEDED)
+		goto end;
+
+	// p = v * y * B^l, just below B^(2n) or at most p[2n] = 1 above it.
+	memset(p, 0, l * sizeof(uint32_t));
+	if ((status = d_mul_recip(v, n, y, h, p + l)) != SUCCEEDED)
+		goto end;
+	bool over = p[2 * n] != 0;
+	if (!over)
+	{
+		// p = B^(2n) - p.
+		for (uint32_t i = 0; i < 2 * n; ++i)
+			p[i] = ~p[i];
+		uint32_t one = 1;
+		limbs_add_to(p, 2 * n, &one, 1);
+	}
+
+	// x0 * e / B^(2n) = y * e / B^(2n - l), from the l + 2 limbs of 'e' at B^(n - 1).
+	if ((status = d_mul_recip(p + n - 1, l + 2, y, h, t)) != SUCCEEDED)
+		goto end;
+	if (over)
+		limbs_sub_from(x, n + 1, t + h + 1, l + 2);
+	else
+		limbs_add_to(x, n + 1, t + h + 1, l + 2);
+
+	// Exact: step down while v * x > B^(2n) - 1, then up while v * (x + 1) <= B^(2n) - 1.
+	if ((status = d_mul_recip(v, n, x, n, p)) != SUCCEEDED)
+		goto end;
+	uint32_t one = 1;
+	while (p[2 * n])
+	{
+		limbs_sub_from(x, n + 1, &one, 1);
+		limbs_sub_from(p, 2 * n + 1, v, n);
+	}
+	for (uint32_t i = 0; i < 2 * n; ++i)
+		p[i] = ~p[i];
+	while (limbs_cmp(p, 2 * n, v, n) >= 0)
+	{
+		limbs_add_to(x, n + 1, &one, 1);
+		limbs_sub_from(p, 2 * n, v, n);
+	}
+end:
+	free(p);
+	return status;
+}
+
+// d_div_knuth by a reciprocal, n quotient limbs at a time. A block 'w' of 2n limbs is below v * B^n,
+// and with x = recip(v) the estimate from its top n + 1 limbs, w_hi * x / B^(n + 1), is the quotient
+// or a little below it, the correction loop adds the rest. A short last block goes through
+// Algorithm D instead.
+static Status d_div_newton(uint32_t *u, uint32_t u_len, const uint32_t *v, uint32_t n, uint32_t *q)
+{
+	Status status;
+	uint32_t *x = (uint32_t *)malloc(((n + 1) + 2 * (size_t)n + (2 * (size_t)n + 2) + 2 * (size_t)n)
+		* sizeof(uint32_t));
+	if (!x)
+		return MEMORY_ALLOCATE_FAILED;
+	uint32_t *w = x + n + 1, *p = w + 2 * n, *t = p + 2 * n + 2;
+
+	if ((status = d_recip(v, n, x)) != SUCCEEDED)
+		goto end;
+
+	for (uint32_t end = u_len - n; end > 0;)
+	{
+		uint32_t c = end < n ? end : n, j = end - c;
+		uint32_t *qh = p + n + 1;
+
+		if (c < n / 16)
+		{
+			d_div_knuth(u + j, n + c, v, n, q + j);
+			break;
+		}
+		memcpy(w, u + j, (n + c) * sizeof(uint32_t));
+		memset(w + n + c, 0, (n - c) * sizeof(uint32_t));
+		if ((status = d_mul_recip(w + n - 1, n + 1, x, n, p)) != SUCCEEDED)
+			goto end;
+		if ((status = d_mul(qh, n, v, n, t)) != SUCCEEDED) // The quotient is below B^n.
+			goto end;
+		limbs_sub_from(w, 2 * n, t, 2 * n);
+		while (limbs_cmp(w, 2 * n, v, n) >= 0)
+		{
+			uint32_t one = 1;
+			limbs_sub_from(w, 2 * n, v, n);
+			limbs_add_to(qh, n + 1, &one, 1);
+		}
+		memcpy(q + j, qh, c * sizeof(uint32_t));
+		memcpy(u + j, w, n * sizeof(uint32_t));
+		memset(u + j + n, 0, c * sizeof(uint32_t));
+		end = j;
+	}
+end:
+	free(x);
+	return status;
+}
+
+Status d_div(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len, uint32_t *q, uint32_t *r)
+{
+	b_len = b_len ? limbs_len(b, b_len) : 0;
+	if (b_len == 0 || b[b_len - 1] == 0)
+		return BIGINT_DIVIDE_BY_ZERO;
+
+	if (a_len < b_len)
+	{
+		if (q)
+			q[0] = 0;
+		if (r)
+		{
+			memcpy(r, a, a_len * sizeof(uint32_t));
+			memset(r + a_len, 0, (b_len - a_len) * sizeof(uint32_t));
+		}
+		return SUCCEEDED;
+	}
+
+	if (b_len == 1)
+	{
+		LimbDivisor d;
+		limb_divisor_init(&d, b[0]);
+		uint32_t rem = d_div_1(a, a_len, &d, q);
+		if (r)
+			r[0] = rem;
+		return SUCCEEDED;
+	}
+
+	// Normalize so the top bit of the divisor is set, the dividend grows by a limb.
+	const uint32_t s = (uint32_t)__builtin_clz(b[b_len - 1]), q_len = a_len - b_len + 1;
+	uint32_t *vn = (uint32_t *)malloc(((size_t)b_len + a_len + 1 + (q ? 0 : q_len)) * sizeof(uint32_t));
+	if (!vn)
+		return MEMORY_ALLOCATE_FAILED;
+	uint32_t *un = vn + b_len, *qt = q ? q : un + a_len + 1;
+	limbs_lshift(vn, b, b_len, s);
+	un[a_len] = limbs_lshift(un, a, a_len, s);
+
+	Status status = SUCCEEDED;
+	if (b_len < DIV_NEWTON_THRESHOLD || q_len < DIV_NEWTON_THRESHOLD / 2)
+		d_div_knuth(un, a_len + 1, vn, b_len, qt);
+	else
+		status = d_div_newton(un, a_len + 1, vn, b_len, qt);
+
+	if (status == SUCCEEDED && r)
+		limbs_rshift(r, un, b_len, s);
+	free(vn);
+	return status;
 }
 
 int8_t d_equal(const uint32_t *a, uint32_t a_len, const uint32_t *b, uint32_t b_len)
@@ -175,7 +814,7 @@ Bigint * new_Bigint()
 
 void delete_Bigint(Bigint *self)
 {
-	if (!(self->d))
+	if (self->d)
 		free(self->d);
 	free(self);
 }
@@ -187,40 +826,41 @@ Bigint * Bigint_set_bytearr(byte *arr, size_t len, bool neg)
 		return MEMORY_ALLOCATE_FAILED;
 
 	// Strip the ending 0x00, and get the real length.
-	size_t stripped_len;
-	byte *stripped = (byte *)rsrtip((const byte *)arr, len, &stripped_len);
-	if (stripped == MEMORY_ALLOCATE_FAILED)
-		return MEMORY_ALLOCATE_FAILED;
+	while (len > 0 && arr[len-1] == 0x00)
+		--len;
 
-	// Set bn->len and bn->neg.
-	bn->len = stripped_len%8 ? stripped_len/8+1 : stripped_len/8;
+	// Set bn->len and bn->neg, zero keeps one digit.
+	bn->len = len ? base2p8_to_base2p32(arr, len, NULL) : 1;
 	bn->neg = neg;
 
-	// Byte array all zero.
-	if (stripped == BYTEARRAY_ALL_ZERO)
+	bn->d = (uint32_t *)malloc(bn->len * sizeof(uint32_t));
+	if (!(bn->d))
 	{
-		bn->d = (uint32_t *)calloc(1, sizeof(uint32_t));
-		if (!(bn->d))
-		{
-			free(stripped);
-			return MEMORY_ALLOCATE_FAILED;
-		}
+		free(bn);
+		return MEMORY_ALLOCATE_FAILED;
 	}
-	else
+	bn->d[0] = 0;
+	base2p8_to_base2p32(arr, len, bn->d);
+
+	return bn;
+}
+
+// A new Bigint of the limbs without the top zero ones, zero isn't negative.
+static Bigint * Bigint_from_limbs(const uint32_t *d, uint32_t len, bool neg)
+{
+	Bigint *bn = new_Bigint();
+	if (bn == MEMORY_ALLOCATE_FAILED)
+		return MEMORY_ALLOCATE_FAILED;
+
+	bn->len = limbs_len(d, len);
+	bn->d = (uint32_t *)malloc(bn->len * sizeof(uint32_t));
+	if (!(bn->d))
 	{
-		bn->d = (uint32_t *)calloc(bn->len, sizeof(uint32_t));
-		if (!(bn->d))
-		{
-			free(stripped);
-			return MEMORY_ALLOCATE_FAILED;
-		}
-		for (size_t i = 0; i < stripped_len; ++i)
-		{
-			(bn->d)[i/4] |= stripped[i];
-			if ((i+1)%4)
-				(bn->d)[i/4] <<= 8;
-		}
+		free(bn);
+		return MEMORY_ALLOCATE_FAILED;
 	}
+	memcpy(bn->d, d, bn->len * sizeof(uint32_t));
+	bn->neg = neg && !(bn->len == 1 && bn->d[0] == 0);
 	return bn;
 }
 
@@ -238,4 +878,640 @@ Bigint * Bigint_add(Bigint *a, Bigint *b)
 	// Strip the ending 0 in bn->d and reset bn->len.
 
 	return bn;
-}
\ No newline at end of file
+}
+
+static Bigint * Bigint_mul_threads(Bigint *a, Bigint *b, uint32_t threads)
+{
+	Bigint *bn = new_Bigint();
+	if (bn == MEMORY_ALLOCATE_FAILED)
+		return MEMORY_ALLOCATE_FAILED;
+
+	bn->len = a->len + b->len;
+	bn->d = (uint32_t *)malloc(bn->len * sizeof(uint32_t));
+	if (!(bn->d) || d_mul_parallel(a->d, a->len, b->d, b->len, bn->d, threads) != SUCCEEDED)
+	{
+		delete_Bigint(bn);
+		return MEMORY_ALLOCATE_FAILED;
+	}
+
+	// Strip the ending 0 in bn->d and reset bn->len.
+	while (bn->len > 1 && bn->d[bn->len - 1] == 0)
+		--bn->len;
+	bn->neg = (a->neg != b->neg) && !(bn->len == 1 && bn->d[0] == 0);
+
+	return bn;
+}
+
+Bigint * Bigint_mul(Bigint *a, Bigint *b)
+{
+	return Bigint_mul_threads(a, b, 1);
+}
+
+Bigint * Bigint_mul_parallel(Bigint *a, Bigint *b, uint32_t threads)
+{
+	return Bigint_mul_threads(a, b, threads);
+}
+
+
+Bigint * Bigint_div(Bigint *a, Bigint *b)
+{
+	uint32_t b_len = limbs_len(b->d, b->len), a_len = limbs_len(a->d, a->len);
+	if (b->d[b_len - 1] == 0)
+		return BIGINT_DIVIDE_BY_ZERO;
+
+	uint32_t q_len = a_len < b_len ? 1 : a_len - b_len + 1;
+	uint32_t *q = (uint32_t *)malloc(q_len * sizeof(uint32_t));
+	if (!q)
+		return MEMORY_ALLOCATE_FAILED;
+	Bigint *bn = MEMORY_ALLOCATE_FAILED;
+	if (d_div(a->d, a_len, b->d, b_len, q, NULL) == SUCCEEDED)
+		bn = Bigint_from_limbs(q, q_len, a->neg != b->neg);
+	free(q);
+	return bn;
+}
+
+/******************** Modular exponentiation and inversion ********************/
+/*
+*  Montgomery arithmetic mod an odd 'm' of 'n' 64-bit limbs with R = 2^(64n): a residue x is
+*  kept as x * R (mod m), so products need no division. No branch or memory access depends on
+*  the residues.
+*/
+typedef struct mont_st Mont;
+struct mont_st {
+	uint64_t *m;
+	uint32_t n;
+	uint64_t m_inv; // -1 / m (mod 2^64).
+	uint64_t *r2;   // R^2 (mod m).
+	uint64_t *one;  // R (mod m), 1 in Montgomery form.
+	uint64_t *unit; // 1.
+	uint64_t *x;    // n limbs of scratch.
+	uint64_t *t;    // n + 2 limbs of scratch.
+};
+
+// 32-bit limbs to n 64-bit ones, zero past a_len.
+static void limbs_to_64(uint64_t *r, uint32_t n, const uint32_t *a, uint32_t a_len)
+{
+	for (uint32_t j = 0; j < n; ++j)
+		r[j] = (2 * j < a_len ? a[2 * j] : 0) | (uint64_t)(2 * j + 1 < a_len ? a[2 * j + 1] : 0) << 32;
+}
+
+static void limbs_from_64(uint32_t *r, uint32_t r_len, const uint64_t *a)
+{
+	for (uint32_t j = 0; j < r_len; ++j)
+		r[j] = (uint32_t)(a[j / 2] >> (j % 2 * 32));
+}
+
+// r = top:t - m when that doesn't borrow, else t. 'r' must not overlap 't'.
+static void limbs_csub(uint64_t *r, const uint64_t *t, uint64_t top, const uint64_t *m, uint32_t n)
+{
+	uint64_t borrow = 0;
+	for (uint32_t j = 0; j < n; ++j)
+	{
+		uint128_t d = (uint128_t)t[j] - m[j] - borrow;
+		r[j] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	uint64_t keep = 0 - (uint64_t)(top < borrow);
+	for (uint32_t j = 0; j < n; ++j)
+		r[j] = (t[j] & keep) | (r[j] & ~keep);
+}
+
+// r = a + b (mod m), 'r' may alias the inputs.
+static void mod_add(const Mont *ctx, uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+	uint128_t c = 0;
+	for (uint32_t j = 0; j < ctx->n; ++j)
+	{
+		c += (uint128_t)a[j] + b[j];
+		ctx->t[j] = (uint64_t)c;
+		c >>= 64;
+	}
+	limbs_csub(r, ctx->t, (uint64_t)c, ctx->m, ctx->n);
+}
+
+// r = a - b (mod m), 'r' may alias the inputs.
+static void mod_sub(const Mont *ctx, uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+	uint64_t borrow = 0;
+	uint128_t c = 0;
+	for (uint32_t j = 0; j < ctx->n; ++j)
+	{
+		uint128_t d = (uint128_t)a[j] - b[j] - borrow;
+		r[j] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	uint64_t add = 0 - borrow;
+	for (uint32_t j = 0; j < ctx->n; ++j)
+	{
+		c += (uint128_t)r[j] + (ctx->m[j] & add);
+		r[j] = (uint64_t)c;
+		c >>= 64;
+	}
+}
+
+// r = a * b / R (mod m) by CIOS, 'a' below R and 'b' below m. 'r' may alias the inputs.
+static void mont_mul(const Mont *ctx, uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+	const uint64_t *m = ctx->m;
+	const uint32_t n = ctx->n;
+	uint64_t *t = ctx->t;
+
+	memset(t, 0, (n + 2) * sizeof(uint64_t));
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		uint128_t c = 0;
+		for (uint32_t j = 0; j < n; ++j)
+		{
+			c += t[j] + (uint128_t)a[j] * b[i];
+			t[j] = (uint64_t)c;
+			c >>= 64;
+		}
+		c += t[n];
+		t[n] = (uint64_t)c;
+		t[n + 1] = (uint64_t)(c >> 64);
+
+		// Add q * m to clear the lowest limb, then shift it out.
+		uint64_t q = t[0] * ctx->m_inv;
+		c = (t[0] + (uint128_t)q * m[0]) >> 64;
+		for (uint32_t j = 1; j < n; ++j)
+		{
+			c += t[j] + (uint128_t)q * m[j];
+			t[j - 1] = (uint64_t)c;
+			c >>= 64;
+		}
+		c += t[n];
+		t[n - 1] = (uint64_t)c;
+		t[n] = t[n + 1] + (uint64_t)(c >> 64);
+	}
+	// t < 2m.
+	limbs_csub(r, t, t[n], m, n);
+}
+
+static void delete_Mont(Mont *ctx)
+{
+	free(ctx->m);
+}
+
+/** Set up the arithmetic mod an odd m > 1 of m_len 32-bit limbs, the top one nonzero.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+static Status new_Mont(Mont *ctx, const uint32_t *m, uint32_t m_len)
+{
+	const uint32_t n = (m_len + 1) / 2;
+	uint64_t *buf = (uint64_t *)calloc(6 * (size_t)n + 2, sizeof(uint64_t));
+	if (!buf)
+		return MEMORY_ALLOCATE_FAILED;
+	ctx->m = buf;
+	ctx->n = n;
+	ctx->r2 = buf + n;
+	ctx->one = buf + 2 * n;
+	ctx->unit = buf + 3 * n;
+	ctx->x = buf + 4 * n;
+	ctx->t = buf + 5 * n;
+	limbs_to_64(ctx->m, n, m, m_len);
+
+	// Newton's iteration doubles the correct low bits, m * m = 1 (mod 8) to start.
+	uint64_t inv = ctx->m[0];
+	for (uint8_t i = 0; i < 5; ++i)
+		inv *= 2 - ctx->m[0] * inv;
+	ctx->m_inv = 0 - inv;
+
+	// R from 2^(64(n - 1)) < m by doubling, then R^2 = 2^(64n) in Montgomery form by
+	// square-and-multiply from 2R.
+	ctx->unit[0] = 1;
+	ctx->one[n - 1] = 1;
+	for (uint8_t i = 0; i < 64; ++i)
+		mod_add(ctx, ctx->one, ctx->one, ctx->one);
+	mod_add(ctx, ctx->x, ctx->one, ctx->one);
+	memcpy(ctx->r2, ctx->one, n * sizeof(uint64_t));
+	uint64_t bits = (uint64_t)n * 64;
+	for (int8_t i = 63 - __builtin_clzll(bits); i >= 0; --i)
+	{
+		mont_mul(ctx, ctx->r2, ctx->r2, ctx->r2);
+		if (bits >> i & 1)
+			mont_mul(ctx, ctx->r2, ctx->r2, ctx->x);
+	}
+	return SUCCEEDED;
+}
+
+// r = a * R (mod m) of any length, Horner's rule on n-limb chunks: one R per chunk.
+static void mont_set(const Mont *ctx, uint64_t *r, const uint32_t *a, uint32_t a_len)
+{
+	const uint32_t n = ctx->n;
+
+	memset(r, 0, n * sizeof(uint64_t));
+	for (uint32_t k = (a_len + 2 * n - 1) / (2 * n); k-- > 0; )
+	{
+		mont_mul(ctx, r, r, ctx->r2);
+		limbs_to_64(ctx->x, n, a + (size_t)k * 2 * n, a_len - k * 2 * n);
+		mont_mul(ctx, ctx->x, ctx->x, ctx->r2);
+		mod_add(ctx, r, r, ctx->x);
+	}
+}
+
+// Bits [i, i + w) of 'e', w <= 32, zero past the end.
+static inline uint32_t exp_bits(const uint32_t *e, uint32_t e_len, size_t i, uint32_t w)
+{
+	size_t k = i / 32;
+	uint64_t v = k < e_len ? e[k] : 0;
+	if (k + 1 < e_len)
+		v |= (uint64_t)e[k + 1] << 32;
+	return (uint32_t)(v >> (i % 32)) & (uint32_t)(((uint64_t)1 << w) - 1);
+}
+
+// Window width for 'bits' exponent bits, the one that needs the fewest products.
+static uint32_t pow_window(size_t bits)
+{
+	return bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : 1;
+}
+
+/** r = x^e in Montgomery form, a sliding window: squarings over the zero bits and one product
+*   with x^1, x^3, ..., x^(2^w - 1) per window of at most w bits ending in a one.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+static Status mont_pow(const Mont *ctx, uint64_t *r, const uint64_t *x, const uint32_t *e, uint32_t e_len)
+{
+	const uint32_t n = ctx->n;
+	size_t bits = (size_t)e_len * 32;
+	while (bits > 0 && exp_bits(e, e_len, bits - 1, 1) == 0)
+		--bits;
+	uint32_t w = pow_window(bits);
+
+	uint64_t *table = (uint64_t *)malloc(((size_t)1 << (w - 1)) * n * sizeof(uint64_t));
+	if (!table)
+		return MEMORY_ALLOCATE_FAILED;
+	memcpy(table, x, n * sizeof(uint64_t));
+	mont_mul(ctx, r, x, x);
+	for (size_t k = 1; k < ((size_t)1 << (w - 1)); ++k)
+		mont_mul(ctx, table + k * n, table + (k - 1) * n, r);
+
+	memcpy(r, ctx->one, n * sizeof(uint64_t));
+	for (size_t i = bits; i > 0; )
+	{
+		if (exp_bits(e, e_len, i - 1, 1) == 0)
+		{
+			mont_mul(ctx, r, r, r);
+			--i;
+			continue;
+		}
+		size_t j = i > w ? i - w : 0;
+		while (exp_bits(e, e_len, j, 1) == 0)
+			++j;
+		for (size_t k = j; k < i; ++k)
+			mont_mul(ctx, r, r, r);
+		mont_mul(ctx, r, r, table + (size_t)(exp_bits(e, e_len, j, (uint32_t)(i - j)) >> 1) * n);
+		i = j;
+	}
+
+	free(table);
+	return SUCCEEDED;
+}
+
+#define POW_CONSTTIME_WINDOW 4
+
+/** r = x^e in Montgomery form, fixed windows over all e_len * 32 bits: the same squarings and
+*   products whatever 'e' is, and the table entry is picked by reading all of them.
+*   \return SUCCEEDED or MEMORY_ALLOCATE_FAILED.
+**/
+static Status mont_pow_consttime(const Mont *ctx, uint64_t *r, const uint64_t *x, const uint32_t *e, uint32_t e_len)
+{
+	const uint32_t n = ctx->n, entries = 1 << POW_CONSTTIME_WINDOW;
+
+	// x^0 .. x^15, then the selected entry.
+	uint64_t *table = (uint64_t *)malloc(((size_t)entries + 1) * n * sizeof(uint64_t));
+	if (!table)
+		return MEMORY_ALLOCATE_FAILED;
+	uint64_t *sel = table + (size_t)entries * n;
+	memcpy(table, ctx->one, n * sizeof(uint64_t));
+	for (uint32_t k = 1; k < entries; ++k)
+		mont_mul(ctx, table + (size_t)k * n, table + (size_t)(k - 1) * n, x);
+
+	memcpy(r, ctx->one, n * sizeof(uint64_t));
+	for (size_t i = (size_t)e_len * 32; i > 0; i -= POW_CONSTTIME_WINDOW)
+	{
+		for (uint32_t k = 0; k < POW_CONSTTIME_WINDOW; ++k)
+			mont_mul(ctx, r, r, r);
+
+		uint32_t digit = exp_bits(e, e_len, i - POW_CONSTTIME_WINDOW, POW_CONSTTIME_WINDOW);
+		memset(sel, 0, n * sizeof(uint64_t));
+		for (uint32_t k = 0; k < entries; ++k)
+		{
+			uint64_t mask = 0 - (uint64_t)(((k ^ digit) - 1) >> 31);
+			for (uint32_t j = 0; j < n; ++j)
+				sel[j] |= table[(size_t)k * n + j] & mask;
+		}
+		mont_mul(ctx, r, r, sel);
+	}
+
+	free(table);
+	return SUCCEEDED;
+}
+
+/*
+*  Bernstein-Yang safegcd as in libsecp256k1's modinv32, for any length: numbers are signed,
+*  little-endian 30-bit limbs in int32_t, the top limb carries the sign. Every batch of 30
+*  divsteps works on the low limbs only and gives a 2x2 matrix scaled by 2^30, which updates
+*  f, g and d, e = f / x, g / x (mod m). All steps are branchless.
+*/
+#define S30_MASK ((int32_t)(UINT32_MAX >> 2))
+
+typedef struct s30_matrix_st S30Matrix;
+struct s30_matrix_st {
+	int32_t u, v, q, r;
+};
+
+// 30 divsteps on the low bits of f and g, zeta = -(delta + 1/2).
+static int32_t s30_divsteps(int32_t zeta, uint32_t f, uint32_t g, S30Matrix *t)
+{
+	// Signed values in [-2^30, 2^30] as uint32_t, so they can be shifted left.
+	uint32_t u = 1, v = 0, q = 0, r = 1;
+
+	for (uint8_t i = 0; i < 30; ++i)
+	{
+		// zeta < 0 and g odd: swap and negate. g odd: add f. Then halve g.
+		uint32_t c1 = (uint32_t)(zeta >> 31), c2 = 0 - (g & 1);
+		uint32_t x = (f ^ c1) - c1, y = (u ^ c1) - c1, z = (v ^ c1) - c1;
+		g += x & c2;
+		q += y & c2;
+		r += z & c2;
+		c1 &= c2;
+		zeta = (zeta ^ (int32_t)c1) - 1;
+		f += g & c1;
+		u += q & c1;
+		v += r & c1;
+		g >>= 1;
+		u <<= 1;
+		v <<= 1;
+	}
+	*t = (S30Matrix){(int32_t)u, (int32_t)v, (int32_t)q, (int32_t)r};
+	return zeta;
+}
+
+// [f, g] = t * [f, g] / 2^30, exact.
+static void s30_update_fg(int32_t *f, int32_t *g, uint32_t len, const S30Matrix *t)
+{
+	int64_t cf = ((int64_t)t->u * f[0] + (int64_t)t->v * g[0]) >> 30;
+	int64_t cg = ((int64_t)t->q * f[0] + (int64_t)t->r * g[0]) >> 30;
+
+	for (uint32_t i = 1; i < len; ++i)
+	{
+		cf += (int64_t)t->u * f[i] + (int64_t)t->v * g[i];
+		cg += (int64_t)t->q * f[i] + (int64_t)t->r * g[i];
+		f[i - 1] = (int32_t)cf & S30_MASK; cf >>= 30;
+		g[i - 1] = (int32_t)cg & S30_MASK; cg >>= 30;
+	}
+	f[len - 1] = (int32_t)cf;
+	g[len - 1] = (int32_t)cg;
+}
+
+// [d, e] = (t * [d, e] + m * [md, me]) / 2^30, md and me picked to make it exact and keep
+// d and e in (-2m, m).
+static void s30_update_de(int32_t *d, int32_t *e, uint32_t len, const S30Matrix *t, const int32_t *m, uint32_t m_inv)
+{
+	const int32_t u = t->u, v = t->v, q = t->q, r = t->r;
+	int32_t sd = d[len - 1] >> 31, se = e[len - 1] >> 31;
+	int32_t md = (u & sd) + (v & se), me = (q & sd) + (r & se);
+	int64_t cd = (int64_t)u * d[0] + (int64_t)v * e[0];
+	int64_t ce = (int64_t)q * d[0] + (int64_t)r * e[0];
+
+	md -= (int32_t)((m_inv * (uint32_t)cd + (uint32_t)md) & S30_MASK);
+	me -= (int32_t)((m_inv * (uint32_t)ce + (uint32_t)me) & S30_MASK);
+	cd = (cd + (int64_t)m[0] * md) >> 30;
+	ce = (ce + (int64_t)m[0] * me) >> 30;
+	for (uint32_t i = 1; i < len; ++i)
+	{
+		cd += (int64_t)u * d[i] + (int64_t)v * e[i] + (int64_t)m[i] * md;
+		ce += (int64_t)q * d[i] + (int64_t)r * e[i] + (int64_t)m[i] * me;
+		d[i - 1] = (int32_t)cd & S30_MASK; cd >>= 30;
+		e[i - 1] = (int32_t)ce & S30_MASK; ce >>= 30;
+	}
+	d[len - 1] = (int32_t)cd;
+	e[len - 1] = (int32_t)ce;
+}
+
+// d = d + (m & mask), limbs carried back below 2^30.
+static void s30_cadd(int32_t *d, uint32_t len, const int32_t *m, int32_t mask)
+{
+	for (uint32_t i = 0; i < len; ++i)
+		d[i] += m[i] & mask;
+	for (uint32_t i = 0; i + 1 < len; ++i)
+	{
+		d[i + 1] += d[i] >> 30;
+		d[i] &= S30_MASK;
+	}
+}
+
+static void limbs_to_s30(int32_t *r, uint32_t len, const uint32_t *a, uint32_t n)
+{
+	for (uint32_t i = 0; i < len; ++i)
+	{
+		size_t bit = (size_t)i * 30, k = bit / 32;
+		uint64_t v = k < n ? a[k] : 0;
+		if (k + 1 < n)
+			v |= (uint64_t)a[k + 1] << 32;
+		r[i] = (int32_t)(v >> (bit % 32)) & S30_MASK;
+	}
+}
+
+static void limbs_from_s30(uint32_t *r, uint32_t n, const int32_t *a, uint32_t len)
+{
+	uint64_t acc = 0;
+	uint32_t bits = 0, j = 0;
+
+	for (uint32_t i = 0; i < len && j < n; ++i)
+	{
+		acc |= (uint64_t)(uint32_t)a[i] << bits;
+		bits += 30;
+		if (bits >= 32)
+		{
+			r[j++] = (uint32_t)acc;
+			acc >>= 32;
+			bits -= 32;
+		}
+	}
+	while (j < n)
+	{
+		r[j++] = (uint32_t)acc;
+		acc >>= 32;
+	}
+}
+
+/** r = 1 / x (mod m), x below an odd m of n limbs. The divsteps bound of the safegcd paper,
+*   (49d + 57) / 17 for d-bit inputs, sets the batches.
+*   \return SUCCEEDED, MEMORY_ALLOCATE_FAILED or BIGINT_NOT_INVERTIBLE.
+**/
+static Status limbs_modinv(uint32_t *r, const uint32_t *x, const uint32_t *m, uint32_t n)
+{
+	// Room for (-2m, m) and the sign.
+	const uint32_t len = (uint32_t)(((size_t)n * 32 + 2) / 30 + 2);
+	int32_t *buf = (int32_t *)calloc((size_t)len * 5, sizeof(int32_t));
+	if (!buf)
+		return MEMORY_ALLOCATE_FAILED;
+	int32_t *f = buf, *g = buf + len, *d = buf + 2 * len, *e = buf + 3 * len, *ms = buf + 4 * len;
+
+	limbs_to_s30(ms, len, m, n);
+	memcpy(f, ms, len * sizeof(int32_t));
+	limbs_to_s30(g, len, x, n);
+	e[0] = 1;
+
+	uint32_t m_inv = m[0];
+	for (uint8_t i = 0; i < 4; ++i)
+		m_inv *= 2 - m[0] * m_inv;
+	m_inv &= (uint32_t)S30_MASK;
+
+	size_t bits = (size_t)n * 32 - __builtin_clz(m[n - 1]);
+	size_t steps = bits < 46 ? (49 * bits + 80) / 17 + 1 : (49 * bits + 57) / 17 + 1;
+	int32_t zeta = -1;
+	for (size_t i = 0; i < steps; i += 30)
+	{
+		S30Matrix t;
+		zeta = s30_divsteps(zeta, (uint32_t)f[0], (uint32_t)g[0], &t);
+		s30_update_de(d, e, len, &t, ms, m_inv);
+		s30_update_fg(f, g, len, &t);
+	}
+
+	// g is zero, f = +-gcd(m, x) and d = +-1 / x in (-2m, m).
+	bool pos = f[0] == 1 && f[len - 1] == 0, neg = f[0] == S30_MASK && f[len - 1] == -1;
+	for (uint32_t i = 1; i + 1 < len; ++i)
+	{
+		pos &= f[i] == 0;
+		neg &= f[i] == S30_MASK;
+	}
+	int32_t f_neg = f[len - 1] >> 31;
+	Status status = SUCCEEDED;
+	if (pos || neg)
+	{
+		s30_cadd(d, len, ms, d[len - 1] >> 31);
+		for (uint32_t i = 0; i < len; ++i)
+			d[i] = (d[i] ^ f_neg) - f_neg;
+		s30_cadd(d, len, ms, 0);
+		s30_cadd(d, len, ms, d[len - 1] >> 31);
+		limbs_from_s30(r, n, d, len);
+	}
+	else
+		status = BIGINT_NOT_INVERTIBLE;
+
+	free(buf);
+	return status;
+}
+
+// r = a * R (mod m), 'a' may be negative.
+static void mont_set_bigint(const Mont *ctx, uint64_t *r, const Bigint *a)
+{
+	mont_set(ctx, r, a->d, a->len);
+	if (a->neg)
+	{
+		memset(ctx->x, 0, ctx->n * sizeof(uint64_t));
+		mod_sub(ctx, r, ctx->x, r);
+	}
+}
+
+/** Check the modulus and set up its Montgomery arithmetic, with two residues of scratch in 'x'
+*   and the modulus as 32-bit limbs in 'm'.
+*   \return SUCCEEDED, FAILED for a modulus of 1, MEMORY_ALLOCATE_FAILED or BIGINT_INVALID_MODULUS.
+**/
+static Status mod_setup(Mont *ctx, const Bigint *order, uint64_t **x, uint32_t *m_len)
+{
+	*m_len = limbs_len(order->d, order->len);
+
+	if (order->neg || !(order->d[0] & 1))
+		return BIGINT_INVALID_MODULUS;
+	if (*m_len == 1 && order->d[0] == 1)
+		return FAILED;
+	if (new_Mont(ctx, order->d, *m_len) != SUCCEEDED)
+		return MEMORY_ALLOCATE_FAILED;
+	*x = (uint64_t *)malloc(2 * (size_t)ctx->n * sizeof(uint64_t));
+	if (!*x)
+	{
+		delete_Mont(ctx);
+		return MEMORY_ALLOCATE_FAILED;
+	}
+	return SUCCEEDED;
+}
+
+// r = 1 / x (mod m) in Montgomery form, the inversion runs on plain 32-bit limbs.
+static Status mont_inv(const Mont *ctx, uint64_t *r, const uint64_t *x, const uint32_t *m, uint32_t m_len)
+{
+	uint32_t *buf = (uint32_t *)malloc(4 * (size_t)ctx->n * sizeof(uint32_t));
+	if (!buf)
+		return MEMORY_ALLOCATE_FAILED;
+
+	mont_mul(ctx, r, x, ctx->unit);
+	limbs_from_64(buf, m_len, r);
+	Status status = limbs_modinv(buf + 2 * ctx->n, buf, m, m_len);
+	if (status == SUCCEEDED)
+	{
+		limbs_to_64(r, ctx->n, buf + 2 * ctx->n, m_len);
+		mont_mul(ctx, r, r, ctx->r2);
+	}
+	free(buf);
+	return status;
+}
+
+// A new Bigint of the residue out of Montgomery form.
+static Bigint * Bigint_from_mont(const Mont *ctx, uint64_t *x, uint32_t m_len)
+{
+	mont_mul(ctx, x, x, ctx->unit);
+	uint32_t *d = (uint32_t *)ctx->t;
+	limbs_from_64(d, m_len, x);
+	return Bigint_from_limbs(d, m_len, false);
+}
+
+static Bigint * Bigint_pow_impl(Bigint *a, Bigint *e, Bigint *order, bool consttime)
+{
+	const uint32_t zero = 0;
+	Mont ctx;
+	uint64_t *x;
+	uint32_t m_len;
+	Status status = mod_setup(&ctx, order, &x, &m_len);
+	// Everything is 0 mod 1.
+	if (status == FAILED)
+		return Bigint_from_limbs(&zero, 1, false);
+	if (status != SUCCEEDED)
+		return status;
+	uint64_t *r = x + ctx.n;
+
+	mont_set_bigint(&ctx, x, a);
+	// x^-0 is x^0, no inverse needed.
+	if (e->neg && !(e->len == 1 && e->d[0] == 0))
+		status = mont_inv(&ctx, x, x, order->d, m_len);
+	if (status == SUCCEEDED)
+		status = consttime ? mont_pow_consttime(&ctx, r, x, e->d, e->len) : mont_pow(&ctx, r, x, e->d, e->len);
+
+	Bigint *bn = status == SUCCEEDED ? Bigint_from_mont(&ctx, r, m_len) : status;
+	free(x);
+	delete_Mont(&ctx);
+	return bn;
+}
+
+Bigint * Bigint_pow(Bigint *a, Bigint *e, Bigint *order)
+{
+	return Bigint_pow_impl(a, e, order, false);
+}
+
+Bigint * Bigint_pow_consttime(Bigint *a, Bigint *e, Bigint *order)
+{
+	return Bigint_pow_impl(a, e, order, true);
+}
+
+Bigint * Bigint_ext(Bigint *a, Bigint *order)
+{
+	const uint32_t zero = 0;
+	Mont ctx;
+	uint64_t *x;
+	uint32_t m_len;
+	Status status = mod_setup(&ctx, order, &x, &m_len);
+	if (status == FAILED)
+		return Bigint_from_limbs(&zero, 1, false);
+	if (status != SUCCEEDED)
+		return status;
+
+	// a (mod m) through Montgomery form.
+	mont_set_bigint(&ctx, x, a);
+	status = mont_inv(&ctx, x, x, order->d, m_len);
+
+	Bigint *bn = status == SUCCEEDED ? Bigint_from_mont(&ctx, x, m_len) : status;
+	free(x);
+	delete_Mont(&ctx);
+	return bn;
+}
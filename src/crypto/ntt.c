@@ -1,7 +1,8 @@
 #include "internal/codec/strings.h"
 #include "internal/crypto/ntt.h"
-
-uint64_t Wn[20];
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 
 // a^b (mod m)
 uint64_t quick_power_mod(uint64_t a, uint64_t b, uint64_t m)
@@ -21,63 +22,512 @@ uint64_t quick_power_mod(uint64_t a, uint64_t b, uint64_t m)
 	return ans;
 }
 
-// overflow when point > 0xaf45
-void ntt(uint64_t *a, uint32_t len, bool on)
+const uint64_t ntt_primes[NTT_PRIME_COUNT] = {NTT_P0, NTT_P1, NTT_P2};
+static const uint64_t ntt_roots[NTT_PRIME_COUNT] = {NTT_G0, NTT_G1, NTT_G2};
+
+// Shoup's multiplication by a constant w < p with w_shoup = floor(w * 2^32 / p): the quotient
+// estimate is off by at most one, so x * w - q * p lands in [0, 2p) and fits 32 bits.
+static inline uint32_t mul_shoup(uint32_t x, uint32_t w, uint32_t w_shoup, uint32_t p)
+{
+	uint32_t q = (uint32_t)(((uint64_t)x * w_shoup) >> 32);
+	uint32_t r = x * w - q * p;
+	return r >= p ? r - p : r;
+}
+
+static inline uint32_t shoup(uint32_t w, uint32_t p)
+{
+	return (uint32_t)(((uint64_t)w << 32) / p);
+}
+
+// Montgomery's x * y * 2^-32 (mod p) for x, y below p, with p_inv = -1 / p (mod 2^32).
+// With y in Montgomery form, y * 2^32 (mod p), it is the plain product.
+static inline uint32_t mul_mont(uint32_t x, uint32_t y, uint32_t p, uint32_t p_inv)
+{
+	uint64_t t = (uint64_t)x * y;
+	uint32_t m = (uint32_t)t * p_inv;
+	uint32_t r = (uint32_t)((t + (uint64_t)m * p) >> 32);
+	return r >= p ? r - p : r;
+}
+
+static inline uint32_t mont_p_inv(uint32_t p)
+{
+	// Newton's iteration doubles the correct low bits, p is its own inverse mod 8.
+	uint32_t inv = p;
+	for (int i = 0; i < 4; ++i)
+		inv *= 2 - p * inv;
+	return 0 - inv;
+}
+
+NttPlan * new_NttPlan(uint32_t len, uint32_t prime)
+{
+	NttPlan *plan = (NttPlan *)malloc(sizeof(NttPlan) + (size_t)len * 3 * sizeof(uint32_t));
+	if (plan == NULL)
+		return MEMORY_ALLOCATE_FAILED;
+
+	const uint32_t p = (uint32_t)ntt_primes[prime];
+	plan->len = len;
+	plan->prime = prime;
+	plan->p = p;
+	plan->p_inv = mont_p_inv(p);
+	plan->len_inv = (uint32_t)quick_power_mod(len, p - 2, p);
+	plan->len_inv_shoup = shoup(plan->len_inv, p);
+	plan->rev = (uint32_t *)(plan + 1);
+	plan->twiddles = plan->rev + len;
+	plan->twiddles_shoup = plan->twiddles + len;
+	plan->col_plan = NULL;
+	plan->row_plan = NULL;
+	plan->step_twiddles = NULL;
+
+	plan->rev[0] = 0;
+	for (uint32_t i = 1; i < len; ++i)
+		plan->rev[i] = (plan->rev[i >> 1] >> 1) | (i & 1 ? len >> 1 : 0);
+
+	// Powers of the len-th root for the last stage, every other one of them for the stage before.
+	plan->twiddles[0] = 0;
+	if (len > 1)
+	{
+		uint32_t m = len >> 1;
+		uint64_t w = 1, wn = quick_power_mod(ntt_roots[prime], (p - 1) / len, p);
+		for (uint32_t k = 0; k < m; ++k, w = w * wn % p)
+			plan->twiddles[m + k] = (uint32_t)w;
+		for (m >>= 1; m; m >>= 1)
+			for (uint32_t k = 0; k < m; ++k)
+				plan->twiddles[m + k] = plan->twiddles[2 * m + 2 * k];
+	}
+	for (uint32_t i = 0; i < len; ++i)
+		plan->twiddles_shoup[i] = shoup(plan->twiddles[i], p);
+
+	return plan;
+}
+
+NttPlan * new_NttPlan_four_step(uint32_t len, uint32_t prime)
+{
+	if (len < NTT_FOUR_STEP_MIN)
+		return new_NttPlan(len, prime);
+
+	NttPlan *plan = (NttPlan *)malloc(sizeof(NttPlan) + (size_t)len * 2 * sizeof(uint32_t));
+	if (plan == NULL)
+		return MEMORY_ALLOCATE_FAILED;
+
+	// No more rows than columns, the strips of a column pass stay small.
+	uint32_t log = 0;
+	while ((1u << log) < len)
+		++log;
+	const uint32_t rows = 1u << (log / 2), cols = len / rows;
+	const uint32_t p = (uint32_t)ntt_primes[prime];
+
+	plan->len = len;
+	plan->prime = prime;
+	plan->p = p;
+	plan->p_inv = mont_p_inv(p);
+	plan->len_inv = (uint32_t)quick_power_mod(len, p - 2, p);
+	plan->len_inv_shoup = shoup(plan->len_inv, p);
+	plan->rev = plan->twiddles = plan->twiddles_shoup = NULL;
+	plan->step_twiddles = (uint32_t *)(plan + 1);
+	plan->col_plan = new_NttPlan(rows, prime);
+	plan->row_plan = new_NttPlan(cols, prime);
+	if (plan->col_plan == MEMORY_ALLOCATE_FAILED || plan->row_plan == MEMORY_ALLOCATE_FAILED)
+	{
+		if (plan->col_plan != MEMORY_ALLOCATE_FAILED)
+			delete_NttPlan(plan->col_plan);
+		if (plan->row_plan != MEMORY_ALLOCATE_FAILED)
+			delete_NttPlan(plan->row_plan);
+		free(plan);
+		return MEMORY_ALLOCATE_FAILED;
+	}
+
+	// w^(k * c) and w^-(k * c) / len row by row, all in Montgomery form so no step divides. The
+	// inverse transforms skip their scalings, the 1 / len is in these twiddles.
+	const uint32_t p_inv = plan->p_inv, one = (uint32_t)((1ULL << 32) % p);
+	const uint64_t w = quick_power_mod(ntt_roots[prime], (p - 1) / len, p);
+	const uint32_t w_mont = (uint32_t)((w << 32) % p);
+	const uint32_t w_inv_mont = (uint32_t)((quick_power_mod(w, p - 2, p) << 32) % p);
+	uint32_t *forward = plan->step_twiddles, *inverse = plan->step_twiddles + len;
+	const uint32_t len_inv_mont = (uint32_t)(((uint64_t)plan->len_inv << 32) % p);
+	uint32_t base = one, base_inv = one;
+	for (uint32_t k = 0; k < rows; ++k)
+	{
+		uint32_t t = one, t_inv = len_inv_mont;
+		for (uint32_t c = 0; c < cols; ++c)
+		{
+			forward[(size_t)k * cols + c] = t;
+			inverse[(size_t)k * cols + c] = t_inv;
+			t = mul_mont(t, base, p, p_inv);
+			t_inv = mul_mont(t_inv, base_inv, p, p_inv);
+		}
+		base = mul_mont(base, w_mont, p, p_inv);
+		base_inv = mul_mont(base_inv, w_inv_mont, p, p_inv);
+	}
+
+	return plan;
+}
+
+void delete_NttPlan(NttPlan *plan)
 {
-	get_Wn();
-	rader(a, len);
-	uint32_t id = 0;
+	if (plan->col_plan)
+	{
+		delete_NttPlan(plan->col_plan);
+		delete_NttPlan(plan->row_plan);
+	}
+	free(plan);
+}
+
+/******************** Kernels ********************/
+/*
+*  Iterative radix-2 stages on residues below p < 2^31. Sums and differences stay below 2p
+*  and take one conditional subtraction, the twiddle products take none of the divisions.
+*/
+void ntt_stage_scalar(uint32_t *a, uint32_t len, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p)
+{
+	for (uint32_t j = 0; j < len; j += 2 * m)
+	{
+		uint32_t *x = a + j, *y = a + j + m;
+		for (uint32_t k = 0; k < m; ++k)
+		{
+			uint32_t u = x[k];
+			uint32_t t = mul_shoup(y[k], w[k], w_shoup[k], p);
+			uint32_t s = u + t, d = u - t + p;
+			x[k] = s >= p ? s - p : s;
+			y[k] = d >= p ? d - p : d;
+		}
+	}
+}
 
-	for(uint32_t h = 2; h <= len; h <<= 1)
+void ntt_col_stage_scalar(uint32_t *a, size_t stride, uint32_t rows, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p)
+{
+	for (uint32_t j = 0; j < rows; j += 2 * m)
 	{
-		id++;
-		for(uint32_t j = 0; j < len; j += h)
+		for (uint32_t k = 0; k < m; ++k)
 		{
-			uint64_t w = 1;
-			for(uint32_t k = j; k < j + h / 2; k++)
+			uint32_t *x = a + (size_t)(j + k) * stride, *y = x + (size_t)m * stride;
+			for (uint32_t i = 0; i < NTT_BLOCK_COLS; ++i)
 			{
-				uint64_t u = a[k] % P;
-				uint64_t t = w * a[k + h / 2] % P;
-				a[k] = (u + t) % P;
-				a[k + h / 2] = (u - t + P) % P;
-				w = w * Wn[id] % P;
+				uint32_t u = x[i];
+				uint32_t t = mul_shoup(y[i], w[k], w_shoup[k], p);
+				uint32_t s = u + t, d = u - t + p;
+				x[i] = s >= p ? s - p : s;
+				y[i] = d >= p ? d - p : d;
 			}
 		}
 	}
+}
+
+void ntt_col_twiddle_scalar(uint32_t *a, size_t stride, uint32_t rows, const uint32_t *w, uint32_t p, uint32_t p_inv)
+{
+	for (uint32_t k = 0; k < rows; ++k)
+		for (uint32_t i = 0; i < NTT_BLOCK_COLS; ++i)
+			a[(size_t)k * stride + i] = mul_mont(a[(size_t)k * stride + i], w[(size_t)k * stride + i], p, p_inv);
+}
 
-	if(on == true)
+static NTT_IMPL ntt_selected_impl = NTT_AUTO;
+static void (*ntt_stage)(uint32_t *, uint32_t, uint32_t, const uint32_t *, const uint32_t *, uint32_t) = &ntt_stage_scalar;
+static uint32_t ntt_stage_lanes = 1; // Stages with a shorter half-length run on the scalar kernel.
+static void (*ntt_col_stage)(uint32_t *, size_t, uint32_t, uint32_t, const uint32_t *, const uint32_t *, uint32_t) = &ntt_col_stage_scalar;
+static void (*ntt_col_twiddle)(uint32_t *, size_t, uint32_t, const uint32_t *, uint32_t, uint32_t) = &ntt_col_twiddle_scalar;
+
+static bool cpu_supports(NTT_IMPL impl)
+{
+	__builtin_cpu_init();
+	switch (impl)
 	{
-		for(uint32_t i = 1; i < len / 2; i++)
-			integer_swap(&a[i], &a[len - i], UINT64_TYPE);
+		case NTT_SCALAR: return true;
+		case NTT_AVX2:   return __builtin_cpu_supports("avx2");
+		case NTT_AVX512: return __builtin_cpu_supports("avx512f");
+		default: return false;
+	}
+}
 
-		uint64_t inv = quick_power_mod(len, P - 2, P);
+Status ntt_select(NTT_IMPL impl)
+{
+	if (impl == NTT_AUTO)
+	{
+		ntt_select(cpu_supports(NTT_AVX512) ? NTT_AVX512 : cpu_supports(NTT_AVX2) ? NTT_AVX2 : NTT_SCALAR);
+		ntt_selected_impl = NTT_AUTO;
+		return SUCCEEDED;
+	}
+	if (!cpu_supports(impl))
+		return FAILED;
 
-		for(uint32_t i = 0; i < len; i++)
-			a[i] = a[i] * inv % P;
+	switch (impl)
+	{
+		case NTT_AVX2:
+			ntt_stage = &ntt_stage_avx2;
+			ntt_stage_lanes = 8;
+			ntt_col_stage = &ntt_col_stage_avx2;
+			ntt_col_twiddle = &ntt_col_twiddle_avx2;
+			break;
+		case NTT_AVX512:
+			ntt_stage = &ntt_stage_avx512;
+			ntt_stage_lanes = 16;
+			ntt_col_stage = &ntt_col_stage_avx512;
+			ntt_col_twiddle = &ntt_col_twiddle_avx512;
+			break;
+		default:
+			ntt_stage = &ntt_stage_scalar;
+			ntt_stage_lanes = 1;
+			ntt_col_stage = &ntt_col_stage_scalar;
+			ntt_col_twiddle = &ntt_col_twiddle_scalar;
+			break;
 	}
+	ntt_selected_impl = impl;
+	return SUCCEEDED;
 }
 
-void get_Wn()
+NTT_IMPL ntt_selected(void)
 {
-	for(uint32_t i = 0; i < 20; ++i)
+	return ntt_selected_impl;
+}
+
+// Select the kernel once when the library is loaded.
+__attribute__((constructor)) static void ntt_init(void)
+{
+	ntt_select(NTT_AUTO);
+}
+
+/******************** Transforms ********************/
+/*
+*  The inverse is the forward transform with the outputs 1..len-1 reversed and scaled by 1 / len,
+*  or left unscaled when the caller folds 1 / len in elsewhere.
+*/
+static void ntt_radix2(const NttPlan *plan, uint32_t *a, bool on, bool scale)
+{
+	const uint32_t len = plan->len, p = plan->p;
+
+	for (uint32_t i = 0; i < len; ++i)
 	{
-		uint32_t t = 1 << i;
-		Wn[i] = quick_power_mod(G, (P - 1) / t, P);
+		uint32_t j = plan->rev[i];
+		if (i < j)
+		{
+			uint32_t t = a[i];
+			a[i] = a[j];
+			a[j] = t;
+		}
+	}
+
+	for (uint32_t m = 1; m < len; m <<= 1)
+	{
+		if (m >= ntt_stage_lanes)
+			ntt_stage(a, len, m, plan->twiddles + m, plan->twiddles_shoup + m, p);
+		else
+			ntt_stage_scalar(a, len, m, plan->twiddles + m, plan->twiddles_shoup + m, p);
+	}
+
+	if (on == true && scale == false)
+	{
+		for (uint32_t i = 1; i < len - i; ++i)
+		{
+			uint32_t t = a[i];
+			a[i] = a[len - i];
+			a[len - i] = t;
+		}
+	}
+	else if (on == true)
+	{
+		const uint32_t inv = plan->len_inv, inv_shoup = plan->len_inv_shoup;
+		a[0] = mul_shoup(a[0], inv, inv_shoup, p);
+		for (uint32_t i = 1; i < len - i; ++i)
+		{
+			uint32_t t = a[i];
+			a[i] = mul_shoup(a[len - i], inv, inv_shoup, p);
+			a[len - i] = mul_shoup(t, inv, inv_shoup, p);
+		}
+		if (len > 1)
+			a[len / 2] = mul_shoup(a[len / 2], inv, inv_shoup, p);
 	}
 }
 
-void rader(uint64_t *a, uint32_t len)
+// The radix-2 transform down a strip of NTT_BLOCK_COLS columns, the inverse one unscaled.
+static void ntt_strip(const NttPlan *col_plan, uint32_t *a, size_t stride, bool on)
 {
-	uint32_t j = len >> 1;
-	for (uint32_t i = 1; i < len - 1; ++i)
+	const uint32_t rows = col_plan->len;
+	uint32_t line[NTT_BLOCK_COLS];
+
+	for (uint32_t i = 0; i < rows; ++i)
 	{
-		if (i < j) integer_swap(&a[i], &a[j], UINT64_TYPE);
-		uint32_t k = len >> 1;
-		while (j >= k)
+		uint32_t j = col_plan->rev[i];
+		if (i < j)
 		{
-			j -= k;
-			k >>= 1;
+			memcpy(line, a + (size_t)i * stride, sizeof(line));
+			memcpy(a + (size_t)i * stride, a + (size_t)j * stride, sizeof(line));
+			memcpy(a + (size_t)j * stride, line, sizeof(line));
 		}
-		if (j < k) j += k;
 	}
-}
\ No newline at end of file
+
+	for (uint32_t m = 1; m < rows; m <<= 1)
+		ntt_col_stage(a, stride, rows, m, col_plan->twiddles + m, col_plan->twiddles_shoup + m, col_plan->p);
+
+	if (on == true)
+	{
+		for (uint32_t i = 1; i < rows - i; ++i)
+		{
+			memcpy(line, a + (size_t)i * stride, sizeof(line));
+			memcpy(a + (size_t)i * stride, a + (size_t)(rows - i) * stride, sizeof(line));
+			memcpy(a + (size_t)(rows - i) * stride, line, sizeof(line));
+		}
+	}
+}
+
+// The rows [begin, end) of a four-step plan, the inverse ones unscaled.
+static void ntt_rows(const NttPlan *plan, uint32_t *a, bool on, uint32_t begin, uint32_t end)
+{
+	const uint32_t cols = plan->row_plan->len;
+
+	for (uint32_t r = begin; r < end; ++r)
+		ntt_radix2(plan->row_plan, a + (size_t)r * cols, on, false);
+}
+
+// The strips of the columns [begin, end) of a four-step plan with their twiddle step, done on
+// each strip while it is in cache.
+static void ntt_strips(const NttPlan *plan, uint32_t *a, bool on, uint32_t begin, uint32_t end)
+{
+	const uint32_t rows = plan->col_plan->len, cols = plan->row_plan->len;
+	const uint32_t *step_twiddles = plan->step_twiddles + (on ? plan->len : 0);
+
+	for (uint32_t c = begin; c < end; c += NTT_BLOCK_COLS)
+	{
+		if (on == false)
+			ntt_strip(plan->col_plan, a + c, cols, false);
+		ntt_col_twiddle(a + c, cols, rows, step_twiddles + c, plan->p, plan->p_inv);
+		if (on == true)
+			ntt_strip(plan->col_plan, a + c, cols, true);
+	}
+}
+
+/*
+*  X[k_r + rows * k_c] = sum_c w_cols^(c * k_c) * w^(k_r * c) * sum_r w_rows^(r * k_r) * A[r][c],
+*  with A[r][c] = a[r * cols + c]: column transforms and the twiddle step strip by strip, then
+*  row transforms. The inverse runs the inverse steps backwards.
+*/
+static void ntt_four_step(const NttPlan *plan, uint32_t *a, bool on)
+{
+	const uint32_t rows = plan->col_plan->len, cols = plan->row_plan->len;
+
+	if (on == true)
+		ntt_rows(plan, a, true, 0, rows);
+	ntt_strips(plan, a, on, 0, cols);
+	if (on == false)
+		ntt_rows(plan, a, false, 0, rows);
+}
+
+void ntt_execute(const NttPlan *plan, uint32_t *a, bool on)
+{
+	if (plan->col_plan)
+		ntt_four_step(plan, a, on);
+	else
+		ntt_radix2(plan, a, on, true);
+}
+
+/******************** Parallel transforms ********************/
+/*
+*  The rows of a four-step plan are independent transforms and so are its strips, each pass is
+*  split into contiguous shares, one per thread. The calling thread takes the first share and
+*  joins the others, a share whose thread can't be started runs on the calling thread too.
+*/
+typedef struct ntt_share_st NttShare;
+struct ntt_share_st {
+	void (*pass)(const NttPlan *, uint32_t *, bool, uint32_t, uint32_t);
+	const NttPlan *plan;
+	uint32_t *a;
+	bool on;
+	uint32_t begin, end;
+};
+
+static void * ntt_share_worker(void *arg)
+{
+	NttShare *share = (NttShare *)arg;
+	share->pass(share->plan, share->a, share->on, share->begin, share->end);
+	return NULL;
+}
+
+// Run 'pass' over [0, count) in shares of whole 'unit's.
+static void ntt_split(void (*pass)(const NttPlan *, uint32_t *, bool, uint32_t, uint32_t),
+	const NttPlan *plan, uint32_t *a, bool on, uint32_t count, uint32_t unit, uint32_t threads)
+{
+	NttShare shares[NTT_MAX_THREADS];
+	pthread_t tids[NTT_MAX_THREADS];
+	bool started[NTT_MAX_THREADS];
+	uint32_t units = count / unit;
+
+	if (threads > units)
+		threads = units;
+	for (uint32_t t = 0; t < threads; ++t)
+	{
+		shares[t] = (NttShare){pass, plan, a, on, (uint32_t)((uint64_t)units * t / threads) * unit,
+			(uint32_t)((uint64_t)units * (t + 1) / threads) * unit};
+		started[t] = t > 0 && pthread_create(&tids[t], NULL, ntt_share_worker, &shares[t]) == 0;
+	}
+	for (uint32_t t = 0; t < threads; ++t)
+		if (!started[t])
+			ntt_share_worker(&shares[t]);
+	for (uint32_t t = 1; t < threads; ++t)
+		if (started[t])
+			pthread_join(tids[t], NULL);
+}
+
+void ntt_execute_parallel(const NttPlan *plan, uint32_t *a, bool on, uint32_t threads)
+{
+	if (threads > NTT_MAX_THREADS)
+		threads = NTT_MAX_THREADS;
+	if (plan->col_plan == NULL || threads <= 1)
+	{
+		ntt_execute(plan, a, on);
+		return;
+	}
+
+	const uint32_t rows = plan->col_plan->len, cols = plan->row_plan->len;
+	if (on == true)
+		ntt_split(ntt_rows, plan, a, true, rows, 1, threads);
+	ntt_split(ntt_strips, plan, a, on, cols, NTT_BLOCK_COLS, threads);
+	if (on == false)
+		ntt_split(ntt_rows, plan, a, false, rows, 1, threads);
+}
+
+// Both factors vary, so the product is reduced with '%' by a constant the compiler turns into
+// multiplications.
+static inline __attribute__((always_inline))
+void ntt_mul_mod(uint32_t *a, const uint32_t *b, uint32_t len, const uint64_t p)
+{
+	for (uint32_t i = 0; i < len; ++i)
+		a[i] = (uint32_t)((uint64_t)a[i] * b[i] % p);
+}
+
+void ntt_mul(const NttPlan *plan, uint32_t *a, const uint32_t *b)
+{
+	switch (plan->prime)
+	{
+	case 0:
+		ntt_mul_mod(a, b, plan->len, NTT_P0);
+		break;
+	case 1:
+		ntt_mul_mod(a, b, plan->len, NTT_P1);
+		break;
+	case 2:
+		ntt_mul_mod(a, b, plan->len, NTT_P2);
+		break;
+	}
+}
+
+// overflow when point > 0xaf45
+Status ntt(uint64_t *a, uint32_t len, bool on)
+{
+	// P is the first of the primes.
+	NttPlan *plan = new_NttPlan(len, 0);
+	if (plan == MEMORY_ALLOCATE_FAILED)
+		return MEMORY_ALLOCATE_FAILED;
+	uint32_t *x = (uint32_t *)malloc((size_t)len * sizeof(uint32_t));
+	if (x == NULL)
+	{
+		delete_NttPlan(plan);
+		return MEMORY_ALLOCATE_FAILED;
+	}
+
+	for (uint32_t i = 0; i < len; i++)
+		x[i] = (uint32_t)(a[i] % P);
+	ntt_radix2(plan, x, on, true);
+	for (uint32_t i = 0; i < len; i++)
+		a[i] = x[i];
+
+	free(x);
+	delete_NttPlan(plan);
+	return SUCCEEDED;
+}
@@ -0,0 +1,182 @@
+#include <immintrin.h>
+#include "internal/crypto/ntt.h"
+
+/*
+*  The scalar stage with 8 and 16 butterflies per iteration. The high halves of the Shoup
+*  quotients come from two widening multiplies, even and odd lanes, and min_epu32(r, r - p)
+*  is the conditional subtraction: r - p wraps above r when r < p.
+*/
+
+/******************** AVX2 ********************/
+__attribute__((target("avx2")))
+static inline __m256i mulhi_epu32_avx2(__m256i a, __m256i b)
+{
+	__m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+	__m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+	return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+__attribute__((target("avx2")))
+void ntt_stage_avx2(uint32_t *a, uint32_t len, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p)
+{
+	const __m256i vp = _mm256_set1_epi32((int)p);
+
+	for (uint32_t j = 0; j < len; j += 2 * m)
+	{
+		uint32_t *x = a + j, *y = a + j + m;
+		for (uint32_t k = 0; k < m; k += 8)
+		{
+			__m256i u = _mm256_loadu_si256((const __m256i *)(x + k));
+			__m256i v = _mm256_loadu_si256((const __m256i *)(y + k));
+			__m256i vw = _mm256_loadu_si256((const __m256i *)(w + k));
+			__m256i vq = mulhi_epu32_avx2(v, _mm256_loadu_si256((const __m256i *)(w_shoup + k)));
+			__m256i t = _mm256_sub_epi32(_mm256_mullo_epi32(v, vw), _mm256_mullo_epi32(vq, vp));
+			t = _mm256_min_epu32(t, _mm256_sub_epi32(t, vp));
+
+			__m256i s = _mm256_add_epi32(u, t);
+			__m256i d = _mm256_add_epi32(_mm256_sub_epi32(u, t), vp);
+			_mm256_storeu_si256((__m256i *)(x + k), _mm256_min_epu32(s, _mm256_sub_epi32(s, vp)));
+			_mm256_storeu_si256((__m256i *)(y + k), _mm256_min_epu32(d, _mm256_sub_epi32(d, vp)));
+		}
+	}
+}
+
+// Column butterflies, two vectors per 16-column line.
+__attribute__((target("avx2")))
+void ntt_col_stage_avx2(uint32_t *a, size_t stride, uint32_t rows, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p)
+{
+	const __m256i vp = _mm256_set1_epi32((int)p);
+
+	for (uint32_t j = 0; j < rows; j += 2 * m)
+	{
+		for (uint32_t k = 0; k < m; ++k)
+		{
+			uint32_t *x = a + (size_t)(j + k) * stride, *y = x + (size_t)m * stride;
+			const __m256i vw = _mm256_set1_epi32((int)w[k]), vw_shoup = _mm256_set1_epi32((int)w_shoup[k]);
+			for (uint32_t i = 0; i < NTT_BLOCK_COLS; i += 8)
+			{
+				__m256i u = _mm256_loadu_si256((const __m256i *)(x + i));
+				__m256i v = _mm256_loadu_si256((const __m256i *)(y + i));
+				__m256i vq = mulhi_epu32_avx2(v, vw_shoup);
+				__m256i t = _mm256_sub_epi32(_mm256_mullo_epi32(v, vw), _mm256_mullo_epi32(vq, vp));
+				t = _mm256_min_epu32(t, _mm256_sub_epi32(t, vp));
+
+				__m256i s = _mm256_add_epi32(u, t);
+				__m256i d = _mm256_add_epi32(_mm256_sub_epi32(u, t), vp);
+				_mm256_storeu_si256((__m256i *)(x + i), _mm256_min_epu32(s, _mm256_sub_epi32(s, vp)));
+				_mm256_storeu_si256((__m256i *)(y + i), _mm256_min_epu32(d, _mm256_sub_epi32(d, vp)));
+			}
+		}
+	}
+}
+
+// Montgomery products: t = x * y, m = t * p_inv (mod 2^32), (t + m * p) / 2^32 below 2p.
+__attribute__((target("avx2")))
+static inline __m256i mul_mont_avx2(__m256i x, __m256i y, __m256i vp, __m256i vp_inv)
+{
+	__m256i t_even = _mm256_mul_epu32(x, y);
+	__m256i t_odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+	__m256i u_even = _mm256_add_epi64(t_even, _mm256_mul_epu32(_mm256_mul_epu32(t_even, vp_inv), vp));
+	__m256i u_odd = _mm256_add_epi64(t_odd, _mm256_mul_epu32(_mm256_mul_epu32(t_odd, vp_inv), vp));
+	__m256i r = _mm256_blend_epi32(_mm256_srli_epi64(u_even, 32), u_odd, 0xaa);
+	return _mm256_min_epu32(r, _mm256_sub_epi32(r, vp));
+}
+
+__attribute__((target("avx2")))
+void ntt_col_twiddle_avx2(uint32_t *a, size_t stride, uint32_t rows, const uint32_t *w, uint32_t p, uint32_t p_inv)
+{
+	const __m256i vp = _mm256_set1_epi32((int)p), vp_inv = _mm256_set1_epi32((int)p_inv);
+
+	for (uint32_t k = 0; k < rows; ++k)
+	{
+		uint32_t *x = a + (size_t)k * stride;
+		const uint32_t *y = w + (size_t)k * stride;
+		for (uint32_t i = 0; i < NTT_BLOCK_COLS; i += 8)
+		{
+			__m256i r = mul_mont_avx2(_mm256_loadu_si256((const __m256i *)(x + i)),
+				_mm256_loadu_si256((const __m256i *)(y + i)), vp, vp_inv);
+			_mm256_storeu_si256((__m256i *)(x + i), r);
+		}
+	}
+}
+
+/******************** AVX-512 ********************/
+__attribute__((target("avx512f")))
+static inline __m512i mulhi_epu32_avx512(__m512i a, __m512i b)
+{
+	__m512i even = _mm512_srli_epi64(_mm512_mul_epu32(a, b), 32);
+	__m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+	return _mm512_mask_blend_epi32(0xaaaa, even, odd);
+}
+
+__attribute__((target("avx512f")))
+void ntt_stage_avx512(uint32_t *a, uint32_t len, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p)
+{
+	const __m512i vp = _mm512_set1_epi32((int)p);
+
+	for (uint32_t j = 0; j < len; j += 2 * m)
+	{
+		uint32_t *x = a + j, *y = a + j + m;
+		for (uint32_t k = 0; k < m; k += 16)
+		{
+			__m512i u = _mm512_loadu_si512(x + k);
+			__m512i v = _mm512_loadu_si512(y + k);
+			__m512i vq = mulhi_epu32_avx512(v, _mm512_loadu_si512(w_shoup + k));
+			__m512i t = _mm512_sub_epi32(_mm512_mullo_epi32(v, _mm512_loadu_si512(w + k)), _mm512_mullo_epi32(vq, vp));
+			t = _mm512_min_epu32(t, _mm512_sub_epi32(t, vp));
+
+			__m512i s = _mm512_add_epi32(u, t);
+			__m512i d = _mm512_add_epi32(_mm512_sub_epi32(u, t), vp);
+			_mm512_storeu_si512(x + k, _mm512_min_epu32(s, _mm512_sub_epi32(s, vp)));
+			_mm512_storeu_si512(y + k, _mm512_min_epu32(d, _mm512_sub_epi32(d, vp)));
+		}
+	}
+}
+
+// Column butterflies, one vector per 16-column line.
+__attribute__((target("avx512f")))
+void ntt_col_stage_avx512(uint32_t *a, size_t stride, uint32_t rows, uint32_t m, const uint32_t *w, const uint32_t *w_shoup, uint32_t p)
+{
+	const __m512i vp = _mm512_set1_epi32((int)p);
+
+	for (uint32_t j = 0; j < rows; j += 2 * m)
+	{
+		for (uint32_t k = 0; k < m; ++k)
+		{
+			uint32_t *x = a + (size_t)(j + k) * stride, *y = x + (size_t)m * stride;
+			__m512i u = _mm512_loadu_si512(x);
+			__m512i v = _mm512_loadu_si512(y);
+			__m512i vq = mulhi_epu32_avx512(v, _mm512_set1_epi32((int)w_shoup[k]));
+			__m512i t = _mm512_sub_epi32(_mm512_mullo_epi32(v, _mm512_set1_epi32((int)w[k])), _mm512_mullo_epi32(vq, vp));
+			t = _mm512_min_epu32(t, _mm512_sub_epi32(t, vp));
+
+			__m512i s = _mm512_add_epi32(u, t);
+			__m512i d = _mm512_add_epi32(_mm512_sub_epi32(u, t), vp);
+			_mm512_storeu_si512(x, _mm512_min_epu32(s, _mm512_sub_epi32(s, vp)));
+			_mm512_storeu_si512(y, _mm512_min_epu32(d, _mm512_sub_epi32(d, vp)));
+		}
+	}
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i mul_mont_avx512(__m512i x, __m512i y, __m512i vp, __m512i vp_inv)
+{
+	__m512i t_even = _mm512_mul_epu32(x, y);
+	__m512i t_odd = _mm512_mul_epu32(_mm512_srli_epi64(x, 32), _mm512_srli_epi64(y, 32));
+	__m512i u_even = _mm512_add_epi64(t_even, _mm512_mul_epu32(_mm512_mul_epu32(t_even, vp_inv), vp));
+	__m512i u_odd = _mm512_add_epi64(t_odd, _mm512_mul_epu32(_mm512_mul_epu32(t_odd, vp_inv), vp));
+	__m512i r = _mm512_mask_blend_epi32(0xaaaa, _mm512_srli_epi64(u_even, 32), u_odd);
+	return _mm512_min_epu32(r, _mm512_sub_epi32(r, vp));
+}
+
+__attribute__((target("avx512f")))
+void ntt_col_twiddle_avx512(uint32_t *a, size_t stride, uint32_t rows, const uint32_t *w, uint32_t p, uint32_t p_inv)
+{
+	const __m512i vp = _mm512_set1_epi32((int)p), vp_inv = _mm512_set1_epi32((int)p_inv);
+
+	for (uint32_t k = 0; k < rows; ++k)
+	{
+		uint32_t *x = a + (size_t)k * stride;
+		_mm512_storeu_si512(x, mul_mont_avx512(_mm512_loadu_si512(x), _mm512_loadu_si512(w + (size_t)k * stride), vp, vp_inv));
+	}
+}
@@ -0,0 +1,143 @@
+#include <errno.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/random.h>
+#include "internal/crypto/random.h"
+
+#define RANDOM_BLOCKS 16 // ChaCha20 blocks per refill, the first 32 bytes become the next key.
+
+#define ROL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define LOAD32_LE(p) ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+#define QUARTERROUND(a, b, c, d) \
+	a += b; d ^= a; d = ROL32(d, 16); \
+	c += d; b ^= c; b = ROL32(b, 12); \
+	a += b; d ^= a; d = ROL32(d, 8); \
+	c += d; b ^= c; b = ROL32(b, 7);
+
+void chacha20_block(const uint32_t *state, byte *out)
+{
+	uint32_t x[16];
+
+	memcpy(x, state, sizeof(x));
+	for (uint8_t i = 0; i < 10; ++i)
+	{
+		QUARTERROUND(x[0], x[4], x[8],  x[12]);
+		QUARTERROUND(x[1], x[5], x[9],  x[13]);
+		QUARTERROUND(x[2], x[6], x[10], x[14]);
+		QUARTERROUND(x[3], x[7], x[11], x[15]);
+		QUARTERROUND(x[0], x[5], x[10], x[15]);
+		QUARTERROUND(x[1], x[6], x[11], x[12]);
+		QUARTERROUND(x[2], x[7], x[8],  x[13]);
+		QUARTERROUND(x[3], x[4], x[9],  x[14]);
+	}
+	for (uint8_t i = 0; i < 16; ++i)
+	{
+		uint32_t v = x[i] + state[i];
+		out[i * 4]     = (byte)v;
+		out[i * 4 + 1] = (byte)(v >> 8);
+		out[i * 4 + 2] = (byte)(v >> 16);
+		out[i * 4 + 3] = (byte)(v >> 24);
+	}
+}
+
+typedef struct random_state_st RandomState;
+struct random_state_st {
+	uint32_t input[16];           // Constants, key, counter and nonce.
+	byte buf[RANDOM_BLOCKS * 64];
+	size_t available;             // Unused bytes at the end of 'buf'.
+	size_t until_reseed;
+	uint32_t forks;               // random_forks when seeded.
+	bool seeded;
+};
+
+static __thread RandomState random_state;
+
+// Bumped in the child after fork(), so the child doesn't repeat the parent's output.
+static volatile uint32_t random_forks;
+static pthread_once_t random_atfork_once = PTHREAD_ONCE_INIT;
+
+static void random_atfork_child(void)
+{
+	random_forks++;
+}
+
+static void random_atfork_register(void)
+{
+	pthread_atfork(NULL, NULL, random_atfork_child);
+}
+
+static Status random_seed(RandomState *rs)
+{
+	byte seed[40];
+	size_t got = 0;
+
+	pthread_once(&random_atfork_once, random_atfork_register);
+	while (got < sizeof(seed))
+	{
+		ssize_t n = getrandom(seed + got, sizeof(seed) - got, 0);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0)
+			return FAILED;
+		got += n;
+	}
+
+	// "expand 32-byte k", 256-bit key, 64-bit counter, 64-bit nonce.
+	rs->input[0] = 0x61707865; rs->input[1] = 0x3320646e;
+	rs->input[2] = 0x79622d32; rs->input[3] = 0x6b206574;
+	for (uint8_t i = 0; i < 8; ++i)
+		rs->input[4 + i] = LOAD32_LE(seed + i * 4);
+	rs->input[12] = 0; rs->input[13] = 0;
+	rs->input[14] = LOAD32_LE(seed + 32);
+	rs->input[15] = LOAD32_LE(seed + 36);
+	memset(seed, 0, sizeof(seed));
+
+	rs->available = 0;
+	rs->until_reseed = RANDOM_RESEED_INTERVAL;
+	rs->forks = random_forks;
+	rs->seeded = true;
+	return SUCCEEDED;
+}
+
+// Fill the buffer, then take its first 32 bytes as the next key and wipe them.
+static void random_refill(RandomState *rs)
+{
+	for (uint8_t i = 0; i < RANDOM_BLOCKS; ++i)
+	{
+		chacha20_block(rs->input, rs->buf + i * 64);
+		if (++rs->input[12] == 0)
+			rs->input[13]++;
+	}
+	for (uint8_t i = 0; i < 8; ++i)
+		rs->input[4 + i] = LOAD32_LE(rs->buf + i * 4);
+	memset(rs->buf, 0, 32);
+	rs->available = sizeof(rs->buf) - 32;
+}
+
+Status random_bytes(byte *buf, size_t len)
+{
+	RandomState *rs = &random_state;
+
+	if (!rs->seeded || rs->forks != random_forks || rs->until_reseed < len)
+	{
+		if (random_seed(rs) != SUCCEEDED)
+			return FAILED;
+	}
+	rs->until_reseed -= len > rs->until_reseed ? rs->until_reseed : len;
+
+	while (len)
+	{
+		if (rs->available == 0)
+			random_refill(rs);
+
+		size_t take = len < rs->available ? len : rs->available;
+		byte *src = rs->buf + sizeof(rs->buf) - rs->available;
+		memcpy(buf, src, take);
+		memset(src, 0, take);
+		rs->available -= take;
+		buf += take;
+		len -= take;
+	}
+	return SUCCEEDED;
+}
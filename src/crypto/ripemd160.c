@@ -0,0 +1,189 @@
+#include <string.h>
+#include "internal/crypto/sha256.h"
+#include "internal/crypto/ripemd160.h"
+#include "ripemd160_rounds.h"
+
+#define HASH160_BLOCK_SIZE 64 // Messages hashed per sha256_batch() / ripemd160_batch() pass.
+
+const uint32_t ripemd160_iv[5] = {
+	0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0,
+};
+
+#define LOAD32_LE(p) ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+void ripemd160_transform_scalar(uint32_t *state, const byte *blocks, size_t nblocks)
+{
+	uint32_t x[16];
+
+	for (size_t n = 0; n < nblocks; ++n, blocks += 64)
+	{
+		for (uint8_t i = 0; i < 16; ++i)
+			x[i] = LOAD32_LE(blocks + i * 4);
+
+		uint32_t al = state[0], bl = state[1], cl = state[2], dl = state[3], el = state[4];
+		uint32_t ar = al, br = bl, cr = cl, dr = dl, er = el;
+		RMD_COMPRESS(al, bl, cl, dl, el, ar, br, cr, dr, er, x);
+
+		uint32_t t = state[1] + cl + dr;
+		state[1] = state[2] + dl + er;
+		state[2] = state[3] + el + ar;
+		state[3] = state[4] + al + br;
+		state[4] = state[0] + bl + cr;
+		state[0] = t;
+	}
+}
+
+/******************** Kernel selection ********************/
+static RIPEMD160_IMPL selected = RIPEMD160_AUTO;
+static uint8_t lanes = 1; // Widest multi-lane kernel in use, 1 if none.
+
+static bool cpu_supports(RIPEMD160_IMPL impl)
+{
+	__builtin_cpu_init();
+	switch (impl)
+	{
+		case RIPEMD160_SCALAR: return true;
+		case RIPEMD160_SSE41:  return __builtin_cpu_supports("sse4.1");
+		case RIPEMD160_AVX2:   return __builtin_cpu_supports("avx2");
+		case RIPEMD160_AVX512: return __builtin_cpu_supports("avx512f");
+		default: return false;
+	}
+}
+
+Status ripemd160_select(RIPEMD160_IMPL impl)
+{
+	if (impl == RIPEMD160_AUTO)
+	{
+		lanes = cpu_supports(RIPEMD160_AVX512) ? 16 : cpu_supports(RIPEMD160_AVX2) ? 8 : cpu_supports(RIPEMD160_SSE41) ? 4 : 1;
+		selected = RIPEMD160_AUTO;
+		return SUCCEEDED;
+	}
+	if (!cpu_supports(impl))
+		return FAILED;
+
+	switch (impl)
+	{
+		case RIPEMD160_SSE41:  lanes = 4;  break;
+		case RIPEMD160_AVX2:   lanes = 8;  break;
+		case RIPEMD160_AVX512: lanes = 16; break;
+		default:               lanes = 1;  break;
+	}
+	selected = impl;
+	return SUCCEEDED;
+}
+
+RIPEMD160_IMPL ripemd160_selected(void)
+{
+	return selected;
+}
+
+// Select the kernels once when the library is loaded.
+__attribute__((constructor)) static void ripemd160_init(void)
+{
+	ripemd160_select(RIPEMD160_AUTO);
+}
+
+/******************** Hash functions ********************/
+static void store_digest(const uint32_t *state, byte *digest)
+{
+	for (uint8_t i = 0; i < 5; ++i)
+	{
+		digest[i*4]   = state[i];
+		digest[i*4+1] = state[i] >> 8;
+		digest[i*4+2] = state[i] >> 16;
+		digest[i*4+3] = state[i] >> 24;
+	}
+}
+
+// Build the padded tail of a message, return how many blocks (1 or 2).
+static uint8_t pad_tail(const byte *tail, size_t tail_len, size_t len, byte *blocks)
+{
+	uint8_t nblocks = tail_len < 56 ? 1 : 2;
+	uint64_t bits = (uint64_t)len * 8;
+
+	memcpy(blocks, tail, tail_len);
+	blocks[tail_len] = 0x80;
+	memset(blocks + tail_len + 1, 0, nblocks * 64 - tail_len - 1);
+	for (uint8_t i = 0; i < 8; ++i)
+		blocks[nblocks * 64 - 8 + i] = bits >> (i * 8);
+	return nblocks;
+}
+
+void ripemd160(const byte *data, size_t len, byte *digest)
+{
+	uint32_t state[5];
+	byte tail[128];
+
+	memcpy(state, ripemd160_iv, sizeof(state));
+	ripemd160_transform_scalar(state, data, len / 64);
+	ripemd160_transform_scalar(state, tail, pad_tail(data + len / 64 * 64, len % 64, len, tail));
+	store_digest(state, digest);
+}
+
+// Hash 'n' (<= 16) messages side by side with the n-lane kernel.
+static void ripemd160_lanes(const byte *data, size_t stride, size_t len, uint8_t n, byte *digests)
+{
+	uint32_t state[5 * 16];
+	byte tails[16][128];
+	const byte *blocks[16];
+	size_t full = len / 64;
+	uint8_t tail_blocks = 0;
+
+	for (uint8_t i = 0; i < 5; ++i)
+		for (uint8_t j = 0; j < n; ++j)
+			state[i * n + j] = ripemd160_iv[i];
+	for (uint8_t j = 0; j < n; ++j)
+		tail_blocks = pad_tail(data + j * stride + full * 64, len % 64, len, tails[j]);
+
+	for (size_t b = 0; b < full + tail_blocks; ++b)
+	{
+		for (uint8_t j = 0; j < n; ++j)
+			blocks[j] = b < full ? data + j * stride + b * 64 : tails[j] + (b - full) * 64;
+		switch (n)
+		{
+			case 4:  ripemd160_transform_x4(state, blocks);  break;
+			case 8:  ripemd160_transform_x8(state, blocks);  break;
+			case 16: ripemd160_transform_x16(state, blocks); break;
+		}
+	}
+
+	for (uint8_t j = 0; j < n; ++j)
+	{
+		uint32_t lane[5];
+		for (uint8_t i = 0; i < 5; ++i)
+			lane[i] = state[i * n + j];
+		store_digest(lane, digests + j * 20);
+	}
+}
+
+void ripemd160_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests)
+{
+	size_t i = 0;
+
+	for (uint8_t n = lanes; n >= 4; n /= 2)
+	{
+		for ( ; count - i >= n; i += n)
+			ripemd160_lanes(data + i * stride, stride, len, n, digests + i * 20);
+	}
+	for ( ; i < count; ++i)
+		ripemd160(data + i * stride, len, digests + i * 20);
+}
+
+void hash160(const byte *data, size_t len, byte *digest)
+{
+	byte first[32];
+	sha256(data, len, first);
+	ripemd160(first, 32, digest);
+}
+
+void hash160_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests)
+{
+	byte first[HASH160_BLOCK_SIZE][32];
+
+	for (size_t i = 0; i < count; i += HASH160_BLOCK_SIZE)
+	{
+		size_t n = count - i < HASH160_BLOCK_SIZE ? count - i : HASH160_BLOCK_SIZE;
+		sha256_batch(data + i * stride, stride, len, n, first[0]);
+		ripemd160_batch(first[0], 32, 32, n, digests + i * 20);
+	}
+}
@@ -0,0 +1,46 @@
+/*
+*  Multi-lane RIPEMD-160 kernel template, included by ripemd160_x86.c once per lane count.
+*  Each vector holds the same state word (or message word) of RIPEMD160_LANES messages.
+*  Define before including:
+*    RIPEMD160_LANES   Number of messages hashed side by side (4, 8 or 16).
+*    RIPEMD160_TARGET  The target attribute for the kernel, e.g. "avx2".
+*    RIPEMD160_KERNEL  Name of the kernel function.
+*    RIPEMD160_VEC     Name of the vector type.
+*/
+typedef uint32_t RIPEMD160_VEC __attribute__((vector_size(RIPEMD160_LANES * 4)));
+
+__attribute__((target(RIPEMD160_TARGET)))
+void RIPEMD160_KERNEL(uint32_t *state, const byte **blocks)
+{
+	RIPEMD160_VEC x[16];
+	uint32_t words[16][RIPEMD160_LANES] __attribute__((aligned(64)));
+
+	// Transpose: word i of every lane into one vector.
+	for (uint8_t j = 0; j < RIPEMD160_LANES; ++j)
+		for (uint8_t i = 0; i < 16; ++i)
+			memcpy(&words[i][j], blocks[j] + i * 4, 4);
+	for (uint8_t i = 0; i < 16; ++i)
+		memcpy(&x[i], words[i], sizeof(RIPEMD160_VEC));
+
+	RIPEMD160_VEC s[5];
+	for (uint8_t i = 0; i < 5; ++i)
+		memcpy(&s[i], state + i * RIPEMD160_LANES, sizeof(RIPEMD160_VEC));
+
+	RIPEMD160_VEC al = s[0], bl = s[1], cl = s[2], dl = s[3], el = s[4];
+	RIPEMD160_VEC ar = al, br = bl, cr = cl, dr = dl, er = el;
+	RMD_COMPRESS(al, bl, cl, dl, el, ar, br, cr, dr, er, x);
+
+	RIPEMD160_VEC t = s[1] + cl + dr;
+	s[1] = s[2] + dl + er;
+	s[2] = s[3] + el + ar;
+	s[3] = s[4] + al + br;
+	s[4] = s[0] + bl + cr;
+	s[0] = t;
+	for (uint8_t i = 0; i < 5; ++i)
+		memcpy(state + i * RIPEMD160_LANES, &s[i], sizeof(RIPEMD160_VEC));
+}
+
+#undef RIPEMD160_LANES
+#undef RIPEMD160_TARGET
+#undef RIPEMD160_KERNEL
+#undef RIPEMD160_VEC
@@ -0,0 +1,84 @@
+/*
+*  RIPEMD-160 round macros, shared by the scalar kernel and the multi-lane kernels.
+*  The operators work the same on uint32_t and on GCC vectors of uint32_t.
+*/
+#ifndef _CRYPTO_RIPEMD160_ROUNDS_
+#define _CRYPTO_RIPEMD160_ROUNDS_
+
+// Message word selection and rotation amounts, left line then right line.
+static const uint8_t rmd_rl[80] = {
+	 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+	 7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
+	 3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
+	 1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
+	 4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13,
+};
+static const uint8_t rmd_rr[80] = {
+	 5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
+	 6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
+	15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
+	 8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
+	12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11,
+};
+static const uint8_t rmd_sl[80] = {
+	11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
+	 7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
+	11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
+	11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
+	 9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6,
+};
+static const uint8_t rmd_sr[80] = {
+	 8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
+	 9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
+	 9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
+	15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
+	 8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11,
+};
+
+#define RMD_ROL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define RMD_F0(x, y, z) ((x) ^ (y) ^ (z))
+#define RMD_F1(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define RMD_F2(x, y, z) (((x) | ~(y)) ^ (z))
+#define RMD_F3(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
+#define RMD_F4(x, y, z) ((x) ^ ((y) | ~(z)))
+
+// One step, the caller rotates the variable names instead of moving the values.
+#define RMD_STEP(a, b, c, d, e, f, x, k, s) \
+	a += f(b, c, d) + (x) + (k); \
+	a = RMD_ROL(a, s) + e; \
+	c = RMD_ROL(c, 10);
+
+// Sixteen steps of one line, 'i' is the index of the first step, 'r' and 's' the line's tables.
+#define RMD_ROUND(a, b, c, d, e, f, k, x, r, s, i) \
+	RMD_STEP(a, b, c, d, e, f, x[r[i +  0]], k, s[i +  0]); \
+	RMD_STEP(e, a, b, c, d, f, x[r[i +  1]], k, s[i +  1]); \
+	RMD_STEP(d, e, a, b, c, f, x[r[i +  2]], k, s[i +  2]); \
+	RMD_STEP(c, d, e, a, b, f, x[r[i +  3]], k, s[i +  3]); \
+	RMD_STEP(b, c, d, e, a, f, x[r[i +  4]], k, s[i +  4]); \
+	RMD_STEP(a, b, c, d, e, f, x[r[i +  5]], k, s[i +  5]); \
+	RMD_STEP(e, a, b, c, d, f, x[r[i +  6]], k, s[i +  6]); \
+	RMD_STEP(d, e, a, b, c, f, x[r[i +  7]], k, s[i +  7]); \
+	RMD_STEP(c, d, e, a, b, f, x[r[i +  8]], k, s[i +  8]); \
+	RMD_STEP(b, c, d, e, a, f, x[r[i +  9]], k, s[i +  9]); \
+	RMD_STEP(a, b, c, d, e, f, x[r[i + 10]], k, s[i + 10]); \
+	RMD_STEP(e, a, b, c, d, f, x[r[i + 11]], k, s[i + 11]); \
+	RMD_STEP(d, e, a, b, c, f, x[r[i + 12]], k, s[i + 12]); \
+	RMD_STEP(c, d, e, a, b, f, x[r[i + 13]], k, s[i + 13]); \
+	RMD_STEP(b, c, d, e, a, f, x[r[i + 14]], k, s[i + 14]); \
+	RMD_STEP(a, b, c, d, e, f, x[r[i + 15]], k, s[i + 15]);
+
+// 80 steps of both lines on message words 'x', sixteen steps shift the names by one.
+#define RMD_COMPRESS(al, bl, cl, dl, el, ar, br, cr, dr, er, x) \
+	RMD_ROUND(al, bl, cl, dl, el, RMD_F0, 0x00000000, x, rmd_rl, rmd_sl,  0); \
+	RMD_ROUND(el, al, bl, cl, dl, RMD_F1, 0x5a827999, x, rmd_rl, rmd_sl, 16); \
+	RMD_ROUND(dl, el, al, bl, cl, RMD_F2, 0x6ed9eba1, x, rmd_rl, rmd_sl, 32); \
+	RMD_ROUND(cl, dl, el, al, bl, RMD_F3, 0x8f1bbcdc, x, rmd_rl, rmd_sl, 48); \
+	RMD_ROUND(bl, cl, dl, el, al, RMD_F4, 0xa953fd4e, x, rmd_rl, rmd_sl, 64); \
+	RMD_ROUND(ar, br, cr, dr, er, RMD_F4, 0x50a28be6, x, rmd_rr, rmd_sr,  0); \
+	RMD_ROUND(er, ar, br, cr, dr, RMD_F3, 0x5c4dd124, x, rmd_rr, rmd_sr, 16); \
+	RMD_ROUND(dr, er, ar, br, cr, RMD_F2, 0x6d703ef3, x, rmd_rr, rmd_sr, 32); \
+	RMD_ROUND(cr, dr, er, ar, br, RMD_F1, 0x7a6d76e9, x, rmd_rr, rmd_sr, 48); \
+	RMD_ROUND(br, cr, dr, er, ar, RMD_F0, 0x00000000, x, rmd_rr, rmd_sr, 64);
+
+#endif
@@ -0,0 +1,22 @@
+#include <string.h>
+#include "internal/crypto/ripemd160.h"
+#include "ripemd160_rounds.h"
+
+/******************** SSE4.1 / AVX2 / AVX-512 ********************/
+#define RIPEMD160_LANES  4
+#define RIPEMD160_TARGET "sse4.1"
+#define RIPEMD160_KERNEL ripemd160_transform_x4
+#define RIPEMD160_VEC    ripemd160_vec4
+#include "ripemd160_lanes.h"
+
+#define RIPEMD160_LANES  8
+#define RIPEMD160_TARGET "avx2"
+#define RIPEMD160_KERNEL ripemd160_transform_x8
+#define RIPEMD160_VEC    ripemd160_vec8
+#include "ripemd160_lanes.h"
+
+#define RIPEMD160_LANES  16
+#define RIPEMD160_TARGET "avx512f"
+#define RIPEMD160_KERNEL ripemd160_transform_x16
+#define RIPEMD160_VEC    ripemd160_vec16
+#include "ripemd160_lanes.h"
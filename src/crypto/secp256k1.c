@@ -0,0 +1,527 @@
+#include <string.h>
+#include <pthread.h>
+#include "internal/crypto/random.h"
+#include "internal/crypto/secp256k1.h"
+#include "uint256_impl.h"
+
+#define ECMULT_WINDOW_BITS 4
+#define ECMULT_WINDOWS     (256 / ECMULT_WINDOW_BITS)
+#define ECMULT_ENTRIES     ((1 << ECMULT_WINDOW_BITS) - 1) // Digit 0 is not stored.
+
+const AffinePoint secp256k1_g = {
+	{{0x59f2815b16f81798ULL, 0x029bfcdb2dce28d9ULL, 0x55a06295ce870b07ULL, 0x79be667ef9dcbbacULL}},
+	{{0x9c47d08ffb10d4b8ULL, 0xfd17b448a6855419ULL, 0x5da4fbfc0e1108a8ULL, 0x483ada7726a3c465ULL}},
+};
+
+/******************** Field arithmetic ********************/
+void secp256k1_fe_set_bytes(FieldElement *r, const byte *bytes)
+{
+	u256_set_bytes(r, bytes);
+	u256_mod_p(r, r);
+}
+
+void secp256k1_fe_get_bytes(const FieldElement *a, byte *bytes)
+{
+	u256_get_bytes(a, bytes);
+}
+
+void secp256k1_fe_add(FieldElement *r, const FieldElement *a, const FieldElement *b)
+{
+	u256_add_mod_p(r, a, b);
+}
+
+void secp256k1_fe_sub(FieldElement *r, const FieldElement *a, const FieldElement *b)
+{
+	u256_sub_mod_p(r, a, b);
+}
+
+void secp256k1_fe_mul(FieldElement *r, const FieldElement *a, const FieldElement *b)
+{
+	u256_mul_mod_p(r, a, b);
+}
+
+void secp256k1_fe_sqr(FieldElement *r, const FieldElement *a)
+{
+	Uint512 t;
+	u256_sqr(&t, a);
+	u256_reduce_p(r, &t);
+}
+
+static void fe_sqr_n(FieldElement *r, const FieldElement *a, uint16_t n)
+{
+	*r = *a;
+	while (n--)
+		secp256k1_fe_sqr(r, r);
+}
+
+// a^(p-2), the addition chain follows the runs of ones in p - 2.
+void secp256k1_fe_inv(FieldElement *r, const FieldElement *a)
+{
+	FieldElement x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t;
+
+	secp256k1_fe_sqr(&x2, a);        secp256k1_fe_mul(&x2, &x2, a);
+	secp256k1_fe_sqr(&x3, &x2);      secp256k1_fe_mul(&x3, &x3, a);
+	fe_sqr_n(&x6, &x3, 3);           secp256k1_fe_mul(&x6, &x6, &x3);
+	fe_sqr_n(&x9, &x6, 3);           secp256k1_fe_mul(&x9, &x9, &x3);
+	fe_sqr_n(&x11, &x9, 2);          secp256k1_fe_mul(&x11, &x11, &x2);
+	fe_sqr_n(&x22, &x11, 11);        secp256k1_fe_mul(&x22, &x22, &x11);
+	fe_sqr_n(&x44, &x22, 22);        secp256k1_fe_mul(&x44, &x44, &x22);
+	fe_sqr_n(&x88, &x44, 44);        secp256k1_fe_mul(&x88, &x88, &x44);
+	fe_sqr_n(&x176, &x88, 88);       secp256k1_fe_mul(&x176, &x176, &x88);
+	fe_sqr_n(&x220, &x176, 44);      secp256k1_fe_mul(&x220, &x220, &x44);
+	fe_sqr_n(&x223, &x220, 3);       secp256k1_fe_mul(&x223, &x223, &x3);
+
+	fe_sqr_n(&t, &x223, 23);         secp256k1_fe_mul(&t, &t, &x22);
+	fe_sqr_n(&t, &t, 5);             secp256k1_fe_mul(&t, &t, a);
+	fe_sqr_n(&t, &t, 3);             secp256k1_fe_mul(&t, &t, &x2);
+	fe_sqr_n(&t, &t, 2);             secp256k1_fe_mul(r, &t, a);
+}
+
+// Montgomery's trick, r[i] = 1 / a[i] with one inversion. The prefix products live in r until overwritten.
+void secp256k1_fe_inv_batch(FieldElement *r, const FieldElement *a, size_t count)
+{
+	FieldElement inv, t;
+
+	if (count == 0)
+		return;
+
+	r[0] = a[0];
+	for (size_t i = 1; i < count; ++i)
+		secp256k1_fe_mul(&r[i], &r[i - 1], &a[i]);
+
+	secp256k1_fe_inv(&inv, &r[count - 1]);
+	for (size_t i = count - 1; i > 0; --i)
+	{
+		secp256k1_fe_mul(&t, &inv, &r[i - 1]);
+		secp256k1_fe_mul(&inv, &inv, &a[i]);
+		r[i] = t;
+	}
+	r[0] = inv;
+}
+
+static bool fe_is_zero(const FieldElement *a)
+{
+	return (a->n[0] | a->n[1] | a->n[2] | a->n[3]) == 0;
+}
+
+static void fe_cmov(FieldElement *r, const FieldElement *a, uint64_t mask)
+{
+	for (uint8_t i = 0; i < 4; ++i)
+		r->n[i] = (a->n[i] & mask) | (r->n[i] & ~mask);
+}
+
+/******************** Group arithmetic ********************/
+// dbl-2009-l, a = 0.
+void secp256k1_gej_double(JacobianPoint *r, const JacobianPoint *a)
+{
+	FieldElement A, B, C, D, E, F, t;
+
+	if (a->infinity)
+	{
+		r->infinity = true;
+		return;
+	}
+
+	secp256k1_fe_mul(&r->z, &a->y, &a->z);
+	secp256k1_fe_add(&r->z, &r->z, &r->z);          // Z3 = 2 * Y1 * Z1
+	secp256k1_fe_sqr(&A, &a->x);
+	secp256k1_fe_sqr(&B, &a->y);
+	secp256k1_fe_sqr(&C, &B);
+	secp256k1_fe_add(&t, &a->x, &B);
+	secp256k1_fe_sqr(&t, &t);
+	secp256k1_fe_sub(&t, &t, &A);
+	secp256k1_fe_sub(&t, &t, &C);
+	secp256k1_fe_add(&D, &t, &t);                   // D = 2 * ((X1 + B)^2 - A - C)
+	secp256k1_fe_add(&E, &A, &A);
+	secp256k1_fe_add(&E, &E, &A);                   // E = 3 * A
+	secp256k1_fe_sqr(&F, &E);
+	secp256k1_fe_sub(&r->x, &F, &D);
+	secp256k1_fe_sub(&r->x, &r->x, &D);             // X3 = F - 2 * D
+	secp256k1_fe_sub(&t, &D, &r->x);
+	secp256k1_fe_mul(&t, &E, &t);
+	secp256k1_fe_add(&C, &C, &C);
+	secp256k1_fe_add(&C, &C, &C);
+	secp256k1_fe_add(&C, &C, &C);
+	secp256k1_fe_sub(&r->y, &t, &C);                // Y3 = E * (D - X3) - 8 * C
+	r->infinity = false;
+}
+
+// Shared tail of the additions: X3 = R^2 - H^3 - 2 * U1 * H^2, Y3 = R * (U1 * H^2 - X3) - S1 * H^3.
+static void gej_add_tail(JacobianPoint *r, const FieldElement *u1, const FieldElement *s1,
+	const FieldElement *h, const FieldElement *R)
+{
+	FieldElement h2, h3, v, t;
+
+	secp256k1_fe_sqr(&h2, h);
+	secp256k1_fe_mul(&h3, &h2, h);
+	secp256k1_fe_mul(&v, u1, &h2);
+	secp256k1_fe_sqr(&r->x, R);
+	secp256k1_fe_sub(&r->x, &r->x, &h3);
+	secp256k1_fe_sub(&r->x, &r->x, &v);
+	secp256k1_fe_sub(&r->x, &r->x, &v);
+	secp256k1_fe_sub(&t, &v, &r->x);
+	secp256k1_fe_mul(&t, &t, R);
+	secp256k1_fe_mul(&h3, &h3, s1);
+	secp256k1_fe_sub(&r->y, &t, &h3);
+	r->infinity = false;
+}
+
+void secp256k1_gej_add(JacobianPoint *r, const JacobianPoint *a, const JacobianPoint *b)
+{
+	FieldElement z1z1, z2z2, u1, u2, s1, s2, h, R;
+
+	if (a->infinity) { *r = *b; return; }
+	if (b->infinity) { *r = *a; return; }
+
+	secp256k1_fe_sqr(&z1z1, &a->z);
+	secp256k1_fe_sqr(&z2z2, &b->z);
+	secp256k1_fe_mul(&u1, &a->x, &z2z2);
+	secp256k1_fe_mul(&u2, &b->x, &z1z1);
+	secp256k1_fe_mul(&s1, &a->y, &z2z2);
+	secp256k1_fe_mul(&s1, &s1, &b->z);
+	secp256k1_fe_mul(&s2, &b->y, &z1z1);
+	secp256k1_fe_mul(&s2, &s2, &a->z);
+	secp256k1_fe_sub(&h, &u2, &u1);
+	secp256k1_fe_sub(&R, &s2, &s1);
+	if (fe_is_zero(&h))
+	{
+		if (fe_is_zero(&R))
+			secp256k1_gej_double(r, a);
+		else
+			r->infinity = true;
+		return;
+	}
+
+	secp256k1_fe_mul(&r->z, &a->z, &b->z);
+	secp256k1_fe_mul(&r->z, &r->z, &h);
+	gej_add_tail(r, &u1, &s1, &h, &R);
+}
+
+void secp256k1_gej_add_ge(JacobianPoint *r, const JacobianPoint *a, const AffinePoint *b)
+{
+	FieldElement z1z1, u2, s2, h, R, x1, y1;
+
+	if (a->infinity)
+	{
+		r->x = b->x; r->y = b->y;
+		memset(&r->z, 0, sizeof(FieldElement));
+		r->z.n[0] = 1;
+		r->infinity = false;
+		return;
+	}
+
+	secp256k1_fe_sqr(&z1z1, &a->z);
+	secp256k1_fe_mul(&u2, &b->x, &z1z1);
+	secp256k1_fe_mul(&s2, &b->y, &z1z1);
+	secp256k1_fe_mul(&s2, &s2, &a->z);
+	secp256k1_fe_sub(&h, &u2, &a->x);
+	secp256k1_fe_sub(&R, &s2, &a->y);
+	if (fe_is_zero(&h))
+	{
+		if (fe_is_zero(&R))
+			secp256k1_gej_double(r, a);
+		else
+			r->infinity = true;
+		return;
+	}
+
+	x1 = a->x; y1 = a->y;
+	secp256k1_fe_mul(&r->z, &a->z, &h);
+	gej_add_tail(r, &x1, &y1, &h, &R);
+}
+
+void secp256k1_ge_set_gej(AffinePoint *r, const JacobianPoint *a)
+{
+	FieldElement zinv, zinv2;
+
+	secp256k1_fe_inv(&zinv, &a->z);
+	secp256k1_fe_sqr(&zinv2, &zinv);
+	secp256k1_fe_mul(&r->x, &a->x, &zinv2);
+	secp256k1_fe_mul(&zinv2, &zinv2, &zinv);
+	secp256k1_fe_mul(&r->y, &a->y, &zinv2);
+}
+
+// Montgomery's trick, one inversion for all the points. The prefix products live in r[i].x until
+// r[i] is written, points at infinity count as z = 1 and come out zeroed.
+void secp256k1_ge_set_gej_batch(AffinePoint *r, const JacobianPoint *a, size_t count)
+{
+	FieldElement one = {{1, 0, 0, 0}}, inv, zinv, zinv2;
+
+	if (count == 0)
+		return;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const FieldElement *z = a[i].infinity ? &one : &a[i].z;
+		if (i == 0)
+			r[0].x = *z;
+		else
+			secp256k1_fe_mul(&r[i].x, &r[i - 1].x, z);
+	}
+
+	secp256k1_fe_inv(&inv, &r[count - 1].x);
+	for (size_t i = count; i-- > 0;)
+	{
+		if (i > 0)
+			secp256k1_fe_mul(&zinv, &inv, &r[i - 1].x);
+		else
+			zinv = inv;
+
+		if (a[i].infinity)
+		{
+			memset(&r[i], 0, sizeof(AffinePoint));
+			continue;
+		}
+		secp256k1_fe_mul(&inv, &inv, &a[i].z);
+		secp256k1_fe_sqr(&zinv2, &zinv);
+		secp256k1_fe_mul(&r[i].x, &a[i].x, &zinv2);
+		secp256k1_fe_mul(&zinv2, &zinv2, &zinv);
+		secp256k1_fe_mul(&r[i].y, &a[i].y, &zinv2);
+	}
+}
+
+void secp256k1_ge_serialize(const AffinePoint *a, byte *pub, bool compress)
+{
+	if (compress)
+	{
+		pub[0] = 0x02 | (a->y.n[0] & 1);
+		secp256k1_fe_get_bytes(&a->x, pub + 1);
+	}
+	else
+	{
+		pub[0] = 0x04;
+		secp256k1_fe_get_bytes(&a->x, pub + 1);
+		secp256k1_fe_get_bytes(&a->y, pub + 33);
+	}
+}
+
+/******************** Generator multiplication ********************/
+// table[i][d - 1] = d * 16^i * G, built on the first call.
+static AffinePoint ecmult_table[ECMULT_WINDOWS][ECMULT_ENTRIES];
+static pthread_once_t ecmult_table_once = PTHREAD_ONCE_INIT;
+
+static void ecmult_table_build(void)
+{
+	JacobianPoint base, entries[ECMULT_ENTRIES];
+
+	base.x = secp256k1_g.x; base.y = secp256k1_g.y;
+	memset(&base.z, 0, sizeof(FieldElement));
+	base.z.n[0] = 1;
+	base.infinity = false;
+
+	for (uint16_t i = 0; i < ECMULT_WINDOWS; ++i)
+	{
+		entries[0] = base;
+		secp256k1_gej_double(&entries[1], &base);
+		for (uint8_t d = 2; d < ECMULT_ENTRIES; ++d)
+			secp256k1_gej_add(&entries[d], &entries[d - 1], &base);
+		secp256k1_ge_set_gej_batch(ecmult_table[i], entries, ECMULT_ENTRIES);
+
+		// Next window's base, 16 * base = 2 * (15 * base + base).
+		secp256k1_gej_add(&base, &entries[ECMULT_ENTRIES - 1], &base);
+	}
+}
+
+bool secp256k1_seckey_verify(const byte *seckey)
+{
+	Uint256 k, t;
+
+	u256_set_bytes(&k, seckey);
+	// k < n if k - n borrows.
+	return !u256_is_zero(&k) & (bool)u256_sub(&t, &k, &uint256_n);
+}
+
+Status secp256k1_seckey_generate(byte *seckeys, size_t count)
+{
+	if (random_bytes(seckeys, count * 32) != SUCCEEDED)
+		return FAILED;
+
+	// Redraw the keys outside [1, n-1], about one in 2^128.
+	for (size_t i = 0; i < count; ++i)
+	{
+		while (!secp256k1_seckey_verify(seckeys + i * 32))
+		{
+			if (random_bytes(seckeys + i * 32, 32) != SUCCEEDED)
+				return FAILED;
+		}
+	}
+	return SUCCEEDED;
+}
+
+uint64_t secp256k1_seckey_room(const byte *seckey)
+{
+	Uint256 k, d, one;
+
+	u256_set_bytes(&k, seckey);
+	u256_set_u64(&one, 1);
+	// n - 1 - k.
+	if (u256_sub(&d, &uint256_n, &k) | u256_sub(&d, &d, &one))
+		return 0;
+	return (d.n[1] | d.n[2] | d.n[3]) ? UINT64_MAX : d.n[0];
+}
+
+void secp256k1_seckey_add(byte *seckey, uint64_t v)
+{
+	Uint256 k, t;
+
+	u256_set_bytes(&k, seckey);
+	u256_set_u64(&t, v);
+	u256_add(&k, &k, &t);
+	u256_get_bytes(&k, seckey);
+}
+
+void secp256k1_ecmult_gen(JacobianPoint *r, const byte *seckey)
+{
+	JacobianPoint sum;
+	AffinePoint entry;
+	FieldElement one = {{1, 0, 0, 0}};
+	uint64_t infinity = -1ULL;
+
+	pthread_once(&ecmult_table_once, ecmult_table_build);
+	memset(r, 0, sizeof(JacobianPoint));
+
+	for (uint16_t i = 0; i < ECMULT_WINDOWS; ++i)
+	{
+		byte digit = (seckey[31 - i / 2] >> ((i & 1) * 4)) & 0x0f;
+		uint64_t zero = -(uint64_t)(digit == 0);
+
+		// Read every entry of the window, keep the one of this digit.
+		memset(&entry, 0, sizeof(AffinePoint));
+		for (uint8_t d = 0; d < ECMULT_ENTRIES; ++d)
+		{
+			uint64_t hit = -(uint64_t)(d + 1 == digit);
+			fe_cmov(&entry.x, &ecmult_table[i][d].x, hit);
+			fe_cmov(&entry.y, &ecmult_table[i][d].y, hit);
+		}
+
+		// r + entry never doubles or cancels for scalars below n, so no special cases.
+		FieldElement z1z1, u2, s2, h, R;
+		secp256k1_fe_sqr(&z1z1, &r->z);
+		secp256k1_fe_mul(&u2, &entry.x, &z1z1);
+		secp256k1_fe_mul(&s2, &entry.y, &z1z1);
+		secp256k1_fe_mul(&s2, &s2, &r->z);
+		secp256k1_fe_sub(&h, &u2, &r->x);
+		secp256k1_fe_sub(&R, &s2, &r->y);
+		secp256k1_fe_mul(&sum.z, &r->z, &h);
+		gej_add_tail(&sum, &r->x, &r->y, &h, &R);
+
+		// The first non-zero digit takes the entry as is, a zero digit keeps r.
+		fe_cmov(&sum.x, &entry.x, infinity);
+		fe_cmov(&sum.y, &entry.y, infinity);
+		fe_cmov(&sum.z, &one, infinity);
+		fe_cmov(&r->x, &sum.x, ~zero);
+		fe_cmov(&r->y, &sum.y, ~zero);
+		fe_cmov(&r->z, &sum.z, ~zero);
+		infinity &= zero;
+	}
+	r->infinity = infinity != 0;
+}
+
+Status secp256k1_pubkey_create(const byte *seckey, byte *pub, bool compress)
+{
+	JacobianPoint point;
+	AffinePoint affine;
+
+	if (!secp256k1_seckey_verify(seckey))
+		return FAILED;
+
+	secp256k1_ecmult_gen(&point, seckey);
+	secp256k1_ge_set_gej(&affine, &point);
+	secp256k1_ge_serialize(&affine, pub, compress);
+	return SUCCEEDED;
+}
+
+size_t secp256k1_pubkey_create_batch(const byte *seckeys, size_t count, byte *pubs, bool compress, Status *statuses)
+{
+	JacobianPoint points[SECP256K1_BATCH_SIZE];
+	AffinePoint affines[SECP256K1_BATCH_SIZE];
+	size_t pub_len = compress ? 33 : 65, valid = 0;
+
+	for (size_t start = 0; start < count; start += SECP256K1_BATCH_SIZE)
+	{
+		size_t block = count - start < SECP256K1_BATCH_SIZE ? count - start : SECP256K1_BATCH_SIZE;
+
+		for (size_t i = 0; i < block; ++i)
+		{
+			const byte *seckey = seckeys + (start + i) * 32;
+			if (secp256k1_seckey_verify(seckey))
+			{
+				secp256k1_ecmult_gen(&points[i], seckey);
+				statuses[start + i] = SUCCEEDED;
+				valid++;
+			}
+			else
+			{
+				points[i].infinity = true;
+				statuses[start + i] = FAILED;
+			}
+		}
+
+		secp256k1_ge_set_gej_batch(affines, points, block);
+		for (size_t i = 0; i < block; ++i)
+		{
+			if (points[i].infinity)
+				memset(pubs + (start + i) * pub_len, 0, pub_len);
+			else
+				secp256k1_ge_serialize(&affines[i], pubs + (start + i) * pub_len, compress);
+		}
+	}
+	return valid;
+}
+
+/******************** Consecutive multiples ********************/
+// g_multiples[j] = (j + 1) * G, built on the first call.
+static AffinePoint g_multiples[SECP256K1_BATCH_SIZE];
+static pthread_once_t g_multiples_once = PTHREAD_ONCE_INIT;
+
+static void g_multiples_build(void)
+{
+	JacobianPoint points[SECP256K1_BATCH_SIZE];
+
+	points[0].x = secp256k1_g.x; points[0].y = secp256k1_g.y;
+	memset(&points[0].z, 0, sizeof(FieldElement));
+	points[0].z.n[0] = 1;
+	points[0].infinity = false;
+	for (uint16_t j = 1; j < SECP256K1_BATCH_SIZE; ++j)
+		secp256k1_gej_add_ge(&points[j], &points[j - 1], &secp256k1_g);
+	secp256k1_ge_set_gej_batch(g_multiples, points, SECP256K1_BATCH_SIZE);
+}
+
+void secp256k1_ge_add_g_multiples(AffinePoint *r, const AffinePoint *p, size_t count)
+{
+	FieldElement dx[SECP256K1_BATCH_SIZE], inv[SECP256K1_BATCH_SIZE], lambda, t;
+
+	pthread_once(&g_multiples_once, g_multiples_build);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		secp256k1_fe_sub(&dx[i], &g_multiples[i].x, &p->x);
+		if (fe_is_zero(&dx[i]))
+		{
+			// p is +-(i + 1) * G, only for scalars next to 0 or n, take the general additions.
+			JacobianPoint points[SECP256K1_BATCH_SIZE], pj;
+			pj.x = p->x; pj.y = p->y;
+			memset(&pj.z, 0, sizeof(FieldElement));
+			pj.z.n[0] = 1;
+			pj.infinity = false;
+			for (size_t j = 0; j < count; ++j)
+				secp256k1_gej_add_ge(&points[j], &pj, &g_multiples[j]);
+			secp256k1_ge_set_gej_batch(r, points, count);
+			return;
+		}
+	}
+	secp256k1_fe_inv_batch(inv, dx, count);
+
+	// Affine addition, lambda = (y2 - y1) / (x2 - x1), x3 = lambda^2 - x1 - x2, y3 = lambda * (x1 - x3) - y1.
+	for (size_t i = 0; i < count; ++i)
+	{
+		secp256k1_fe_sub(&lambda, &g_multiples[i].y, &p->y);
+		secp256k1_fe_mul(&lambda, &lambda, &inv[i]);
+		secp256k1_fe_sqr(&t, &lambda);
+		secp256k1_fe_sub(&t, &t, &p->x);
+		secp256k1_fe_sub(&r[i].x, &t, &g_multiples[i].x);
+		secp256k1_fe_sub(&t, &p->x, &r[i].x);
+		secp256k1_fe_mul(&t, &t, &lambda);
+		secp256k1_fe_sub(&r[i].y, &t, &p->y);
+	}
+}
@@ -0,0 +1,223 @@
+#include <string.h>
+#include <cpuid.h>
+#include "internal/crypto/sha256.h"
+
+const uint32_t sha256_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+const uint32_t sha256_iv[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+#define ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define LOAD32_BE(p) (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | ((uint32_t)(p)[2] << 8) | (p)[3])
+
+// One round, the caller rotates the variable names instead of moving the values.
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i) \
+	t1 = h + (ROR32(e, 6) ^ ROR32(e, 11) ^ ROR32(e, 25)) + (g ^ (e & (f ^ g))) + sha256_k[i] + w[i]; \
+	d += t1; \
+	h = t1 + (ROR32(a, 2) ^ ROR32(a, 13) ^ ROR32(a, 22)) + ((a & b) | (c & (a | b)));
+
+void sha256_transform_scalar(uint32_t *state, const byte *blocks, size_t nblocks)
+{
+	uint32_t w[64], t1;
+
+	for (size_t n = 0; n < nblocks; ++n, blocks += 64)
+	{
+		for (uint8_t i = 0; i < 16; ++i)
+			w[i] = LOAD32_BE(blocks + i * 4);
+		for (uint8_t i = 16; i < 64; ++i)
+		{
+			uint32_t s0 = ROR32(w[i-15], 7) ^ ROR32(w[i-15], 18) ^ (w[i-15] >> 3);
+			uint32_t s1 = ROR32(w[i-2], 17) ^ ROR32(w[i-2], 19) ^ (w[i-2] >> 10);
+			w[i] = w[i-16] + s0 + w[i-7] + s1;
+		}
+
+		uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+		uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+		for (uint8_t i = 0; i < 64; i += 8)
+		{
+			SHA256_ROUND(a, b, c, d, e, f, g, h, i);
+			SHA256_ROUND(h, a, b, c, d, e, f, g, i + 1);
+			SHA256_ROUND(g, h, a, b, c, d, e, f, i + 2);
+			SHA256_ROUND(f, g, h, a, b, c, d, e, i + 3);
+			SHA256_ROUND(e, f, g, h, a, b, c, d, i + 4);
+			SHA256_ROUND(d, e, f, g, h, a, b, c, i + 5);
+			SHA256_ROUND(c, d, e, f, g, h, a, b, i + 6);
+			SHA256_ROUND(b, c, d, e, f, g, h, a, i + 7);
+		}
+		state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+		state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+	}
+}
+
+/******************** Kernel selection ********************/
+static SHA256_IMPL selected = SHA256_AUTO;
+static void (*transform)(uint32_t *, const byte *, size_t) = &sha256_transform_scalar;
+static uint8_t lanes = 1; // Widest multi-lane kernel in use, 1 if none.
+
+static bool cpu_supports(SHA256_IMPL impl)
+{
+	uint32_t eax, ebx, ecx, edx;
+
+	__builtin_cpu_init();
+	switch (impl)
+	{
+		case SHA256_SCALAR: return true;
+		case SHA256_SSE41:  return __builtin_cpu_supports("sse4.1");
+		case SHA256_AVX2:   return __builtin_cpu_supports("avx2");
+		case SHA256_AVX512: return __builtin_cpu_supports("avx512f");
+		case SHA256_SHANI:
+		{
+			// CPUID.(EAX=07H, ECX=0):EBX.SHA[bit 29]
+			if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+				return false;
+			return (ebx >> 29) & 1 && __builtin_cpu_supports("sse4.1");
+		}
+		default: return false;
+	}
+}
+
+Status sha256_select(SHA256_IMPL impl)
+{
+	if (impl == SHA256_AUTO)
+	{
+		// SHA-NI beats the scalar kernel for single messages,
+		// the widest SIMD kernel is used for the batches.
+		transform = cpu_supports(SHA256_SHANI) ? &sha256_transform_shani : &sha256_transform_scalar;
+		lanes = cpu_supports(SHA256_AVX512) ? 16 : cpu_supports(SHA256_AVX2) ? 8 : cpu_supports(SHA256_SSE41) ? 4 : 1;
+		selected = SHA256_AUTO;
+		return SUCCEEDED;
+	}
+	if (!cpu_supports(impl))
+		return FAILED;
+
+	transform = impl == SHA256_SHANI ? &sha256_transform_shani : &sha256_transform_scalar;
+	switch (impl)
+	{
+		case SHA256_SSE41:  lanes = 4;  break;
+		case SHA256_AVX2:   lanes = 8;  break;
+		case SHA256_AVX512: lanes = 16; break;
+		default:            lanes = 1;  break;
+	}
+	selected = impl;
+	return SUCCEEDED;
+}
+
+SHA256_IMPL sha256_selected(void)
+{
+	return selected;
+}
+
+// Select the kernels once when the library is loaded.
+__attribute__((constructor)) static void sha256_init(void)
+{
+	sha256_select(SHA256_AUTO);
+}
+
+/******************** Hash functions ********************/
+static void store_digest(const uint32_t *state, byte *digest)
+{
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		digest[i*4]   = state[i] >> 24;
+		digest[i*4+1] = state[i] >> 16;
+		digest[i*4+2] = state[i] >> 8;
+		digest[i*4+3] = state[i];
+	}
+}
+
+// Build the padded tail of a message, return how many blocks (1 or 2).
+static uint8_t pad_tail(const byte *tail, size_t tail_len, size_t len, byte *blocks)
+{
+	uint8_t nblocks = tail_len < 56 ? 1 : 2;
+	uint64_t bits = (uint64_t)len * 8;
+
+	memcpy(blocks, tail, tail_len);
+	blocks[tail_len] = 0x80;
+	memset(blocks + tail_len + 1, 0, nblocks * 64 - tail_len - 1);
+	for (uint8_t i = 0; i < 8; ++i)
+		blocks[nblocks * 64 - 1 - i] = bits >> (i * 8);
+	return nblocks;
+}
+
+void sha256(const byte *data, size_t len, byte *digest)
+{
+	uint32_t state[8];
+	byte tail[128];
+
+	memcpy(state, sha256_iv, sizeof(state));
+	transform(state, data, len / 64);
+	transform(state, tail, pad_tail(data + len / 64 * 64, len % 64, len, tail));
+	store_digest(state, digest);
+}
+
+void sha256d(const byte *data, size_t len, byte *digest)
+{
+	byte first[32];
+	sha256(data, len, first);
+	sha256(first, 32, digest);
+}
+
+// Hash 'n' (<= 16) messages side by side with the n-lane kernel.
+static void sha256_lanes(const byte *data, size_t stride, size_t len, uint8_t n, byte *digests)
+{
+	uint32_t state[8 * 16];
+	byte tails[16][128];
+	const byte *blocks[16];
+	size_t full = len / 64;
+	uint8_t tail_blocks = 0;
+
+	for (uint8_t i = 0; i < 8; ++i)
+		for (uint8_t j = 0; j < n; ++j)
+			state[i * n + j] = sha256_iv[i];
+	for (uint8_t j = 0; j < n; ++j)
+		tail_blocks = pad_tail(data + j * stride + full * 64, len % 64, len, tails[j]);
+
+	for (size_t b = 0; b < full + tail_blocks; ++b)
+	{
+		for (uint8_t j = 0; j < n; ++j)
+			blocks[j] = b < full ? data + j * stride + b * 64 : tails[j] + (b - full) * 64;
+		switch (n)
+		{
+			case 4:  sha256_transform_x4(state, blocks);  break;
+			case 8:  sha256_transform_x8(state, blocks);  break;
+			case 16: sha256_transform_x16(state, blocks); break;
+		}
+	}
+
+	for (uint8_t j = 0; j < n; ++j)
+	{
+		uint32_t lane[8];
+		for (uint8_t i = 0; i < 8; ++i)
+			lane[i] = state[i * n + j];
+		store_digest(lane, digests + j * 32);
+	}
+}
+
+void sha256_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests)
+{
+	size_t i = 0;
+
+	for (uint8_t n = lanes; n >= 4; n /= 2)
+	{
+		for ( ; count - i >= n; i += n)
+			sha256_lanes(data + i * stride, stride, len, n, digests + i * 32);
+	}
+	for ( ; i < count; ++i)
+		sha256(data + i * stride, len, digests + i * 32);
+}
+
+void sha256d_batch(const byte *data, size_t stride, size_t len, size_t count, byte *digests)
+{
+	sha256_batch(data, stride, len, count, digests);
+	sha256_batch(digests, 32, 32, count, digests);
+}
@@ -0,0 +1,69 @@
+/*
+*  Multi-lane SHA-256 kernel template, included by sha256_x86.c once per lane count.
+*  Each vector holds the same state word (or message word) of SHA256_LANES messages.
+*  Define before including:
+*    SHA256_LANES   Number of messages hashed side by side (4, 8 or 16).
+*    SHA256_TARGET  The target attribute for the kernel, e.g. "avx2".
+*    SHA256_KERNEL  Name of the kernel function.
+*    SHA256_VEC     Name of the vector type.
+*/
+typedef uint32_t SHA256_VEC __attribute__((vector_size(SHA256_LANES * 4)));
+
+__attribute__((target(SHA256_TARGET)))
+void SHA256_KERNEL(uint32_t *state, const byte **blocks)
+{
+	SHA256_VEC w[64], t1;
+	uint32_t words[16][SHA256_LANES] __attribute__((aligned(64)));
+
+	// Transpose: word i of every lane into one vector.
+	for (uint8_t j = 0; j < SHA256_LANES; ++j)
+	{
+		for (uint8_t i = 0; i < 16; ++i)
+		{
+			uint32_t word;
+			memcpy(&word, blocks[j] + i * 4, 4);
+			words[i][j] = __builtin_bswap32(word);
+		}
+	}
+	for (uint8_t i = 0; i < 16; ++i)
+		memcpy(&w[i], words[i], sizeof(SHA256_VEC));
+	for (uint8_t i = 16; i < 64; ++i)
+	{
+		SHA256_VEC s0 = VROR(w[i-15], 7) ^ VROR(w[i-15], 18) ^ (w[i-15] >> 3);
+		SHA256_VEC s1 = VROR(w[i-2], 17) ^ VROR(w[i-2], 19) ^ (w[i-2] >> 10);
+		w[i] = w[i-16] + s0 + w[i-7] + s1;
+	}
+
+	SHA256_VEC a, b, c, d, e, f, g, h;
+	memcpy(&a, state + 0 * SHA256_LANES, sizeof(SHA256_VEC));
+	memcpy(&b, state + 1 * SHA256_LANES, sizeof(SHA256_VEC));
+	memcpy(&c, state + 2 * SHA256_LANES, sizeof(SHA256_VEC));
+	memcpy(&d, state + 3 * SHA256_LANES, sizeof(SHA256_VEC));
+	memcpy(&e, state + 4 * SHA256_LANES, sizeof(SHA256_VEC));
+	memcpy(&f, state + 5 * SHA256_LANES, sizeof(SHA256_VEC));
+	memcpy(&g, state + 6 * SHA256_LANES, sizeof(SHA256_VEC));
+	memcpy(&h, state + 7 * SHA256_LANES, sizeof(SHA256_VEC));
+	SHA256_VEC s[8] = {a, b, c, d, e, f, g, h};
+
+	for (uint8_t i = 0; i < 64; i += 8)
+	{
+		VROUND(a, b, c, d, e, f, g, h, i);
+		VROUND(h, a, b, c, d, e, f, g, i + 1);
+		VROUND(g, h, a, b, c, d, e, f, i + 2);
+		VROUND(f, g, h, a, b, c, d, e, i + 3);
+		VROUND(e, f, g, h, a, b, c, d, i + 4);
+		VROUND(d, e, f, g, h, a, b, c, i + 5);
+		VROUND(c, d, e, f, g, h, a, b, i + 6);
+		VROUND(b, c, d, e, f, g, h, a, i + 7);
+	}
+
+	s[0] += a; s[1] += b; s[2] += c; s[3] += d;
+	s[4] += e; s[5] += f; s[6] += g; s[7] += h;
+	for (uint8_t i = 0; i < 8; ++i)
+		memcpy(state + i * SHA256_LANES, &s[i], sizeof(SHA256_VEC));
+}
+
+#undef SHA256_LANES
+#undef SHA256_TARGET
+#undef SHA256_KERNEL
+#undef SHA256_VEC
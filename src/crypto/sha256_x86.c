@@ -0,0 +1,93 @@
+#include <string.h>
+#include <immintrin.h>
+#include "internal/crypto/sha256.h"
+
+/******************** SSE4.1 / AVX2 / AVX-512 ********************/
+#define VROR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define VROUND(a, b, c, d, e, f, g, h, i) \
+	t1 = h + (VROR(e, 6) ^ VROR(e, 11) ^ VROR(e, 25)) + (g ^ (e & (f ^ g))) + sha256_k[i] + w[i]; \
+	d += t1; \
+	h = t1 + (VROR(a, 2) ^ VROR(a, 13) ^ VROR(a, 22)) + ((a & b) | (c & (a | b)));
+
+#define SHA256_LANES  4
+#define SHA256_TARGET "sse4.1"
+#define SHA256_KERNEL sha256_transform_x4
+#define SHA256_VEC    sha256_vec4
+#include "sha256_lanes.h"
+
+#define SHA256_LANES  8
+#define SHA256_TARGET "avx2"
+#define SHA256_KERNEL sha256_transform_x8
+#define SHA256_VEC    sha256_vec8
+#include "sha256_lanes.h"
+
+#define SHA256_LANES  16
+#define SHA256_TARGET "avx512f"
+#define SHA256_KERNEL sha256_transform_x16
+#define SHA256_VEC    sha256_vec16
+#include "sha256_lanes.h"
+
+/******************** SHA-NI ********************/
+// Four rounds on message words 'm', 'k' is the index of the first round.
+#define SHANI_ROUNDS(m, k) \
+	msg = _mm_add_epi32((m), _mm_loadu_si128((const __m128i *)(sha256_k + (k)))); \
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+	msg = _mm_shuffle_epi32(msg, 0x0E); \
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+// Complete the message words 'next' from 'prev' and 'cur'.
+#define SHANI_SCHEDULE(next, prev, cur) \
+	next = _mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4)); \
+	next = _mm_sha256msg2_epu32(next, cur);
+
+__attribute__((target("sha,sse4.1")))
+void sha256_transform_shani(uint32_t *state, const byte *blocks, size_t nblocks)
+{
+	const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i state0, state1, msg, tmp;
+	__m128i m0, m1, m2, m3;
+
+	// Reorder the state to ABEF / CDGH for the sha256rnds2 instruction.
+	tmp    = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)state), 0xB1);
+	state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(state + 4)), 0x1B);
+	state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+	for (size_t n = 0; n < nblocks; ++n, blocks += 64)
+	{
+		__m128i abef = state0, cdgh = state1;
+
+		m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)blocks), mask);
+		m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16)), mask);
+		m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 32)), mask);
+		m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 48)), mask);
+
+		SHANI_ROUNDS(m0, 0);
+		SHANI_ROUNDS(m1, 4);  m0 = _mm_sha256msg1_epu32(m0, m1);
+		SHANI_ROUNDS(m2, 8);  m1 = _mm_sha256msg1_epu32(m1, m2);
+		SHANI_ROUNDS(m3, 12); SHANI_SCHEDULE(m0, m2, m3); m2 = _mm_sha256msg1_epu32(m2, m3);
+		SHANI_ROUNDS(m0, 16); SHANI_SCHEDULE(m1, m3, m0); m3 = _mm_sha256msg1_epu32(m3, m0);
+		SHANI_ROUNDS(m1, 20); SHANI_SCHEDULE(m2, m0, m1); m0 = _mm_sha256msg1_epu32(m0, m1);
+		SHANI_ROUNDS(m2, 24); SHANI_SCHEDULE(m3, m1, m2); m1 = _mm_sha256msg1_epu32(m1, m2);
+		SHANI_ROUNDS(m3, 28); SHANI_SCHEDULE(m0, m2, m3); m2 = _mm_sha256msg1_epu32(m2, m3);
+		SHANI_ROUNDS(m0, 32); SHANI_SCHEDULE(m1, m3, m0); m3 = _mm_sha256msg1_epu32(m3, m0);
+		SHANI_ROUNDS(m1, 36); SHANI_SCHEDULE(m2, m0, m1); m0 = _mm_sha256msg1_epu32(m0, m1);
+		SHANI_ROUNDS(m2, 40); SHANI_SCHEDULE(m3, m1, m2); m1 = _mm_sha256msg1_epu32(m1, m2);
+		SHANI_ROUNDS(m3, 44); SHANI_SCHEDULE(m0, m2, m3); m2 = _mm_sha256msg1_epu32(m2, m3);
+		SHANI_ROUNDS(m0, 48); SHANI_SCHEDULE(m1, m3, m0); m3 = _mm_sha256msg1_epu32(m3, m0);
+		SHANI_ROUNDS(m1, 52); SHANI_SCHEDULE(m2, m0, m1);
+		SHANI_ROUNDS(m2, 56); SHANI_SCHEDULE(m3, m1, m2);
+		SHANI_ROUNDS(m3, 60);
+
+		state0 = _mm_add_epi32(state0, abef);
+		state1 = _mm_add_epi32(state1, cdgh);
+	}
+
+	// Back to ABCD / EFGH.
+	tmp    = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+	_mm_storeu_si128((__m128i *)state, state0);
+	_mm_storeu_si128((__m128i *)(state + 4), state1);
+}
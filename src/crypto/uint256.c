@@ -0,0 +1,104 @@
+#include "uint256_impl.h"
+
+const Uint256 uint256_p = {{
+	0xfffffffefffffc2fULL, 0xffffffffffffffffULL, 0xffffffffffffffffULL, 0xffffffffffffffffULL,
+}};
+
+const Uint256 uint256_n = {{
+	0xbfd25e8cd0364141ULL, 0xbaaedce6af48a03bULL, 0xfffffffffffffffeULL, 0xffffffffffffffffULL,
+}};
+
+void uint256_set_bytes(Uint256 *r, const byte *bytes)
+{
+	u256_set_bytes(r, bytes);
+}
+
+void uint256_get_bytes(const Uint256 *a, byte *bytes)
+{
+	u256_get_bytes(a, bytes);
+}
+
+void uint256_set_u64(Uint256 *r, uint64_t v)
+{
+	u256_set_u64(r, v);
+}
+
+bool uint256_is_zero(const Uint256 *a)
+{
+	return u256_is_zero(a);
+}
+
+int uint256_cmp(const Uint256 *a, const Uint256 *b)
+{
+	return u256_cmp(a, b);
+}
+
+uint64_t uint256_add(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	return u256_add(r, a, b);
+}
+
+uint64_t uint256_sub(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	return u256_sub(r, a, b);
+}
+
+void uint256_mul(Uint512 *r, const Uint256 *a, const Uint256 *b)
+{
+	u256_mul(r, a, b);
+}
+
+void uint256_sqr(Uint512 *r, const Uint256 *a)
+{
+	u256_sqr(r, a);
+}
+
+void uint256_reduce_p(Uint256 *r, const Uint512 *a)
+{
+	u256_reduce_p(r, a);
+}
+
+void uint256_reduce_n(Uint256 *r, const Uint512 *a)
+{
+	u256_reduce_n(r, a);
+}
+
+void uint256_mod_p(Uint256 *r, const Uint256 *a)
+{
+	u256_mod_p(r, a);
+}
+
+void uint256_mod_n(Uint256 *r, const Uint256 *a)
+{
+	u256_mod_n(r, a);
+}
+
+void uint256_add_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	u256_add_mod_p(r, a, b);
+}
+
+void uint256_sub_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	u256_sub_mod_p(r, a, b);
+}
+
+void uint256_mul_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	u256_mul_mod_p(r, a, b);
+}
+
+void uint256_add_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	u256_add_mod_n(r, a, b);
+}
+
+void uint256_sub_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	u256_sub_mod_n(r, a, b);
+}
+
+void uint256_mul_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	u256_mul_mod_n(r, a, b);
+}
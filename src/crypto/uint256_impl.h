@@ -0,0 +1,285 @@
+/*
+*  The uint256 arithmetic as static inline functions, included by uint256.c, which exports them,
+*  and by secp256k1.c, whose field and group code needs them inlined.
+*/
+#include "internal/crypto/uint256.h"
+
+typedef unsigned __int128 uint128_t;
+
+#define P_C 0x1000003d1ULL // 2^256 mod p
+
+// 2^256 - n, the top limb is 1.
+static const uint64_t n_c[3] = {0x402da1732fc9bebfULL, 0x4551231950b75fc4ULL, 0x0000000000000001ULL};
+
+/******************** Plain arithmetic ********************/
+static inline void u256_set_bytes(Uint256 *r, const byte *bytes)
+{
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		uint64_t v = 0;
+		for (uint8_t j = 0; j < 8; ++j)
+			v = (v << 8) | bytes[(3 - i) * 8 + j];
+		r->n[i] = v;
+	}
+}
+
+static inline void u256_get_bytes(const Uint256 *a, byte *bytes)
+{
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		for (uint8_t j = 0; j < 8; ++j)
+			bytes[(3 - i) * 8 + j] = a->n[i] >> (56 - j * 8);
+	}
+}
+
+static inline void u256_set_u64(Uint256 *r, uint64_t v)
+{
+	r->n[0] = v;
+	r->n[1] = r->n[2] = r->n[3] = 0;
+}
+
+static inline bool u256_is_zero(const Uint256 *a)
+{
+	return (a->n[0] | a->n[1] | a->n[2] | a->n[3]) == 0;
+}
+
+static inline uint64_t u256_add(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	uint128_t c = 0;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		c += (uint128_t)a->n[i] + b->n[i];
+		r->n[i] = (uint64_t)c;
+		c >>= 64;
+	}
+	return (uint64_t)c;
+}
+
+static inline uint64_t u256_sub(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	uint64_t borrow = 0;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		uint128_t d = (uint128_t)a->n[i] - b->n[i] - borrow;
+		r->n[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	return borrow;
+}
+
+static inline int u256_cmp(const Uint256 *a, const Uint256 *b)
+{
+	Uint256 t;
+	uint64_t lt = u256_sub(&t, a, b);
+	uint64_t gt = u256_sub(&t, b, a);
+	return (int)gt - (int)lt;
+}
+
+// Operand scanning, one row of the product per limb of 'a'.
+static inline void u256_mul(Uint512 *r, const Uint256 *a, const Uint256 *b)
+{
+	uint64_t t[8] = {0};
+
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		uint128_t c = 0;
+		for (uint8_t j = 0; j < 4; ++j)
+		{
+			c += (uint128_t)a->n[i] * b->n[j] + t[i + j];
+			t[i + j] = (uint64_t)c;
+			c >>= 64;
+		}
+		t[i + 4] = (uint64_t)c;
+	}
+	for (uint8_t i = 0; i < 8; ++i)
+		r->n[i] = t[i];
+}
+
+// The cross products once, doubled, then the squares on the diagonal.
+static inline void u256_sqr(Uint512 *r, const Uint256 *a)
+{
+	uint64_t t[8] = {0};
+	uint128_t c;
+
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		c = 0;
+		for (uint8_t j = i + 1; j < 4; ++j)
+		{
+			c += (uint128_t)a->n[i] * a->n[j] + t[i + j];
+			t[i + j] = (uint64_t)c;
+			c >>= 64;
+		}
+		t[i + 4] = (uint64_t)c;
+	}
+
+	uint64_t top = 0;
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		uint64_t v = t[i];
+		t[i] = (v << 1) | top;
+		top = v >> 63;
+	}
+
+	c = 0;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		uint128_t sq = (uint128_t)a->n[i] * a->n[i];
+		c += (uint128_t)t[2 * i] + (uint64_t)sq;
+		r->n[2 * i] = (uint64_t)c;
+		c >>= 64;
+		c += (uint128_t)t[2 * i + 1] + (uint64_t)(sq >> 64);
+		r->n[2 * i + 1] = (uint64_t)c;
+		c >>= 64;
+	}
+}
+
+/******************** Reduction ********************/
+// Subtract m if a >= m or a carried out of 2^256, given c = 2^256 - m.
+static inline void u256_sub_if_above(Uint256 *r, const Uint256 *a, const uint64_t *c, uint8_t c_len, uint64_t carry)
+{
+	uint64_t u[4];
+	uint128_t s = 0;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		s += (uint128_t)a->n[i] + (i < c_len ? c[i] : 0);
+		u[i] = (uint64_t)s;
+		s >>= 64;
+	}
+	uint64_t mask = -(uint64_t)(((uint64_t)s | carry) != 0);
+	for (uint8_t i = 0; i < 4; ++i)
+		r->n[i] = (u[i] & mask) | (a->n[i] & ~mask);
+}
+
+static inline void u256_reduce_p(Uint256 *r, const Uint512 *a)
+{
+	const uint64_t *t = a->n;
+	uint128_t c;
+	uint64_t s0, s1, s2, s3;
+
+	c = (uint128_t)t[4] * P_C + t[0];             s0 = (uint64_t)c; c >>= 64;
+	c += (uint128_t)t[5] * P_C + t[1];            s1 = (uint64_t)c; c >>= 64;
+	c += (uint128_t)t[6] * P_C + t[2];            s2 = (uint64_t)c; c >>= 64;
+	c += (uint128_t)t[7] * P_C + t[3];            s3 = (uint64_t)c; c >>= 64;
+
+	// The carry is below 2^34, fold it once more.
+	c = c * P_C + s0;                             r->n[0] = (uint64_t)c; c >>= 64;
+	c += s1;                                      r->n[1] = (uint64_t)c; c >>= 64;
+	c += s2;                                      r->n[2] = (uint64_t)c; c >>= 64;
+	c += s3;                                      r->n[3] = (uint64_t)c; c >>= 64;
+
+	const uint64_t p_c = P_C;
+	u256_sub_if_above(r, r, &p_c, 1, (uint64_t)c);
+}
+
+// r[0, hi_len + 3) = lo[0, 4) + hi[0, hi_len) * (2^256 - n), returns what carries out.
+static inline uint64_t u256_fold_n(uint64_t *r, const uint64_t *lo, const uint64_t *hi, uint8_t hi_len)
+{
+	uint8_t len = hi_len + 3;
+	uint128_t c = 0;
+
+	for (uint8_t i = 0; i < len; ++i)
+		r[i] = i < 4 ? lo[i] : 0;
+	for (uint8_t i = 0; i < hi_len; ++i)
+	{
+		c = 0;
+		for (uint8_t j = 0; j < 3; ++j)
+		{
+			c += (uint128_t)hi[i] * n_c[j] + r[i + j];
+			r[i + j] = (uint64_t)c;
+			c >>= 64;
+		}
+		for (uint8_t k = i + 3; k < len; ++k)
+		{
+			c += r[k];
+			r[k] = (uint64_t)c;
+			c >>= 64;
+		}
+	}
+	return (uint64_t)c;
+}
+
+/*
+*  Every fold shrinks the part above 2^256 by 127 bits, so four of them, at fixed lengths,
+*  leave 256 bits and a carry. The carry is folded by adding 2^256 - n once more.
+*/
+static inline void u256_reduce_n(Uint256 *r, const Uint512 *a)
+{
+	uint64_t m[7], p[6], q[5], s[4];
+
+	u256_fold_n(m, a->n, a->n + 4, 4);
+	u256_fold_n(p, m, m + 4, 3);
+	u256_fold_n(q, p, p + 4, 2);
+	uint64_t carry = u256_fold_n(s, q, q + 4, 1);
+
+	uint128_t c = 0;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		c += (uint128_t)s[i] + (i < 3 ? n_c[i] & -carry : 0);
+		r->n[i] = (uint64_t)c;
+		c >>= 64;
+	}
+	u256_sub_if_above(r, r, n_c, 3, 0);
+}
+
+static inline void u256_mod_p(Uint256 *r, const Uint256 *a)
+{
+	const uint64_t p_c = P_C;
+	u256_sub_if_above(r, a, &p_c, 1, 0);
+}
+
+static inline void u256_mod_n(Uint256 *r, const Uint256 *a)
+{
+	u256_sub_if_above(r, a, n_c, 3, 0);
+}
+
+/******************** Modular arithmetic ********************/
+static inline void u256_add_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	const uint64_t p_c = P_C;
+	uint64_t carry = u256_add(r, a, b);
+	u256_sub_if_above(r, r, &p_c, 1, carry);
+}
+
+// On borrow add the modulus back, that is subtract 2^256 - m modulo 2^256.
+static inline void u256_add_back(Uint256 *r, const uint64_t *c, uint8_t c_len, uint64_t borrow)
+{
+	uint64_t b = 0;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		uint128_t d = (uint128_t)r->n[i] - ((i < c_len ? c[i] : 0) & -borrow) - b;
+		r->n[i] = (uint64_t)d;
+		b = (uint64_t)(d >> 64) & 1;
+	}
+}
+
+static inline void u256_sub_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	const uint64_t p_c = P_C;
+	u256_add_back(r, &p_c, 1, u256_sub(r, a, b));
+}
+
+static inline void u256_mul_mod_p(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	Uint512 t;
+	u256_mul(&t, a, b);
+	u256_reduce_p(r, &t);
+}
+
+static inline void u256_add_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	uint64_t carry = u256_add(r, a, b);
+	u256_sub_if_above(r, r, n_c, 3, carry);
+}
+
+static inline void u256_sub_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	u256_add_back(r, n_c, 3, u256_sub(r, a, b));
+}
+
+static inline void u256_mul_mod_n(Uint256 *r, const Uint256 *a, const Uint256 *b)
+{
+	Uint512 t;
+	u256_mul(&t, a, b);
+	u256_reduce_n(r, &t);
+}
@@ -20,7 +20,7 @@ Interpreter * new_Interpreter()
 	new->alt_stack = new_CStack(MAX_SCRIPT_STACK_SIZE);
 	if (new->alt_stack == MEMORY_ALLOCATE_FAILED)
 	{
-		free(new->data_stack);
+		delete_CStack(new->data_stack);
 		free(new);
 		return MEMORY_ALLOCATE_FAILED;
 	}
@@ -37,7 +37,7 @@ Interpreter * new_Interpreter()
 Status delete_Interpreter(Interpreter *self)
 {
 	if (self->data_stack != NULL) delete_CStack(self->data_stack);
-	else if (self->alt_stack != NULL) delete_CStack(self->alt_stack);
+	if (self->alt_stack != NULL) delete_CStack(self->alt_stack);
 	self->script = NULL;
 	free(self);
 	return SUCCEEDED;
@@ -68,9 +68,16 @@ while (cursor < self->script->get_length(self->script))
 //for (uint64_t cursor = start_point; cursor < self->script->get_length(self->script); ++cursor)
 {
 	element = self->script->get_element(self->script, cursor, &size);
-	if (size != 1) return SCRIPT_CONTAINED_INVALID_ELEMENT;
+	if (element == MEMORY_ALLOCATE_FAILED) return MEMORY_ALLOCATE_FAILED;
+	if (size != 1)
+	{
+		free(element);
+		return SCRIPT_CONTAINED_INVALID_ELEMENT;
+	}
+	byte opcode = element[0];
+	free(element);
 
-	switch (element[0])
+	switch (opcode)
 	{
 	// Constants
 		case OP_0: // OP_FALSE
@@ -119,7 +126,7 @@ while (cursor < self->script->get_length(self->script))
 		case OP_2:case OP_3:case OP_4:case OP_5:case OP_6:case OP_7:case OP_8:case OP_9: \
 		case OP_10:case OP_11:case OP_12:case OP_13:case OP_14:case OP_15:case OP_16:
 		{
-			status = EXC_OP_2_TO_16(self->data_stack, element[0]-0x50);
+			status = EXC_OP_2_TO_16(self->data_stack, opcode-0x50);
 			if (status == OPERATION_EXECUTED ||
 				status == OPERATION_NOT_EXECUTED) break;
 			else return status;
@@ -175,12 +182,21 @@ while (cursor < self->script->get_length(self->script))
 				status == OPERATION_NOT_EXECUTED) break;
 			else return status;
 		}
+
+	// Crypto
+		case OP_HASH160:
+		{
+			status = EXC_OP_HASH160(self->data_stack);
+			if (status == OPERATION_EXECUTED ||
+				status == OPERATION_NOT_EXECUTED) break;
+			else return status;
+		}
 	}
 	cursor++;
 }
 	size_t top_size;
 	byte *top = (byte *)self->data_stack->pop(self->data_stack, &top_size, NULL, NULL);
-	if ( (top_size == 1 && top == 0x00) || (top == NULL) )
+	if ( (top == NULL) || (top_size == 1 && top[0] == 0x00) )
 	{
 		free(top);
 		return INTERPRETER_FALSE;
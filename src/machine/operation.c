@@ -5,11 +5,12 @@
 #include "internal/machine/operation.h"
 #include "internal/machine/interpreter.h"
 #include "internal/codec/strings.h"
+#include "internal/crypto/ripemd160.h"
 #include "internal/container/CStack.h"
 
 Status EXC_OP_0_FALSE(CStack *stack)
 {
-	if (stack->is_full) return CSTACK_FULL;
+	if (stack->is_full(stack)) return CSTACK_FULL;
 	byte *num = NULL;
 	stack->push(stack, num, 0, BYTE_TYPE, true);
 	return OPERATION_EXECUTED;
@@ -29,21 +30,25 @@ Status EXC_OP_PUSHDATA(CStack *stack, Script *script, uint64_t *pos)
 {
 	if (stack->is_full(stack)) return CSTACK_FULL;
 	// Get the expected size (current element).
-	size_t expected = ((byte *)script->get_element(script, *pos, NULL))[0];
+	size_t opcode_size;
+	byte *opcode = (byte *)script->get_element(script, *pos, &opcode_size);
+	if (opcode == MEMORY_ALLOCATE_FAILED) return MEMORY_ALLOCATE_FAILED;
+	size_t expected = opcode[0];
+	free(opcode);
 
-	// Get the actual size and check (next element).
+	// Get the actual size and check (next element), the element is already a copy.
 	size_t size;
 	byte *data = (byte *)(script->get_element(script, (*pos)+1, &size));
-	if (expected != size) return SCRIPT_SIZE_TO_PUSH_NOT_EQUAL_EXPECTED;
-
-	// Copy the data.
-	byte *copy = (byte *)malloc(size);
-	if (copy == NULL) return MEMORY_ALLOCATE_FAILED;
-	memcpy(copy, data, size);
+	if (data == INDEX_OUT_RANGE || data == MEMORY_ALLOCATE_FAILED) return data;
+	if (expected != size)
+	{
+		free(data);
+		return SCRIPT_SIZE_TO_PUSH_NOT_EQUAL_EXPECTED;
+	}
 
-	// Push to stack.
-	stack->push(stack, copy, size, BYTE_TYPE, true);
-	*pos = (*pos) + 2;
+	// Push to stack, the caller steps over the data element.
+	stack->push(stack, data, size, BYTE_TYPE, true);
+	*pos = (*pos) + 1;
 	return OPERATION_EXECUTED;
 }
 
@@ -903,4 +908,24 @@ Status EXC_OP_1ADD(CStack *stack)
 	byte *top = (byte *)stack->pop(stack, &size, NULL, NULL);
 
 	
+}
+
+Status EXC_OP_HASH160(CStack *stack)
+{
+	if (stack->is_empty(stack)) return CSTACK_EMPTY;
+
+	size_t size;
+	byte *top = (byte *)stack->pop(stack, &size, NULL, NULL);
+
+	byte *digest = (byte *)malloc(20);
+	if (digest == NULL)
+	{
+		free(top);
+		return MEMORY_ALLOCATE_FAILED;
+	}
+	hash160(top, size, digest);
+	free(top);
+
+	stack->push(stack, digest, 20, BYTE_TYPE, true);
+	return OPERATION_EXECUTED;
 }
\ No newline at end of file
@@ -1446,7 +1446,7 @@ Status Script_get_element(Script *self, uint64_t index, size_t *size)
 		return PASSING_NULL_POINTER;
 	else if (self->is_empty(self))
 		return SCRIPT_HAS_NO_ELEMENTS;
-	else if (self->get_length(self) <= index || index == 0)
+	else if (self->get_length(self) <= index)
 		return INDEX_OUT_RANGE;
 	else
 	{
@@ -1455,7 +1455,7 @@ Status Script_get_element(Script *self, uint64_t index, size_t *size)
 		void *element_copy = (void *)malloc(size_buff);
 		if (element_copy == NULL)
 			return MEMORY_ALLOCATE_FAILED;
-		memcpy(element_copy, self->script->get_node(self->script, index)->data, *size);
+		memcpy(element_copy, self->script->get_node(self->script, index)->data, size_buff);
 		return element_copy;
 	}
 }
@@ -0,0 +1,465 @@
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "internal/crypto/secp256k1.h"
+#include "internal/common.h"
+#include "internal/address.h"
+#include "internal/vanity.h"
+
+typedef unsigned __int128 uint128_t;
+
+#define VANITY_BLOCK        1024      // Keys per walker call.
+#define VANITY_MAX_VARIANTS 4096      // Case variants of a VANITY_PREFIX_NOCASE pattern.
+#define VANITY_WORKER_SPAN  40        // Worker t starts at the base key + t * 2^40.
+
+static const char base58_alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+/******************** Pattern to ranges ********************/
+// 256-bit unsigned integers, little-endian limbs, for the bounds of 25 bytes payloads.
+typedef struct { uint64_t n[4]; } Wide;
+
+static void wide_set_bit(Wide *r, uint16_t bit)
+{
+	memset(r, 0, sizeof(Wide));
+	r->n[bit / 64] = 1ULL << (bit % 64);
+}
+
+static int wide_cmp(const Wide *a, const Wide *b)
+{
+	for (int8_t i = 3; i >= 0; --i)
+		if (a->n[i] != b->n[i])
+			return a->n[i] < b->n[i] ? -1 : 1;
+	return 0;
+}
+
+// r = r * m + add, returns false on overflow.
+static bool wide_mul_add(Wide *r, uint32_t m, uint32_t add)
+{
+	uint128_t c = add;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		c += (uint128_t)r->n[i] * m;
+		r->n[i] = (uint64_t)c;
+		c >>= 64;
+	}
+	return c == 0;
+}
+
+static void wide_sub(Wide *r, const Wide *a, const Wide *b)
+{
+	uint64_t borrow = 0;
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		uint128_t d = (uint128_t)a->n[i] - b->n[i] - borrow;
+		r->n[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+}
+
+// The hash160 of a payload offset from the version byte: bits 32 ~ 191, big-endian.
+static void wide_to_hash160(const Wide *a, byte *hash160)
+{
+	for (uint8_t i = 0; i < 20; ++i)
+	{
+		uint16_t bit = 32 + (19 - i) * 8;
+		hash160[i] = (byte)(a->n[bit / 64] >> (bit % 64));
+	}
+}
+
+static int range_cmp(const void *a, const void *b)
+{
+	return memcmp(((const VanityRange *)a)->lo, ((const VanityRange *)b)->lo, 20);
+}
+
+// Sort the ranges and merge the overlapping or adjacent ones.
+static size_t ranges_merge(VanityRange *ranges, size_t count)
+{
+	size_t merged = 0;
+
+	qsort(ranges, count, sizeof(VanityRange), range_cmp);
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (merged)
+		{
+			// Adjacent if last.hi + 1 == lo.
+			byte next[20];
+			int8_t j;
+			memcpy(next, ranges[merged - 1].hi, 20);
+			for (j = 19; j >= 0 && ++next[j] == 0; --j);
+			if (j >= 0 && memcmp(ranges[i].lo, next, 20) <= 0)
+			{
+				if (memcmp(ranges[i].hi, ranges[merged - 1].hi, 20) > 0)
+					memcpy(ranges[merged - 1].hi, ranges[i].hi, 20);
+				continue;
+			}
+			if (j < 0) // The last range already ends at 0xff..ff.
+				continue;
+		}
+		ranges[merged++] = ranges[i];
+	}
+	return merged;
+}
+
+// Store [a, b) & [zlo, zhi) & [vlo, vhi) as hash160s if not empty, the checksum takes the low 32 bits.
+static size_t add_range(Wide a, Wide b, const Wide *zlo, const Wide *zhi, const Wide *vlo, const Wide *vhi,
+	VanityRange *range)
+{
+	Wide one = {{1, 0, 0, 0}};
+
+	if (wide_cmp(&a, zlo) < 0) a = *zlo;
+	if (wide_cmp(&a, vlo) < 0) a = *vlo;
+	if (wide_cmp(&b, zhi) > 0) b = *zhi;
+	if (wide_cmp(&b, vhi) > 0) b = *vhi;
+	if (wide_cmp(&a, &b) >= 0)
+		return 0;
+
+	wide_sub(&a, &a, vlo);
+	wide_sub(&b, &b, vlo);
+	wide_sub(&b, &b, &one);
+	wide_to_hash160(&a, range->lo);
+	wide_to_hash160(&b, range->hi);
+	return 1;
+}
+
+// Ranges of the payloads version + hash160 + checksum whose Base58 encoding starts with 'pattern'.
+static size_t prefix_ranges(const char *pattern, size_t len, byte version, VanityRange *ranges)
+{
+	Wide zlo = {{0}}, zhi, vlo = {{0}}, vhi = {{0}}, lo = {{0}}, hi, limit;
+	size_t zeros = 0, count = 0;
+
+	// The version byte is the top byte of the payload.
+	vlo.n[3] = version;
+	vhi.n[3] = (uint64_t)version + 1;
+
+	// The leading '1's are the leading zero bytes of the payload.
+	while (zeros < len && pattern[zeros] == '1')
+		zeros++;
+	if (zeros >= 25)
+		return 0;
+	wide_set_bit(&zhi, (25 - zeros) * 8);
+	wide_set_bit(&limit, 200);
+	if (zeros == len)
+		return add_range(zlo, limit, &zlo, &zhi, &vlo, &vhi, ranges);
+
+	// Exactly 'zeros' zero bytes, the next one is not zero.
+	wide_set_bit(&zlo, (24 - zeros) * 8);
+
+	// The remaining characters as a number, then scaled to every encoded length.
+	for (size_t i = zeros; i < len; ++i)
+	{
+		const char *digit = strchr(base58_alphabet, pattern[i]);
+		if (!wide_mul_add(&lo, 58, digit - base58_alphabet))
+			return 0;
+	}
+	hi = lo;
+	wide_mul_add(&hi, 1, 1);
+
+	while (wide_cmp(&lo, &limit) < 0)
+	{
+		count += add_range(lo, hi, &zlo, &zhi, &vlo, &vhi, ranges + count);
+		if (!wide_mul_add(&lo, 58, 0) || !wide_mul_add(&hi, 58, 0))
+			break;
+	}
+	return count;
+}
+
+static int8_t hex_value(uint8_t c)
+{
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+size_t vanity_ranges(const uint8_t *pattern, VANITY_MATCH match, ADDRESS_TYPE addr_type, VanityRange **ranges,
+	Status *status)
+{
+	size_t len = strlen((const char *)pattern), variants = 1, count = 0;
+	char choices[ADDRESS_SLOT_SIZE][2];
+	uint8_t nchoices[ADDRESS_SLOT_SIZE];
+
+	*ranges = NULL;
+	*status = VANITY_INVALID_PATTERN;
+
+	if (match == VANITY_HASH160_PREFIX)
+	{
+		if (len > 40)
+			return 0;
+		*ranges = (VanityRange *)calloc(1, sizeof(VanityRange));
+		if (!*ranges)
+		{
+			*status = MEMORY_ALLOCATE_FAILED;
+			return 0;
+		}
+		memset((*ranges)->hi, 0xff, 20);
+		for (size_t i = 0; i < len; ++i)
+		{
+			int8_t v = hex_value(pattern[i]);
+			if (v < 0)
+			{
+				free(*ranges);
+				*ranges = NULL;
+				return 0;
+			}
+			uint8_t shift = i % 2 ? 0 : 4;
+			(*ranges)->lo[i / 2] |= v << shift;
+			(*ranges)->hi[i / 2] &= ~(0x0f << shift) | (v << shift);
+		}
+		*status = SUCCEEDED;
+		return 1;
+	}
+
+	if (len == 0 || len >= ADDRESS_SLOT_SIZE)
+		return 0;
+
+	// Every character of the pattern and, without case, its other case if that is Base58 too.
+	for (size_t i = 0; i < len; ++i)
+	{
+		char c = pattern[i], other = c;
+		if (match == VANITY_PREFIX_NOCASE)
+			other = c >= 'a' && c <= 'z' ? c - 32 : c >= 'A' && c <= 'Z' ? c + 32 : c;
+		nchoices[i] = 0;
+		if (c && strchr(base58_alphabet, c))
+			choices[i][nchoices[i]++] = c;
+		if (other != c && strchr(base58_alphabet, other))
+			choices[i][nchoices[i]++] = other;
+		if (nchoices[i] == 0)
+			return 0;
+		variants *= nchoices[i];
+		if (variants > VANITY_MAX_VARIANTS)
+		{
+			*status = VANITY_PATTERN_TOO_BROAD;
+			return 0;
+		}
+	}
+
+	// A 25 bytes payload has 35 encoded lengths at most.
+	*ranges = (VanityRange *)malloc(variants * 36 * sizeof(VanityRange));
+	if (!*ranges)
+	{
+		*status = MEMORY_ALLOCATE_FAILED;
+		return 0;
+	}
+	char variant[ADDRESS_SLOT_SIZE];
+	for (size_t v = 0; v < variants; ++v)
+	{
+		size_t index = v;
+		for (size_t i = 0; i < len; ++i)
+		{
+			variant[i] = choices[i][index % nchoices[i]];
+			index /= nchoices[i];
+		}
+		count += prefix_ranges(variant, len, address_prefix(addr_type), *ranges + count);
+	}
+
+	if (count == 0)
+	{
+		free(*ranges);
+		*ranges = NULL;
+		return 0;
+	}
+	*status = SUCCEEDED;
+	return ranges_merge(*ranges, count);
+}
+
+bool vanity_ranges_match(const VanityRange *ranges, size_t count, const byte *hash160)
+{
+	// The last range starting at or below the hash160.
+	size_t lo = 0, hi = count;
+	while (lo < hi)
+	{
+		size_t mid = (lo + hi) / 2;
+		if (memcmp(ranges[mid].lo, hash160, 20) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo > 0 && memcmp(hash160, ranges[lo - 1].hi, 20) <= 0;
+}
+
+/******************** Search ********************/
+typedef struct vanity_job_st VanityJob;
+struct vanity_job_st {
+	const VanityConfig *config;
+	const VanityRange *ranges;
+	size_t nranges;
+	VanityHit *hits;
+	size_t hit_count;
+	pthread_mutex_t lock;
+	atomic_uint_fast64_t keys;
+	atomic_bool stop;
+	atomic_uint finished; // Workers that have returned.
+};
+
+typedef struct vanity_worker_st VanityWorker;
+struct vanity_worker_st {
+	VanityJob *job;
+	byte start[32];
+};
+
+// Check a candidate's address and keep it.
+static void vanity_hit(VanityJob *job, const byte *priv_raw)
+{
+	const VanityConfig *config = job->config;
+	VanityHit hit;
+	size_t len = strlen((const char *)config->pattern);
+
+	memset(&hit, 0, sizeof(VanityHit));
+	memcpy(hit.priv_raw, priv_raw, 32);
+	ecdsa_secp256k1_privkey_to_pubkey(hit.priv_raw, hit.pub_raw, config->compress);
+	pub_to_address(hit.pub_raw, hit.address, config->compress, config->addr_type);
+
+	// The ranges are rounded out to whole hash160s, the address decides.
+	if (config->match == VANITY_PREFIX && strncmp((char *)hit.address, (const char *)config->pattern, len))
+		return;
+	if (config->match == VANITY_PREFIX_NOCASE && strncasecmp((char *)hit.address, (const char *)config->pattern, len))
+		return;
+
+	pthread_mutex_lock(&job->lock);
+	if (job->hit_count < config->max_hits)
+	{
+		job->hits[job->hit_count++] = hit;
+		if (job->hit_count == config->max_hits)
+			atomic_store(&job->stop, true);
+	}
+	pthread_mutex_unlock(&job->lock);
+}
+
+static void * vanity_worker(void *arg)
+{
+	VanityWorker *worker = (VanityWorker *)arg;
+	VanityJob *job = worker->job;
+	const VanityConfig *config = job->config;
+	KeyWalker walker;
+	byte hash160s[VANITY_BLOCK * 20], first[32];
+
+	key_walker_init(&walker, worker->start);
+	while (!atomic_load(&job->stop))
+	{
+		memcpy(first, walker.priv_raw, 32);
+		size_t got = key_walker_next(&walker, VANITY_BLOCK, NULL, hash160s, NULL, config->compress, config->addr_type);
+		if (got == 0)
+			break;
+
+		for (size_t i = 0; i < got; ++i)
+		{
+			if (!vanity_ranges_match(job->ranges, job->nranges, hash160s + i * 20))
+				continue;
+			byte priv_raw[32];
+			memcpy(priv_raw, first, 32);
+			secp256k1_seckey_add(priv_raw, i);
+			vanity_hit(job, priv_raw);
+		}
+
+		uint64_t keys = atomic_fetch_add(&job->keys, got) + got;
+		if (config->max_keys && keys >= config->max_keys)
+			atomic_store(&job->stop, true);
+	}
+	atomic_fetch_add(&job->finished, 1);
+	return NULL;
+}
+
+static double vanity_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void vanity_stats(VanityJob *job, double start, VanityStats *stats)
+{
+	stats->keys = atomic_load(&job->keys);
+	stats->seconds = vanity_now() - start;
+	stats->keys_per_second = stats->seconds > 0 ? stats->keys / stats->seconds : 0;
+}
+
+Status vanity_search(const VanityConfig *config, VanityHit *hits, size_t *hit_count, VanityStats *stats)
+{
+	VanityJob job;
+	VanityStats now;
+	Status status;
+	uint32_t threads = config->threads;
+
+	*hit_count = 0;
+	if (config->max_hits == 0)
+		return FAILED;
+	if (threads == 0)
+	{
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = cpus > 0 ? (uint32_t)cpus : 1;
+	}
+
+	// One random base key, worker t walks from base + t * 2^VANITY_WORKER_SPAN.
+	byte base[32];
+	do
+	{
+		if (ecdsa_secp256k1_generate_private_key(base) != SUCCEEDED)
+			return FAILED;
+	} while (secp256k1_seckey_room(base) >> VANITY_WORKER_SPAN <= threads);
+
+	VanityRange *ranges;
+	size_t nranges = vanity_ranges(config->pattern, config->match, config->addr_type, &ranges, &status);
+	if (nranges == 0)
+		return status;
+
+	VanityWorker *workers = (VanityWorker *)malloc(threads * sizeof(VanityWorker));
+	pthread_t *tids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+	if (!workers || !tids)
+	{
+		free(ranges); free(workers); free(tids);
+		return MEMORY_ALLOCATE_FAILED;
+	}
+
+	job.config = config;
+	job.ranges = ranges;
+	job.nranges = nranges;
+	job.hits = hits;
+	job.hit_count = 0;
+	pthread_mutex_init(&job.lock, NULL);
+	atomic_init(&job.keys, 0);
+	atomic_init(&job.stop, false);
+	atomic_init(&job.finished, 0);
+
+	double start = vanity_now(), last = start;
+	uint32_t started = 0;
+	status = SUCCEEDED;
+	for (; started < threads; ++started)
+	{
+		workers[started].job = &job;
+		memcpy(workers[started].start, base, 32);
+		secp256k1_seckey_add(workers[started].start, (uint64_t)started << VANITY_WORKER_SPAN);
+		if (pthread_create(&tids[started], NULL, vanity_worker, &workers[started]) != 0)
+		{
+			atomic_store(&job.stop, true);
+			status = VANITY_THREAD_FAILED;
+			break;
+		}
+	}
+
+	// Workers also return on their own once their range runs out.
+	while (!atomic_load(&job.stop) && atomic_load(&job.finished) < started)
+	{
+		struct timespec pause = {0, 20000000};
+		nanosleep(&pause, NULL);
+		if (config->progress && vanity_now() - last >= 1.0)
+		{
+			last = vanity_now();
+			vanity_stats(&job, start, &now);
+			config->progress(&now, config->progress_arg);
+		}
+	}
+	for (uint32_t t = 0; t < started; ++t)
+		pthread_join(tids[t], NULL);
+
+	if (stats)
+		vanity_stats(&job, start, stats);
+	*hit_count = job.hit_count;
+
+	pthread_mutex_destroy(&job.lock);
+	free(ranges); free(workers); free(tids);
+	return status;
+}
@@ -0,0 +1,32 @@
+#ifndef _BTCTOOL_BENCH_
+#define _BTCTOOL_BENCH_
+
+#include <stdio.h>
+#include <time.h>
+
+// Wall clock in nanoseconds.
+static inline double bench_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Print one result line: name, operations per second and nanoseconds per operation.
+static inline void bench_report(const char *name, size_t ops, double ns)
+{
+	printf("%-40s %12.0f ops/s %10.1f ns/op\n", name, ops / ns * 1e9, ns / ops);
+}
+
+void bench_Base58(void);
+void bench_Address(void);
+void bench_SHA256(void);
+void bench_RIPEMD160(void);
+void bench_Secp256k1(void);
+void bench_Vanity(void);
+void bench_Random(void);
+void bench_Hex(void);
+void bench_Base64(void);
+void bench_Bigint(void);
+
+#endif
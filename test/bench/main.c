@@ -0,0 +1,16 @@
+#include "bench.h"
+
+int main(int argc, char const *argv[])
+{
+	bench_Base58();
+	bench_Address();
+	bench_SHA256();
+	bench_RIPEMD160();
+	bench_Secp256k1();
+	bench_Vanity();
+	bench_Random();
+	bench_Hex();
+	bench_Base64();
+	bench_Bigint();
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include <stdlib.h>
+#include <string.h>
+#include "../bench.h"
+#include "internal/address.h"
+
+#define ADDRESSES 200000
+
+void bench_Address(void)
+{
+	const char *address = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa";
+	size_t line_len = strlen(address) + 1;
+	uint8_t *buffer = (uint8_t *)malloc(ADDRESSES * line_len);
+	uint8_t **addresses = (uint8_t **)malloc(ADDRESSES * sizeof(uint8_t *));
+	byte *hash160s = (byte *)malloc(ADDRESSES * 20);
+	Status *statuses = (Status *)malloc(ADDRESSES * sizeof(Status));
+	double start;
+	size_t count;
+
+	for (size_t i = 0; i < ADDRESSES; ++i)
+	{
+		memcpy(buffer + i * line_len, address, line_len);
+		addresses[i] = buffer + i * line_len;
+	}
+
+	start = bench_now();
+	for (size_t i = 0; i < ADDRESSES; ++i)
+		address_to_hash160(addresses[i], hash160s + i * 20);
+	bench_report("address_to_hash160", ADDRESSES, bench_now() - start);
+
+	start = bench_now();
+	address_to_hash160_batch(addresses, ADDRESSES, hash160s, statuses);
+	bench_report("address_to_hash160_batch", ADDRESSES, bench_now() - start);
+
+	for (size_t i = 0; i < ADDRESSES; ++i)
+		buffer[i * line_len + line_len - 1] = '\n';
+	start = bench_now();
+	address_to_hash160_lines(buffer, ADDRESSES * line_len, hash160s, statuses, ADDRESSES, &count);
+	bench_report("address_to_hash160_lines", count, bench_now() - start);
+
+	// Compressed public keys, any 33 bytes do for hashing and encoding.
+	byte *pubs = (byte *)malloc(ADDRESSES * 33);
+	uint8_t *b58_addresses = (uint8_t *)malloc(ADDRESSES * ADDRESS_SLOT_SIZE);
+	for (size_t i = 0; i < ADDRESSES * 33; ++i)
+		pubs[i] = (byte)(i * 131 + (i >> 7));
+
+	start = bench_now();
+	for (size_t i = 0; i < ADDRESSES; ++i)
+		pub_to_address(pubs + i * 33, b58_addresses + i * ADDRESS_SLOT_SIZE, true, MAINNET_P2PKH);
+	bench_report("pub_to_address", ADDRESSES, bench_now() - start);
+
+	start = bench_now();
+	pub_to_address_batch(pubs, ADDRESSES, b58_addresses, true, MAINNET_P2PKH);
+	bench_report("pub_to_address_batch", ADDRESSES, bench_now() - start);
+
+	// Consecutive keys, the pubs and addresses buffers are reused.
+	KeyWalker walker;
+	byte start_key[32];
+	for (uint8_t i = 0; i < 32; ++i)
+		start_key[i] = (byte)(i * 29 + 7);
+
+	key_walker_init(&walker, start_key);
+	start = bench_now();
+	key_walker_next(&walker, ADDRESSES, pubs, NULL, NULL, true, MAINNET_P2PKH);
+	bench_report("key_walker_next/pubkey", ADDRESSES, bench_now() - start);
+
+	key_walker_init(&walker, start_key);
+	start = bench_now();
+	key_walker_next(&walker, ADDRESSES, pubs, hash160s, b58_addresses, true, MAINNET_P2PKH);
+	bench_report("key_walker_next/address", ADDRESSES, bench_now() - start);
+
+	free(buffer); free(addresses); free(hash160s); free(statuses);
+	free(pubs); free(b58_addresses);
+}
@@ -0,0 +1,245 @@
+#include <string.h>
+#include <openssl/bn.h>
+#include "../bench.h"
+#include "internal/codec/base.h"
+
+#define ROUNDS 200000
+
+static const char *table = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// The former BIGNUM based encoder, kept as the baseline to compare against.
+static size_t bignum_base58encode(const byte *payload, size_t payload_len, uint8_t *encoded)
+{
+	uint8_t raw[payload_len * 2];
+	size_t zeros = 0, len = 0;
+	while (zeros < payload_len && payload[zeros] == 0x00)
+		zeros++;
+
+	BIGNUM *bn = BN_new(), *bn58 = BN_new(), *dv = BN_new(), *rem = BN_new();
+	BN_CTX *ctx = BN_CTX_new();
+	BN_bin2bn(payload, payload_len, bn);
+	BN_set_word(bn58, 58);
+	while (!BN_is_zero(bn))
+	{
+		BN_div(dv, rem, bn, bn58, ctx);
+		BN_copy(bn, dv);
+		raw[len++] = table[BN_get_word(rem)];
+	}
+	for (size_t i = 0; i < zeros; ++i)
+		encoded[i] = '1';
+	for (size_t i = 0; i < len; ++i)
+		encoded[zeros + len - 1 - i] = raw[i];
+	encoded[zeros + len] = '\0';
+
+	BN_free(bn); BN_free(bn58); BN_free(dv); BN_free(rem);
+	BN_CTX_free(ctx);
+	return 0;
+}
+
+static void bench_payload(size_t payload_len)
+{
+	byte payload[payload_len];
+	uint8_t encoded[payload_len * 2 + 1];
+	byte decoded[payload_len];
+	char name[64];
+	double start;
+
+	for (size_t i = 0; i < payload_len; ++i)
+		payload[i] = (byte)(i * 131 + 7);
+	payload[0] = 0x00;
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS / 10; ++i)
+	{
+		payload[payload_len - 1] = (byte)i;
+		bignum_base58encode(payload, payload_len, encoded);
+	}
+	snprintf(name, sizeof(name), "base58encode/bignum/%zu", payload_len);
+	bench_report(name, ROUNDS / 10, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+	{
+		payload[payload_len - 1] = (byte)i;
+		base58encode(payload, payload_len, encoded);
+	}
+	snprintf(name, sizeof(name), "base58encode/native/%zu", payload_len);
+	bench_report(name, ROUNDS, bench_now() - start);
+
+	size_t encoded_len = strlen((const char *)encoded);
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+		base58decode(encoded, encoded_len, decoded);
+	snprintf(name, sizeof(name), "base58decode/native/%zu", payload_len);
+	bench_report(name, ROUNDS, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+		base58decode_fixed(encoded, encoded_len, decoded, payload_len);
+	snprintf(name, sizeof(name), "base58decode_fixed/native/%zu", payload_len);
+	bench_report(name, ROUNDS, bench_now() - start);
+}
+
+// The former BIGNUM based Base6 decoder, one BN_exp per digit.
+static size_t bignum_base6decode(const uint8_t *payload, size_t payload_len, byte *decoded)
+{
+	BIGNUM *bn = BN_new(), *bn6 = BN_new(), *digit = BN_new(), *power = BN_new();
+	BIGNUM *powered = BN_new(), *to_add = BN_new();
+	BN_CTX *ctx = BN_CTX_new();
+	BN_zero(bn);
+	BN_set_word(bn6, 6);
+	for (size_t i = 0; i < payload_len; ++i)
+	{
+		BN_set_word(digit, payload[i] - '0');
+		BN_set_word(power, payload_len - 1 - i);
+		BN_exp(powered, bn6, power, ctx);
+		BN_mul(to_add, digit, powered, ctx);
+		BN_add(bn, bn, to_add);
+	}
+	size_t len = BN_bn2bin(bn, decoded);
+
+	BN_free(bn); BN_free(bn6); BN_free(digit); BN_free(power); BN_free(powered); BN_free(to_add);
+	BN_CTX_free(ctx);
+	return len;
+}
+
+// 99 dice rolls, a 256-bit private key.
+static void bench_base6(void)
+{
+	uint8_t rolls[100];
+	byte decoded[40];
+	size_t decoded_len = 0, encoded_len;
+	double start;
+
+	for (size_t i = 0; i < 99; ++i)
+		rolls[i] = (uint8_t)('0' + (i * 7 + 3) % 6);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS / 100; ++i)
+	{
+		rolls[98] = (uint8_t)('0' + i % 6);
+		bignum_base6decode(rolls, 99, decoded);
+	}
+	bench_report("base6decode/bignum/99", ROUNDS / 100, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+	{
+		rolls[98] = (uint8_t)('0' + i % 6);
+		base6_decode(rolls, 99, decoded, sizeof(decoded), &decoded_len);
+	}
+	bench_report("base6decode/native/99", ROUNDS, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+	{
+		decoded[31] = (byte)i;
+		base6_encode(decoded, decoded_len, rolls, sizeof(rolls), &encoded_len);
+	}
+	bench_report("base6encode/native/32", ROUNDS, bench_now() - start);
+}
+
+// 2^256 - 1 and a 1 KiB payload in decimal, BN_bn2dec and BN_dec2bn as the baseline.
+static void bench_base10(void)
+{
+	static const size_t sizes[] = {32, 1024};
+	static byte payload[1024], decoded[1024];
+	static uint8_t encoded[BASE10_ENCODE_BOUND(1024)];
+	size_t encoded_len, decoded_len;
+	char name[64];
+
+	memset(payload, 0xff, sizeof(payload));
+	for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+	{
+		size_t n = sizes[k], rounds = ROUNDS / n;
+		BIGNUM *bn = BN_bin2bn(payload, n, NULL);
+
+		double start = bench_now();
+		for (size_t i = 0; i < rounds; ++i)
+			OPENSSL_free(BN_bn2dec(bn));
+		snprintf(name, sizeof(name), "base10encode/bignum/%zu", n);
+		bench_report(name, rounds, bench_now() - start);
+
+		start = bench_now();
+		for (size_t i = 0; i < rounds; ++i)
+		{
+			payload[n - 1] = (byte)i;
+			base10_encode(payload, n, encoded, sizeof(encoded), &encoded_len);
+		}
+		snprintf(name, sizeof(name), "base10encode/native/%zu", n);
+		bench_report(name, rounds, bench_now() - start);
+
+		start = bench_now();
+		for (size_t i = 0; i < rounds; ++i)
+			BN_dec2bn(&bn, (const char *)encoded);
+		snprintf(name, sizeof(name), "base10decode/bignum/%zu", encoded_len);
+		bench_report(name, rounds, bench_now() - start);
+
+		start = bench_now();
+		for (size_t i = 0; i < rounds; ++i)
+			base10_decode(encoded, encoded_len, decoded, sizeof(decoded), &decoded_len);
+		snprintf(name, sizeof(name), "base10decode/native/%zu", encoded_len);
+		bench_report(name, rounds, bench_now() - start);
+
+		BN_free(bn);
+		payload[n - 1] = 0xff;
+	}
+}
+
+// Payloads past the divide-and-conquer thresholds, BN_bn2dec as the decimal baseline.
+static void bench_large(void)
+{
+	static const size_t sizes[] = {16384, 65536};
+	static byte payload[65536], decoded[65536];
+	static uint8_t encoded[BASE6_ENCODE_BOUND(65536)];
+	typedef Status (*Encode)(const byte *, size_t, uint8_t *, size_t, size_t *);
+	typedef Status (*Decode)(const uint8_t *, size_t, byte *, size_t, size_t *);
+	static const Encode encode[3] = {base58_encode, base6_encode, base10_encode};
+	static const Decode decode[3] = {base58_decode, base6_decode, base10_decode};
+	static const char *names[3] = {"base58", "base6", "base10"};
+	size_t encoded_len, decoded_len;
+	char name[64];
+
+	for (size_t i = 0; i < sizeof(payload); ++i)
+		payload[i] = (byte)(i * 131 + 7);
+	for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+	{
+		size_t n = sizes[k], rounds = 65536 / n;
+		BIGNUM *bn = BN_bin2bn(payload, n, NULL);
+
+		double start = bench_now();
+		for (size_t i = 0; i < rounds; ++i)
+			OPENSSL_free(BN_bn2dec(bn));
+		snprintf(name, sizeof(name), "base10encode/bignum/%zu", n);
+		bench_report(name, rounds, bench_now() - start);
+		BN_free(bn);
+
+		for (int c = 0; c < 3; ++c)
+		{
+			start = bench_now();
+			for (size_t i = 0; i < rounds; ++i)
+				encode[c](payload, n, encoded, sizeof(encoded), &encoded_len);
+			snprintf(name, sizeof(name), "%sencode/native/%zu", names[c], n);
+			bench_report(name, rounds, bench_now() - start);
+
+			start = bench_now();
+			for (size_t i = 0; i < rounds; ++i)
+				decode[c](encoded, encoded_len, decoded, sizeof(decoded), &decoded_len);
+			snprintf(name, sizeof(name), "%sdecode/native/%zu", names[c], encoded_len);
+			bench_report(name, rounds, bench_now() - start);
+		}
+	}
+}
+
+void bench_Base58(void)
+{
+	bench_payload(21);
+	bench_payload(25);
+	bench_payload(33);
+	bench_payload(37);
+	bench_payload(38);
+	bench_payload(40); // No specialized path.
+	bench_base6();
+	bench_base10();
+	bench_large();
+}
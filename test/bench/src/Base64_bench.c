@@ -0,0 +1,59 @@
+#include <stdlib.h>
+#include "../bench.h"
+#include "internal/codec/base.h"
+
+#define PAYLOAD_LEN (1 << 20)
+#define CHUNK_LEN   4096
+#define ROUNDS      64
+
+static const BASE64_IMPL impls[2] = {BASE64_SCALAR, BASE64_AVX2};
+static const char *names[2] = {"scalar", "avx2"};
+
+// Throughput on a 1 MiB payload fed in 4 KiB chunks, one op is one byte.
+void bench_Base64(void)
+{
+	byte *data = malloc(PAYLOAD_LEN);
+	uint8_t *encoded = malloc(BASE64_ENCODED_LEN(PAYLOAD_LEN));
+	Base64Stream stream;
+	size_t encoded_len = 0, len;
+	char name[64];
+	double start;
+
+	for (size_t i = 0; i < PAYLOAD_LEN; ++i)
+		data[i] = (byte)(i * 131 + 7);
+
+	for (uint8_t k = 0; k < 2; ++k)
+	{
+		if (base64_select(impls[k]) != SUCCEEDED)
+			continue;
+
+		start = bench_now();
+		for (size_t r = 0; r < ROUNDS; ++r)
+		{
+			base64_encode_init(&stream);
+			encoded_len = 0;
+			for (size_t i = 0; i < PAYLOAD_LEN; i += CHUNK_LEN)
+				encoded_len += base64_encode_update(&stream, data + i, CHUNK_LEN, encoded + encoded_len);
+			encoded_len += base64_encode_final(&stream, encoded + encoded_len);
+		}
+		snprintf(name, sizeof(name), "base64/encode/%s", names[k]);
+		bench_report(name, (size_t)ROUNDS * PAYLOAD_LEN, bench_now() - start);
+
+		start = bench_now();
+		for (size_t r = 0; r < ROUNDS; ++r)
+		{
+			size_t decoded_len = 0;
+			base64_decode_init(&stream);
+			for (size_t i = 0; i < encoded_len; i += CHUNK_LEN, decoded_len += len)
+				base64_decode_update(&stream, encoded + i, encoded_len - i < CHUNK_LEN ? encoded_len - i : CHUNK_LEN,
+					data + decoded_len, &len);
+			base64_decode_final(&stream, data + decoded_len, &len);
+		}
+		snprintf(name, sizeof(name), "base64/decode/%s", names[k]);
+		bench_report(name, (size_t)ROUNDS * PAYLOAD_LEN, bench_now() - start);
+	}
+	base64_select(BASE64_AUTO);
+
+	free(data);
+	free(encoded);
+}
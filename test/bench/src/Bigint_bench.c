@@ -0,0 +1,378 @@
+#include <stdlib.h>
+#include <string.h>
+#include "../bench.h"
+#include "internal/codec/base.h"
+#include "internal/crypto/bigint.h"
+#include "internal/crypto/ntt.h"
+
+#define DIGITS (1 << 16)
+#define ROUNDS 256
+
+// The former one digit at a time repacking, kept as the baseline to compare against.
+static void scalar_base2p8_to_base2p32(const uint8_t *payload, size_t payload_len, uint32_t *converted)
+{
+	memset(converted, 0x00, (payload_len + 3) / 4 * sizeof(uint32_t));
+	for (size_t i = 0; i < payload_len; ++i)
+		converted[i/4] |= (i%4) ? payload[i]<<(8*(i%4)) : payload[i];
+}
+
+// Repacking a 64 KiB number, one op is one byte.
+static void bench_radix(void)
+{
+	uint8_t *bytes = malloc(DIGITS);
+	uint32_t *words = malloc(DIGITS);
+	uint16_t *halves = malloc(DIGITS);
+	double start;
+
+	for (size_t i = 0; i < DIGITS; ++i)
+		bytes[i] = (uint8_t)(i * 131 + 7);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+		scalar_base2p8_to_base2p32(bytes, DIGITS, words);
+	bench_report("base2p8_to_base2p32/scalar", (size_t)ROUNDS * DIGITS, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+		base2p8_to_base2p32(bytes, DIGITS, words);
+	bench_report("base2p8_to_base2p32/native", (size_t)ROUNDS * DIGITS, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+		base2p32_to_base2p8(words, DIGITS / 4, bytes);
+	bench_report("base2p32_to_base2p8/native", (size_t)ROUNDS * DIGITS, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+		base2p32_to_base2p16(words, DIGITS / 4, halves);
+	bench_report("base2p32_to_base2p16/native", (size_t)ROUNDS * DIGITS, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+		base2p16_to_base2p32(halves, DIGITS / 2, words);
+	bench_report("base2p16_to_base2p32/native", (size_t)ROUNDS * DIGITS, bench_now() - start);
+
+	start = bench_now();
+	for (size_t i = 0; i < ROUNDS; ++i)
+		delete_Bigint(Bigint_set_bytearr(bytes, DIGITS, false));
+	bench_report("Bigint_set_bytearr", (size_t)ROUNDS * DIGITS, bench_now() - start);
+
+	free(bytes);
+	free(words);
+	free(halves);
+}
+
+static const NTT_IMPL ntt_impls[3] = {NTT_SCALAR, NTT_AVX2, NTT_AVX512};
+static const char *ntt_names[3] = {"scalar", "avx2", "avx512"};
+
+// Forward transforms of 2^16 residues per kernel, one op is one butterfly.
+static void bench_ntt(void)
+{
+	const uint32_t len = 1 << 16, rounds = 64;
+	NttPlan *plan = new_NttPlan(len, 0);
+	uint32_t *a = malloc(len * sizeof(uint32_t));
+	char name[64];
+	double start;
+
+	for (uint32_t i = 0; i < len; ++i)
+		a[i] = i * 2654435761u % NTT_P0;
+
+	for (uint8_t k = 0; k < 3; ++k)
+	{
+		if (ntt_select(ntt_impls[k]) != SUCCEEDED)
+			continue;
+
+		start = bench_now();
+		for (uint32_t i = 0; i < rounds; ++i)
+			ntt_execute(plan, a, false);
+		snprintf(name, sizeof(name), "ntt/65536/%s", ntt_names[k]);
+		bench_report(name, (size_t)rounds * len / 2 * 16, bench_now() - start);
+	}
+	ntt_select(NTT_AUTO);
+	delete_NttPlan(plan);
+	free(a);
+
+	// Forward transforms from 2^10 to 2^24 residues, one op is one butterfly, log2(len) / 2 per
+	// point. The four-step time should stay flat past the caches, the radix-2 one climbs once its
+	// stages stream from memory.
+	a = malloc(((size_t)1 << 24) * sizeof(uint32_t));
+	for (uint32_t log = 10; log <= 24; log += 2)
+	{
+		const uint32_t n = 1u << log;
+		const uint32_t n_rounds = (1u << 24) / n < 4 ? 4 : (1u << 24) / n;
+		for (uint32_t i = 0; i < n; ++i)
+			a[i] = i * 2654435761u % NTT_P0;
+
+		for (uint8_t four_step = 0; four_step < 2; ++four_step)
+		{
+			plan = four_step ? new_NttPlan_four_step(n, 0) : new_NttPlan(n, 0);
+			if (plan == MEMORY_ALLOCATE_FAILED)
+				continue;
+			start = bench_now();
+			for (uint32_t i = 0; i < n_rounds; ++i)
+				ntt_execute(plan, a, false);
+			snprintf(name, sizeof(name), "ntt/%s/2^%u", four_step ? "four-step" : "radix-2", log);
+			bench_report(name, (size_t)n_rounds * n / 2 * log, bench_now() - start);
+			delete_NttPlan(plan);
+		}
+	}
+	free(a);
+}
+
+// Time for one n x n product with a config, in nanoseconds. 'threads' 1 is d_mul.
+static double mul_time_threads(const BigintMulConfig *config, const uint32_t *a, const uint32_t *b, uint32_t n,
+	uint32_t *r, uint32_t threads)
+{
+	size_t rounds = 1 + (1 << 22) / ((size_t)n * n);
+	double start;
+
+	Bigint_mul_config_set(config);
+	start = bench_now();
+	for (size_t i = 0; i < rounds; ++i)
+	{
+		if (threads == 1)
+			d_mul(a, n, b, n, r);
+		else
+			d_mul_parallel(a, n, b, n, r, threads);
+	}
+	return (bench_now() - start) / rounds;
+}
+
+static double mul_time(const BigintMulConfig *config, const uint32_t *a, const uint32_t *b, uint32_t n, uint32_t *r)
+{
+	return mul_time_threads(config, a, b, n, r, 1);
+}
+
+// Each algorithm on balanced operands, and the thresholds where the next one starts to win.
+static void bench_mul(void)
+{
+	static const uint32_t bases[] = {8, 12, 16, 24, 32, 48, 64, 96};
+	static const uint32_t sizes[] = {64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 32768, 65536};
+	BigintMulConfig saved, config;
+	uint32_t *a = malloc(65536 * sizeof(uint32_t)), *b = malloc(65536 * sizeof(uint32_t));
+	uint32_t *r = malloc(2 * 65536 * sizeof(uint32_t));
+	uint32_t karatsuba_threshold = 0, ntt_threshold = UINT32_MAX;
+	double best = 0;
+	char name[64];
+
+	Bigint_mul_config_get(&saved);
+	for (uint32_t i = 0; i < 65536; ++i)
+	{
+		a[i] = i * 2654435761u;
+		b[i] = ~i * 40503u;
+	}
+
+	// Karatsuba recurses down to its threshold, so the best base case is the crossover with schoolbook.
+	for (size_t k = 0; k < sizeof(bases) / sizeof(bases[0]); ++k)
+	{
+		config = (BigintMulConfig){bases[k], UINT32_MAX};
+		double t = mul_time(&config, a, b, 1024, r);
+		snprintf(name, sizeof(name), "d_mul/karatsuba/1024/base %u", bases[k]);
+		bench_report(name, 1, t);
+		if (!best || t < best)
+		{
+			best = t;
+			karatsuba_threshold = bases[k];
+		}
+	}
+
+	for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+	{
+		uint32_t n = sizes[k];
+		config = (BigintMulConfig){karatsuba_threshold, UINT32_MAX};
+		double t_kara = mul_time(&config, a, b, n, r);
+		config.ntt_threshold = 4;
+		double t_ntt = mul_time(&config, a, b, n, r);
+
+		if (n <= 1024)
+		{
+			config = (BigintMulConfig){UINT32_MAX, UINT32_MAX};
+			snprintf(name, sizeof(name), "d_mul/schoolbook/%u", n);
+			bench_report(name, 1, mul_time(&config, a, b, n, r));
+		}
+		snprintf(name, sizeof(name), "d_mul/karatsuba/%u", n);
+		bench_report(name, 1, t_kara);
+		snprintf(name, sizeof(name), "d_mul/ntt/%u", n);
+		bench_report(name, 1, t_ntt);
+
+		if (ntt_threshold == UINT32_MAX && t_ntt < t_kara)
+			ntt_threshold = n;
+	}
+	printf("BigintMulConfig: karatsuba_threshold %u, ntt_threshold %u\n", karatsuba_threshold, ntt_threshold);
+
+	Bigint_mul_config_set(&saved);
+	free(a);
+	free(b);
+	free(r);
+}
+
+// d_mul_parallel against d_mul on NTT sizes, and the size where all the CPUs start to win.
+static void bench_mul_parallel(void)
+{
+	static const uint32_t threads[] = {2, 4, 0};
+	static const uint32_t sizes[] = {2048, 4096, 8192, 16384, 32768, 65536, 131072, 262144};
+	BigintMulConfig saved, config;
+	uint32_t *a = malloc(262144 * sizeof(uint32_t)), *b = malloc(262144 * sizeof(uint32_t));
+	uint32_t *r = malloc(2 * 262144 * sizeof(uint32_t));
+	uint32_t parallel_threshold = UINT32_MAX;
+	char name[64];
+
+	Bigint_mul_config_get(&saved);
+	config = saved;
+	config.parallel_threshold = 0;
+	for (uint32_t i = 0; i < 262144; ++i)
+	{
+		a[i] = i * 2654435761u;
+		b[i] = ~i * 40503u;
+	}
+
+	for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+	{
+		uint32_t n = sizes[k];
+		double t_serial = mul_time(&config, a, b, n, r);
+		snprintf(name, sizeof(name), "d_mul_parallel/%u/serial", n);
+		bench_report(name, 1, t_serial);
+		for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t)
+		{
+			double t_parallel = mul_time_threads(&config, a, b, n, r, threads[t]);
+			if (threads[t])
+				snprintf(name, sizeof(name), "d_mul_parallel/%u/%u threads", n, threads[t]);
+			else
+				snprintf(name, sizeof(name), "d_mul_parallel/%u/online CPUs", n);
+			bench_report(name, 1, t_parallel);
+			if (threads[t] == 0 && parallel_threshold == UINT32_MAX && t_parallel < t_serial)
+				parallel_threshold = n;
+		}
+	}
+	printf("BigintMulConfig: parallel_threshold %u\n", parallel_threshold);
+
+	Bigint_mul_config_set(&saved);
+	free(a);
+	free(b);
+	free(r);
+}
+
+// Exponentiations with a full-length exponent and inversions, per modulus size.
+static void bench_pow(void)
+{
+	static const uint32_t sizes[] = {8, 32, 64};
+	char name[64];
+
+	for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+	{
+		uint32_t n = sizes[k], rounds = 8192 / (n * n) + 2;
+		Bigint *a = new_Bigint(), *e = new_Bigint(), *m = new_Bigint();
+		a->d = malloc(n * sizeof(uint32_t));
+		e->d = malloc(n * sizeof(uint32_t));
+		m->d = malloc(n * sizeof(uint32_t));
+		a->len = e->len = m->len = n;
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			a->d[i] = i * 2654435761u + 1;
+			e->d[i] = ~i * 40503u;
+			m->d[i] = 0xffffffff - i;
+		}
+
+		double start = bench_now();
+		for (uint32_t i = 0; i < rounds; ++i)
+			delete_Bigint(Bigint_pow(a, e, m));
+		snprintf(name, sizeof(name), "Bigint_pow/%u", n * 32);
+		bench_report(name, rounds, bench_now() - start);
+
+		start = bench_now();
+		for (uint32_t i = 0; i < rounds; ++i)
+			delete_Bigint(Bigint_pow_consttime(a, e, m));
+		snprintf(name, sizeof(name), "Bigint_pow_consttime/%u", n * 32);
+		bench_report(name, rounds, bench_now() - start);
+
+		start = bench_now();
+		for (uint32_t i = 0; i < rounds * 64; ++i)
+			delete_Bigint(Bigint_ext(a, m));
+		snprintf(name, sizeof(name), "Bigint_ext/%u", n * 32);
+		bench_report(name, rounds * 64, bench_now() - start);
+
+		delete_Bigint(a);
+		delete_Bigint(e);
+		delete_Bigint(m);
+	}
+}
+
+// A one-limb divisor known only at run time: hardware division against the reciprocal.
+static void bench_div_1(void)
+{
+	const uint32_t n = 1024, rounds = 2000;
+	uint32_t *a = malloc(n * sizeof(uint32_t)), *q = malloc(n * sizeof(uint32_t));
+	volatile uint32_t divisor = 1000000007;
+	uint64_t sink = 0;
+	for (uint32_t i = 0; i < n; ++i)
+		a[i] = i * 2654435761u + 1;
+
+	double start = bench_now();
+	for (uint32_t k = 0; k < rounds; ++k)
+	{
+		uint32_t d = divisor;
+		uint64_t rem = 0;
+		for (uint32_t i = n; i-- > 0;)
+		{
+			uint64_t cur = rem << 32 | a[i];
+			q[i] = (uint32_t)(cur / d);
+			rem = cur % d;
+		}
+		sink += rem;
+	}
+	bench_report("div_1/hardware", (size_t)rounds * n, bench_now() - start);
+
+	start = bench_now();
+	for (uint32_t k = 0; k < rounds; ++k)
+	{
+		LimbDivisor d;
+		limb_divisor_init(&d, divisor);
+		sink += d_div_1(a, n, &d, q);
+	}
+	bench_report("div_1/reciprocal", (size_t)rounds * n, bench_now() - start);
+
+	if (sink == 1)
+		printf("\n");
+	free(a);
+	free(q);
+}
+
+// A 2n-limb dividend by an n-limb divisor, Algorithm D up to DIV_NEWTON_THRESHOLD, Newton past it.
+static void bench_div(void)
+{
+	static const uint32_t sizes[] = {16, 256, 2048, 8192, 32768};
+	char name[64];
+
+	for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+	{
+		uint32_t n = sizes[k], rounds = 65536 / n + 1;
+		uint32_t *a = malloc(2 * (size_t)n * sizeof(uint32_t)), *b = malloc(n * sizeof(uint32_t));
+		uint32_t *q = malloc((n + 1) * sizeof(uint32_t)), *r = malloc(n * sizeof(uint32_t));
+		for (uint32_t i = 0; i < 2 * n; ++i)
+			a[i] = i * 2654435761u + 1;
+		for (uint32_t i = 0; i < n; ++i)
+			b[i] = ~i * 40503u;
+
+		double start = bench_now();
+		for (uint32_t i = 0; i < rounds; ++i)
+			d_div(a, 2 * n, b, n, q, r);
+		snprintf(name, sizeof(name), "d_div/%u/%u", 2 * n, n);
+		bench_report(name, rounds, bench_now() - start);
+
+		free(a);
+		free(b);
+		free(q);
+		free(r);
+	}
+}
+
+void bench_Bigint(void)
+{
+	bench_radix();
+	bench_ntt();
+	bench_mul();
+	bench_mul_parallel();
+	bench_pow();
+	bench_div_1();
+	bench_div();
+}
@@ -0,0 +1,43 @@
+#include <stdlib.h>
+#include "../bench.h"
+#include "internal/codec/strings.h"
+
+#define PAYLOAD_LEN (1 << 20)
+#define ROUNDS      64
+
+static const HEX_IMPL impls[3] = {HEX_SCALAR, HEX_SSSE3, HEX_AVX2};
+static const char *names[3] = {"scalar", "ssse3", "avx2"};
+
+// Throughput on a 1 MiB payload, one op is one byte.
+void bench_Hex(void)
+{
+	byte *arr = malloc(PAYLOAD_LEN);
+	uint8_t *str = malloc(PAYLOAD_LEN * 2 + 1);
+	char name[64];
+	double start;
+
+	for (size_t i = 0; i < PAYLOAD_LEN; ++i)
+		arr[i] = (byte)(i * 131 + 7);
+
+	for (uint8_t k = 0; k < 3; ++k)
+	{
+		if (hex_select(impls[k]) != SUCCEEDED)
+			continue;
+
+		start = bench_now();
+		for (size_t i = 0; i < ROUNDS; ++i)
+			bytearr_to_hexstr_case(arr, PAYLOAD_LEN, str, HEX_LOWER);
+		snprintf(name, sizeof(name), "hex/encode/%s", names[k]);
+		bench_report(name, (size_t)ROUNDS * PAYLOAD_LEN, bench_now() - start);
+
+		start = bench_now();
+		for (size_t i = 0; i < ROUNDS; ++i)
+			hexstr_to_bytearr(str, PAYLOAD_LEN * 2, arr);
+		snprintf(name, sizeof(name), "hex/decode/%s", names[k]);
+		bench_report(name, (size_t)ROUNDS * PAYLOAD_LEN, bench_now() - start);
+	}
+	hex_select(HEX_AUTO);
+
+	free(arr);
+	free(str);
+}
@@ -0,0 +1,32 @@
+#include <string.h>
+#include "../bench.h"
+#include "internal/crypto/ripemd160.h"
+
+#define MESSAGES 4096
+#define ROUNDS   50
+
+void bench_RIPEMD160(void)
+{
+	static byte data[MESSAGES * 65], digests[MESSAGES * 20];
+	const char *names[] = {"auto", "scalar", "", "sse4.1", "avx2", "avx512"};
+	const size_t lengths[] = {33, 65};
+	char name[64];
+
+	for (size_t i = 0; i < sizeof(data); ++i)
+		data[i] = (byte)i;
+
+	for (RIPEMD160_IMPL impl = RIPEMD160_AUTO; impl <= RIPEMD160_AVX512; ++impl)
+	{
+		if (ripemd160_select(impl) != SUCCEEDED)
+			continue;
+		for (uint8_t l = 0; l < 2; ++l)
+		{
+			double start = bench_now();
+			for (uint32_t r = 0; r < ROUNDS; ++r)
+				hash160_batch(data, lengths[l], lengths[l], MESSAGES, digests);
+			snprintf(name, sizeof(name), "hash160_batch/%s/%zu", names[impl], lengths[l]);
+			bench_report(name, MESSAGES * ROUNDS, bench_now() - start);
+		}
+	}
+	ripemd160_select(RIPEMD160_AUTO);
+}
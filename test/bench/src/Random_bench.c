@@ -0,0 +1,28 @@
+#include <stdlib.h>
+#include "../bench.h"
+#include "internal/crypto/random.h"
+#include "internal/address.h"
+
+#define KEYS 100000
+
+void bench_Random(void)
+{
+	byte *keys = (byte *)malloc(KEYS * 32);
+	double start;
+
+	start = bench_now();
+	for (uint32_t i = 0; i < KEYS; ++i)
+		ecdsa_secp256k1_generate_private_key(keys + i * 32);
+	bench_report("ecdsa_secp256k1_generate_private_key", KEYS, bench_now() - start);
+
+	start = bench_now();
+	ecdsa_secp256k1_generate_private_keys(keys, KEYS);
+	bench_report("ecdsa_secp256k1_generate_private_keys", KEYS, bench_now() - start);
+
+	start = bench_now();
+	for (uint32_t i = 0; i < 10; ++i)
+		random_bytes(keys, KEYS * 32);
+	bench_report("random_bytes/MB", 10 * KEYS * 32 / 1000000, bench_now() - start);
+
+	free(keys);
+}
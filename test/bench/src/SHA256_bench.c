@@ -0,0 +1,32 @@
+#include <string.h>
+#include "../bench.h"
+#include "internal/crypto/sha256.h"
+
+#define MESSAGES 4096
+#define ROUNDS   50
+
+void bench_SHA256(void)
+{
+	static byte data[MESSAGES * 38], digests[MESSAGES * 32];
+	const char *names[] = {"auto", "scalar", "sha-ni", "sse4.1", "avx2", "avx512"};
+	const size_t lengths[] = {21, 38};
+	char name[64];
+
+	for (size_t i = 0; i < sizeof(data); ++i)
+		data[i] = (byte)i;
+
+	for (SHA256_IMPL impl = SHA256_AUTO; impl <= SHA256_AVX512; ++impl)
+	{
+		if (sha256_select(impl) != SUCCEEDED)
+			continue;
+		for (uint8_t l = 0; l < 2; ++l)
+		{
+			double start = bench_now();
+			for (uint32_t r = 0; r < ROUNDS; ++r)
+				sha256d_batch(data, lengths[l], lengths[l], MESSAGES, digests);
+			snprintf(name, sizeof(name), "sha256d_batch/%s/%zu", names[impl], lengths[l]);
+			bench_report(name, MESSAGES * ROUNDS, bench_now() - start);
+		}
+	}
+	sha256_select(SHA256_AUTO);
+}
@@ -0,0 +1,73 @@
+#include <stdlib.h>
+#include <string.h>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include "../bench.h"
+#include "internal/crypto/secp256k1.h"
+
+#define KEYS 20000
+
+// The replaced path: a fresh EC_KEY, EC_POINT, BN_CTX and BIGNUM per key.
+static void openssl_pubkey_create(const byte *seckey, byte *pub)
+{
+	EC_KEY *key = EC_KEY_new_by_curve_name(714);
+	const EC_GROUP *group = EC_KEY_get0_group(key);
+	EC_POINT *point = EC_POINT_new(group);
+	BN_CTX *ctx = BN_CTX_new();
+	BIGNUM *bn = BN_bin2bn(seckey, 32, NULL);
+
+	EC_POINT_mul(group, point, bn, NULL, NULL, ctx);
+	EC_POINT_point2oct(group, point, POINT_CONVERSION_COMPRESSED, pub, 33, ctx);
+
+	BN_free(bn);
+	EC_POINT_free(point);
+	BN_CTX_free(ctx);
+	EC_KEY_free(key);
+}
+
+void bench_Secp256k1(void)
+{
+	byte seckey[32], pub[65];
+	double start;
+
+	for (uint8_t i = 0; i < 32; ++i)
+		seckey[i] = (byte)(i * 29 + 7);
+
+	// Build the table outside of the timing.
+	secp256k1_pubkey_create(seckey, pub, true);
+
+	start = bench_now();
+	for (uint32_t i = 0; i < KEYS / 10; ++i)
+	{
+		seckey[0] = (byte)i;
+		openssl_pubkey_create(seckey, pub);
+	}
+	bench_report("pubkey_create/openssl", KEYS / 10, bench_now() - start);
+
+	start = bench_now();
+	for (uint32_t i = 0; i < KEYS; ++i)
+	{
+		seckey[0] = (byte)i;
+		secp256k1_pubkey_create(seckey, pub, true);
+	}
+	bench_report("secp256k1_pubkey_create/compressed", KEYS, bench_now() - start);
+
+	start = bench_now();
+	for (uint32_t i = 0; i < KEYS; ++i)
+	{
+		seckey[0] = (byte)i;
+		secp256k1_pubkey_create(seckey, pub, false);
+	}
+	bench_report("secp256k1_pubkey_create/uncompressed", KEYS, bench_now() - start);
+
+	byte *seckeys = (byte *)malloc(KEYS * 32), *pubs = (byte *)malloc(KEYS * 33);
+	Status *statuses = (Status *)malloc(KEYS * sizeof(Status));
+	for (size_t i = 0; i < KEYS * 32; ++i)
+		seckeys[i] = (byte)(i * 131 + (i >> 5));
+
+	start = bench_now();
+	secp256k1_pubkey_create_batch(seckeys, KEYS, pubs, true, statuses);
+	bench_report("secp256k1_pubkey_create_batch", KEYS, bench_now() - start);
+
+	free(seckeys); free(pubs); free(statuses);
+}
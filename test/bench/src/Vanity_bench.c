@@ -0,0 +1,26 @@
+#include "../bench.h"
+#include "internal/vanity.h"
+
+#define KEYS 2000000
+
+void bench_Vanity(void)
+{
+	// Patterns that never hit in KEYS keys, so every key is tested.
+	VanityConfig config = {
+		.compress = true, .addr_type = MAINNET_P2PKH, .threads = 0, .max_hits = 1, .max_keys = KEYS,
+	};
+	const uint8_t *patterns[] = {(const uint8_t *)"1Bitcoin", (const uint8_t *)"1bitcoin", (const uint8_t *)"00000000"};
+	const VANITY_MATCH matches[] = {VANITY_PREFIX, VANITY_PREFIX_NOCASE, VANITY_HASH160_PREFIX};
+	const char *names[] = {"vanity_search/prefix", "vanity_search/prefix_nocase", "vanity_search/hash160"};
+	VanityHit hit;
+	VanityStats stats;
+	size_t count;
+
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		config.pattern = patterns[i];
+		config.match = matches[i];
+		vanity_search(&config, &hit, &count, &stats);
+		bench_report(names[i], stats.keys, stats.seconds * 1e9);
+	}
+}
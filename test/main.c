@@ -4,14 +4,23 @@
 
 int main(int argc, char const *argv[])
 {
-/*
-	Suite * XXXXX_suite =  make_XXXXX_suite();
-	SRunner *sr = srunner_create(XXXXX_suite);
+	SRunner *sr = srunner_create(make_CStack_suite());
+	srunner_add_suite(sr, make_CLinkedlist_suite());
+	srunner_add_suite(sr, make_Script_suite());
+	srunner_add_suite(sr, make_Base58_suite());
+	srunner_add_suite(sr, make_Address_suite());
+	srunner_add_suite(sr, make_SHA256_suite());
+	srunner_add_suite(sr, make_RIPEMD160_suite());
+	srunner_add_suite(sr, make_Secp256k1_suite());
+	srunner_add_suite(sr, make_Vanity_suite());
+	srunner_add_suite(sr, make_Random_suite());
+	srunner_add_suite(sr, make_Hex_suite());
+	srunner_add_suite(sr, make_Base64_suite());
+	srunner_add_suite(sr, make_Bigint_suite());
+	srunner_add_suite(sr, make_Uint256_suite());
 	srunner_run_all(sr, CK_NORMAL);
-	
+
 	int number_failed = srunner_ntests_failed(sr);
 	srunner_free(sr);
 	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
-	return 0;
-*/
-}
\ No newline at end of file
+}
@@ -0,0 +1,177 @@
+#include <check.h>
+#include <stdio.h>
+#include <string.h>
+#include "internal/address.h"
+
+// Genesis block coinbase address.
+const char *addr_genesis = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa";
+byte hash160_genesis[20] = {0x62,0xe9,0x07,0xb1,0x5c,0xbf,0x27,0xd5,0x42,0x53,\
+0x99,0xeb,0xf6,0xf0,0xfb,0x50,0xeb,0xb8,0x8f,0x18};
+byte pub_genesis[65] = {0x04,0x67,0x8a,0xfd,0xb0,0xfe,0x55,0x48,0x27,0x19,0x67,0xf1,0xa6,0x71,0x30,0xb7,\
+0x10,0x5c,0xd6,0xa8,0x28,0xe0,0x39,0x09,0xa6,0x79,0x62,0xe0,0xea,0x1f,0x61,0xde,\
+0xb6,0x49,0xf6,0xbc,0x3f,0x4c,0xef,0x38,0xc4,0xf3,0x55,0x04,0xe5,0x1e,0xc1,0x12,\
+0xde,0x5c,0x38,0x4d,0xf7,0xba,0x0b,0x8d,0x57,0x8a,0x4c,0x70,0x2b,0x6b,0xf1,0x1d,\
+0x5f};
+
+START_TEST(address_hash160)
+{
+	byte hash160[20];
+	ck_assert_ptr_eq(address_to_hash160((uint8_t *)addr_genesis, hash160), SUCCEEDED);
+	ck_assert_int_eq(memcmp(hash160, hash160_genesis, 20), 0);
+
+	// Last character changed, checksum mismatch.
+	ck_assert_ptr_eq(address_to_hash160((uint8_t *)"1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNb", hash160), FAILED);
+}
+END_TEST
+
+START_TEST(address_hash160_batch)
+{
+	uint8_t *addresses[5] = {
+		(uint8_t *)addr_genesis,
+		(uint8_t *)"1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNb",
+		(uint8_t *)"1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfN0",
+		(uint8_t *)"1A1zP1eP5QGef",
+		(uint8_t *)addr_genesis,
+	};
+	byte hash160s[5 * 20];
+	Status statuses[5];
+
+	ck_assert_uint_eq(address_to_hash160_batch(addresses, 5, hash160s, statuses), 2);
+	ck_assert_ptr_eq(statuses[0], SUCCEEDED);
+	ck_assert_ptr_eq(statuses[1], ADDRESS_INVALID_CHECKSUM);
+	ck_assert_ptr_eq(statuses[2], ADDRESS_INVALID_CHARACTER);
+	ck_assert_ptr_eq(statuses[3], ADDRESS_INVALID_LENGTH);
+	ck_assert_ptr_eq(statuses[4], SUCCEEDED);
+	ck_assert_int_eq(memcmp(hash160s, hash160_genesis, 20), 0);
+	ck_assert_int_eq(memcmp(hash160s + 80, hash160_genesis, 20), 0);
+}
+END_TEST
+
+START_TEST(address_hash160_lines)
+{
+	char buffer[200 * 36];
+	size_t len = 0, count;
+	for (uint32_t i = 0; i < 200; ++i)
+		len += sprintf(buffer + len, i % 2 ? "%s\r\n" : "%s\n", i % 3 ? addr_genesis : "1BadAddress");
+
+	byte hash160s[200 * 20];
+	Status statuses[200];
+	ck_assert_uint_eq(address_to_hash160_lines((uint8_t *)buffer, len, hash160s, statuses, 200, &count), 133);
+	ck_assert_uint_eq(count, 200);
+	for (uint32_t i = 0; i < 200; ++i)
+	{
+		ck_assert_ptr_eq(statuses[i], i % 3 ? SUCCEEDED : ADDRESS_INVALID_LENGTH);
+	}
+	ck_assert_int_eq(memcmp(hash160s + 199 * 20, hash160_genesis, 20), 0);
+
+	// Stop at the capacity.
+	ck_assert_uint_eq(address_to_hash160_lines((uint8_t *)buffer, len, hash160s, statuses, 10, &count), 6);
+	ck_assert_uint_eq(count, 10);
+}
+END_TEST
+
+START_TEST(address_pub_to_address_batch)
+{
+	byte pubs[70 * 65];
+	uint8_t address[ADDRESS_SLOT_SIZE], addresses[70 * ADDRESS_SLOT_SIZE];
+
+	pub_to_address(pub_genesis, address, false, MAINNET_P2PKH);
+	ck_assert_str_eq((char *)address, addr_genesis);
+
+	// More keys than one block, every slot gets the same address.
+	for (size_t i = 0; i < 70; ++i)
+		memcpy(pubs + i * 65, pub_genesis, 65);
+	pub_to_address_batch(pubs, 70, addresses, false, MAINNET_P2PKH);
+	for (size_t i = 0; i < 70; ++i)
+		ck_assert_str_eq((char *)addresses + i * ADDRESS_SLOT_SIZE, addr_genesis);
+}
+END_TEST
+
+// Compare 'count' walked keys from 'start' against one multiplication per key.
+static void check_key_walk(const byte *start, size_t count, size_t step)
+{
+	KeyWalker walker;
+	byte seckey[32], pubs[600 * 33], hash160s[600 * 20], expected[33], hash160[20];
+	uint8_t addresses[600 * ADDRESS_SLOT_SIZE], address[ADDRESS_SLOT_SIZE];
+	size_t walked = 0;
+
+	ck_assert_ptr_eq(key_walker_init(&walker, start), SUCCEEDED);
+	while (walked < count)
+	{
+		size_t got = key_walker_next(&walker, step, pubs + walked * 33, hash160s + walked * 20,
+			addresses + walked * ADDRESS_SLOT_SIZE, true, MAINNET_P2PKH);
+		ck_assert_uint_eq(got, step);
+		walked += got;
+	}
+
+	memcpy(seckey, start, 32);
+	for (size_t i = 0; i < count; ++i)
+	{
+		ck_assert_ptr_eq(ecdsa_secp256k1_privkey_to_pubkey(seckey, expected, true), SUCCEEDED);
+		ck_assert_int_eq(memcmp(pubs + i * 33, expected, 33), 0);
+		pub_to_address(expected, address, true, MAINNET_P2PKH);
+		ck_assert_str_eq((char *)addresses + i * ADDRESS_SLOT_SIZE, (char *)address);
+		ck_assert_ptr_eq(address_to_hash160(address, hash160), SUCCEEDED);
+		ck_assert_int_eq(memcmp(hash160s + i * 20, hash160, 20), 0);
+		for (int8_t j = 31; j >= 0 && ++seckey[j] == 0; --j);
+	}
+}
+
+START_TEST(address_key_walker)
+{
+	byte start[32];
+
+	// Across blocks, in calls that don't line up with them.
+	for (uint8_t i = 0; i < 32; ++i)
+		start[i] = (byte)(i * 29 + 7);
+	check_key_walk(start, 600, 150);
+
+	// From 1, the first additions are doublings.
+	memset(start, 0, 32);
+	start[31] = 1;
+	check_key_walk(start, 300, 300);
+}
+END_TEST
+
+START_TEST(address_key_walker_end)
+{
+	KeyWalker walker;
+	byte start[32] = {0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xfe,\
+0xba,0xae,0xdc,0xe6,0xaf,0x48,0xa0,0x3b,0xbf,0xd2,0x5e,0x8c,0xd0,0x36,0x41,0x40};
+	byte pubs[10 * 33], expected[33];
+
+	// n - 5 ... n - 1, then the walk is over.
+	start[31] -= 4;
+	ck_assert_ptr_eq(key_walker_init(&walker, start), SUCCEEDED);
+	ck_assert_uint_eq(key_walker_next(&walker, 10, pubs, NULL, NULL, true, MAINNET_P2PKH), 5);
+	ck_assert(walker.exhausted);
+	ck_assert_uint_eq(key_walker_next(&walker, 10, pubs, NULL, NULL, true, MAINNET_P2PKH), 0);
+
+	for (uint8_t i = 0; i < 5; ++i)
+	{
+		ecdsa_secp256k1_privkey_to_pubkey(start, expected, true);
+		ck_assert_int_eq(memcmp(pubs + i * 33, expected, 33), 0);
+		start[31]++;
+	}
+	ck_assert_ptr_eq(key_walker_init(&walker, start), FAILED);
+}
+END_TEST
+
+Suite * make_Address_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Address");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, address_hash160);
+	tcase_add_test(tc_core, address_hash160_batch);
+	tcase_add_test(tc_core, address_hash160_lines);
+	tcase_add_test(tc_core, address_pub_to_address_batch);
+	tcase_add_test(tc_core, address_key_walker);
+	tcase_add_test(tc_core, address_key_walker_end);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
@@ -0,0 +1,351 @@
+#include <check.h>
+#include <stdlib.h>
+#include <string.h>
+#include "internal/codec/base.h"
+
+// Mainnet P2PKH address and its 25-byte payload (version + hash160 + checksum).
+byte b58_address_raw[25] = {0x00,0x62,0xe9,0x07,0xb1,0x5c,0xbf,0x27,0xd5,0x42,0x53,0x99,0xeb,\
+0xf6,0xf0,0xfb,0x50,0xeb,0xb8,0x8f,0x18,0xc2,0x9b,0x7d,0x93};
+const char *b58_address_str = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa";
+
+START_TEST(base58_encoding)
+{
+	ck_assert_uint_eq(base58encode(b58_address_raw, 25, NULL), 34);
+
+	uint8_t encoded[35];
+	ck_assert_uint_eq(base58encode(b58_address_raw, 25, encoded), 0);
+	ck_assert_str_eq((char *)encoded, b58_address_str);
+
+	byte zeros[3] = {0x00, 0x00, 0x00};
+	ck_assert_uint_eq(base58encode(zeros, 3, encoded), 0);
+	ck_assert_str_eq((char *)encoded, "111");
+}
+END_TEST
+
+START_TEST(base58_decoding)
+{
+	ck_assert_uint_eq(base58decode((uint8_t *)b58_address_str, 34, NULL), 25);
+
+	byte decoded[25];
+	ck_assert_uint_eq(base58decode((uint8_t *)b58_address_str, 34, decoded), 0);
+	for (uint8_t i = 0; i < 25; ++i)
+	{
+		ck_assert_uint_eq(decoded[i], b58_address_raw[i]);
+	}
+
+	// '0', 'O', 'I' and 'l' are not in the base58 alphabet.
+	ck_assert_uint_eq(base58decode((uint8_t *)"1A0zP", 5, NULL), (size_t)-1);
+	ck_assert_uint_eq(base58decode((uint8_t *)"1AlzP", 5, decoded), (size_t)-1);
+}
+END_TEST
+
+START_TEST(base58_decode_fixed)
+{
+	byte decoded[26];
+	ck_assert_uint_eq(base58decode_fixed((uint8_t *)b58_address_str, 34, decoded, 25), 0);
+	ck_assert_int_eq(memcmp(decoded, b58_address_raw, 25), 0);
+
+	ck_assert_uint_eq(base58decode_fixed((uint8_t *)b58_address_str, 34, decoded, 24), (size_t)-2);
+	ck_assert_uint_eq(base58decode_fixed((uint8_t *)b58_address_str, 34, decoded, 26), (size_t)-2);
+	ck_assert_uint_eq(base58decode_fixed((uint8_t *)"1A0zP", 5, decoded, 4), (size_t)-1);
+}
+END_TEST
+
+START_TEST(base58_round_trip)
+{
+	byte payload[64], decoded[64];
+	uint8_t encoded[128];
+	for (uint8_t len = 0; len < 64; ++len)
+	{
+		for (uint8_t i = 0; i < len; ++i)
+			payload[i] = i < len / 8 ? 0x00 : (byte)(i * 37 + len);
+
+		ck_assert_uint_eq(base58encode(payload, len, encoded), 0);
+		size_t encoded_len = strlen((char *)encoded);
+		ck_assert_uint_eq(base58decode(encoded, encoded_len, NULL), len);
+		ck_assert_uint_eq(base58decode(encoded, encoded_len, decoded), 0);
+		ck_assert_int_eq(memcmp(payload, decoded, len), 0);
+	}
+}
+END_TEST
+
+// The sizes with a specialized path, against the generic decoder.
+START_TEST(base58_fixed_sizes)
+{
+	// WIF of the same key, 0x80 + key + checksum, and with the 0x01 compress suffix.
+	byte wif[38] = {0x80,0x0c,0x28,0xfc,0xa3,0x86,0xc7,0xa2,0x27,0x60,0x0b,0x2f,0xe5,0x0b,0x7c,0xae,0x11,\
+0xec,0x86,0xd3,0xbf,0x1f,0xbe,0x47,0x1b,0xe8,0x98,0x27,0xe1,0x9d,0x72,0xaa,0x1d};
+	uint8_t encoded[64];
+	byte payload[38], decoded[38];
+
+	ck_assert_uint_eq(base58check_encode(wif, 33, encoded), 0);
+	ck_assert_str_eq((char *)encoded, "5HueCGU8rMjxEXxiPuD5BDku4MkFqeZyd4dZ1jvhTVqvbTLvyTJ");
+	wif[33] = 0x01;
+	ck_assert_uint_eq(base58check_encode(wif, 34, encoded), 0);
+	ck_assert_str_eq((char *)encoded, "KwdMAjGmerYanjeui5SHS7JkmpZvVipYvB2LJGU1ZxJwYvP98617");
+
+	const size_t sizes[5] = {21, 25, 33, 37, 38};
+	for (uint8_t k = 0; k < 5; ++k)
+	{
+		size_t len = sizes[k];
+		for (size_t zeros = 0; zeros <= len; zeros += 3)
+		{
+			for (size_t i = 0; i < len; ++i)
+				payload[i] = i < zeros ? 0x00 : (byte)(0xff - i * 11);
+
+			ck_assert_uint_eq(base58encode(payload, len, encoded), 0);
+			size_t encoded_len = strlen((char *)encoded);
+			ck_assert_uint_eq(base58encode(payload, len, NULL), encoded_len);
+			ck_assert_uint_eq(base58decode(encoded, encoded_len, NULL), len);
+			ck_assert_uint_eq(base58decode_fixed(encoded, encoded_len, decoded, len), 0);
+			ck_assert_int_eq(memcmp(payload, decoded, len), 0);
+
+			// One leading '1' too few.
+			if (zeros)
+				ck_assert_uint_eq(base58decode_fixed(encoded + 1, encoded_len - 1, decoded, len), (size_t)-2);
+		}
+	}
+	// Too big for the size.
+	ck_assert_uint_eq(base58decode_fixed((uint8_t *)"zzzzzzzzzzzzzzzzzzzzzzzzzzzzzz", 30, decoded, 21), (size_t)-2);
+}
+END_TEST
+
+START_TEST(base58_single_pass)
+{
+	uint8_t encoded[BASE6_ENCODE_BOUND(40)]; // The largest bound passed below.
+	byte payload[40], decoded[40];
+	size_t len;
+
+	// Too small stores the needed length, the exact size succeeds.
+	ck_assert_ptr_eq(base58_encode(b58_address_raw, 25, encoded, 34, &len), CODEC_BUFFER_TOO_SMALL);
+	ck_assert_uint_eq(len, 34);
+	ck_assert_ptr_eq(base58_encode(b58_address_raw, 25, encoded, 35, &len), SUCCEEDED);
+	ck_assert_uint_eq(len, 34);
+	ck_assert_str_eq((char *)encoded, b58_address_str);
+
+	ck_assert_ptr_eq(base58_decode((uint8_t *)b58_address_str, 34, decoded, 24, &len), CODEC_BUFFER_TOO_SMALL);
+	ck_assert_uint_eq(len, 25);
+	ck_assert_ptr_eq(base58_decode((uint8_t *)b58_address_str, 34, decoded, 25, &len), SUCCEEDED);
+	ck_assert_int_eq(memcmp(decoded, b58_address_raw, 25), 0);
+	ck_assert_ptr_eq(base58_decode((uint8_t *)"1A0z", 4, decoded, 40, &len), CODEC_INVALID_CHARACTER);
+
+	// Base58Check of the version + hash160 gives the same address.
+	ck_assert_ptr_eq(base58_check_encode(b58_address_raw, 21, encoded, sizeof(encoded), &len), SUCCEEDED);
+	ck_assert_str_eq((char *)encoded, b58_address_str);
+	ck_assert_ptr_eq(base58_check_decode(encoded, len, decoded, 20, &len), CODEC_BUFFER_TOO_SMALL);
+	ck_assert_uint_eq(len, 21);
+	ck_assert_ptr_eq(base58_check_decode(encoded, 34, decoded, 21, &len), SUCCEEDED);
+	ck_assert_int_eq(memcmp(decoded, b58_address_raw, 21), 0);
+	encoded[33] = encoded[33] == 'a' ? 'b' : 'a';
+	ck_assert_ptr_eq(base58_check_decode(encoded, 34, decoded, 21, &len), CODEC_INVALID_CHECKSUM);
+
+	// Base58Check payloads past the stack buffer.
+	byte *large = malloc(300), *large_decoded = malloc(300);
+	uint8_t *large_encoded = malloc(BASE58_ENCODE_BOUND(304));
+	for (size_t i = 0; i < 300; ++i)
+		large[i] = (byte)(i * 37 + 1);
+	ck_assert_ptr_eq(base58_check_encode(large, 300, large_encoded, BASE58_ENCODE_BOUND(304), &len), SUCCEEDED);
+	ck_assert_ptr_eq(base58_check_decode(large_encoded, len, large_decoded, 300, &len), SUCCEEDED);
+	ck_assert_uint_eq(len, 300);
+	ck_assert_int_eq(memcmp(large, large_decoded, 300), 0);
+	free(large);
+	free(large_decoded);
+	free(large_encoded);
+
+	// The worst-case bounds hold for all-0xff and all-0x00 payloads.
+	for (size_t n = 0; n <= 40; ++n)
+	{
+		for (byte fill = 0x00; ; fill = 0xff)
+		{
+			memset(payload, fill, n);
+			ck_assert_uint_le(BASE58_ENCODE_BOUND(n), sizeof(encoded));
+			ck_assert_ptr_eq(base58_encode(payload, n, encoded, BASE58_ENCODE_BOUND(n), &len), SUCCEEDED);
+			ck_assert_ptr_eq(base58_decode(encoded, len, decoded, BASE58_DECODE_BOUND(len), &len), SUCCEEDED);
+			ck_assert_uint_eq(len, n);
+			ck_assert_int_eq(memcmp(payload, decoded, n), 0);
+			ck_assert_uint_le(BASE6_ENCODE_BOUND(n), sizeof(encoded));
+			ck_assert_ptr_eq(base6_encode(payload, n, encoded, BASE6_ENCODE_BOUND(n), &len), SUCCEEDED);
+			ck_assert_ptr_eq(base6_decode(encoded, len, decoded, BASE6_DECODE_BOUND(len), &len), SUCCEEDED);
+			ck_assert_uint_eq(len, n);
+			ck_assert_int_eq(memcmp(payload, decoded, n), 0);
+			ck_assert_uint_le(BASE10_ENCODE_BOUND(n), sizeof(encoded));
+			ck_assert_ptr_eq(base10_encode(payload, n, encoded, BASE10_ENCODE_BOUND(n), &len), SUCCEEDED);
+			ck_assert_ptr_eq(base10_decode(encoded, len, decoded, BASE10_DECODE_BOUND(len), &len), SUCCEEDED);
+			ck_assert_uint_eq(len, n);
+			ck_assert_int_eq(memcmp(payload, decoded, n), 0);
+			if (fill == 0xff)
+				break;
+		}
+	}
+}
+END_TEST
+
+START_TEST(base6_leading_zeros)
+{
+	byte payload[4] = {0x00, 0x00, 0x01, 0x00}, decoded[4];
+	uint8_t encoded[16];
+	size_t len;
+
+	// 0x0100 is 256 = 1104 in base 6, each 0x00 byte is one '0'.
+	ck_assert_ptr_eq(base6_encode(payload, 4, encoded, sizeof(encoded), &len), SUCCEEDED);
+	ck_assert_str_eq((char *)encoded, "001104");
+	ck_assert_ptr_eq(base6_decode(encoded, len, decoded, sizeof(decoded), &len), SUCCEEDED);
+	ck_assert_uint_eq(len, 4);
+	ck_assert_int_eq(memcmp(payload, decoded, 4), 0);
+
+	ck_assert_uint_eq(base6encode(payload + 2, 1, NULL), 1);
+	ck_assert_uint_eq(base6encode(payload + 3, 1, encoded), 0);
+	ck_assert_str_eq((char *)encoded, "0");
+	ck_assert_uint_eq(base6decode((uint8_t *)"0001104", 7, NULL), 5);
+	ck_assert_uint_eq(base6decode((uint8_t *)"0161", 4, NULL), (size_t)-1);
+}
+END_TEST
+
+START_TEST(base10_vectors)
+{
+	byte payload[33], decoded[33];
+	uint8_t encoded[82];
+	size_t len;
+
+	// 2^256 - 1 spans many 10^9 chunks, and the leading 0x00 stays a '0'.
+	const char *max = "0115792089237316195423570985008687907853269984665640564039457584007913129639935";
+	payload[0] = 0x00;
+	memset(payload + 1, 0xff, 32);
+	ck_assert_ptr_eq(base10_encode(payload, 33, encoded, sizeof(encoded), &len), SUCCEEDED);
+	ck_assert_str_eq((char *)encoded, max);
+	ck_assert_ptr_eq(base10_decode(encoded, len, decoded, sizeof(decoded), &len), SUCCEEDED);
+	ck_assert_uint_eq(len, 33);
+	ck_assert_int_eq(memcmp(payload, decoded, 33), 0);
+
+	// 10^9 exactly, a chunk of zeros under a digit.
+	byte billion[4] = {0x3b, 0x9a, 0xca, 0x00};
+	ck_assert_ptr_eq(base10_encode(billion, 4, encoded, sizeof(encoded), &len), SUCCEEDED);
+	ck_assert_str_eq((char *)encoded, "1000000000");
+	ck_assert_ptr_eq(base10_encode(billion, 4, encoded, 10, &len), CODEC_BUFFER_TOO_SMALL);
+	ck_assert_uint_eq(len, 10);
+	ck_assert_ptr_eq(base10_decode((uint8_t *)"999999999", 9, decoded, sizeof(decoded), &len), SUCCEEDED);
+	ck_assert_uint_eq(len, 4);
+	ck_assert_int_eq(memcmp(decoded, (byte[]){0x3b, 0x9a, 0xc9, 0xff}, 4), 0);
+	ck_assert_ptr_eq(base10_decode((uint8_t *)"12a4", 4, decoded, sizeof(decoded), &len), CODEC_INVALID_CHARACTER);
+}
+END_TEST
+
+START_TEST(base_large_payloads)
+{
+	// At and past each divide-and-conquer threshold, Base58 from 2 KiB, Base6 and decimal from 24 KiB.
+	// Every buffer is allocated at the bound passed as its capacity.
+	static const size_t sizes[] = {2047, 2048, 4096, 24576, 32768};
+	typedef Status (*Encode)(const byte *, size_t, uint8_t *, size_t, size_t *);
+	typedef Status (*Decode)(const uint8_t *, size_t, byte *, size_t, size_t *);
+	static const Encode encode[3] = {base6_encode, base10_encode, base58_encode};
+	static const Decode decode[3] = {base6_decode, base10_decode, base58_decode};
+	static const char *alphabets[3] = {"012345", "0123456789", "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz"};
+	byte *payload = malloc(32768);
+	size_t len, decoded_len;
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+	{
+		size_t n = sizes[s];
+		size_t encode_bounds[3] = {BASE6_ENCODE_BOUND(n), BASE10_ENCODE_BOUND(n), BASE58_ENCODE_BOUND(n)};
+
+		for (int k = 0; k < 3; ++k)
+		{
+			uint8_t *encoded = malloc(encode_bounds[k]);
+
+			// All 0xff, then two leading zero bytes and a mixed value.
+			for (int fill = 0; fill < 2; ++fill)
+			{
+				for (size_t i = 0; i < n; ++i)
+					payload[i] = fill ? (i < 2 ? 0x00 : (byte)(i * 131 + 7)) : 0xff;
+				ck_assert_ptr_eq(encode[k](payload, n, encoded, encode_bounds[k], &len), SUCCEEDED);
+				ck_assert_ptr_eq(encode[k](payload, n, encoded, len, &len), CODEC_BUFFER_TOO_SMALL);
+
+				size_t decode_bounds[3] = {BASE6_DECODE_BOUND(len), BASE10_DECODE_BOUND(len), BASE58_DECODE_BOUND(len)};
+				byte *decoded = malloc(decode_bounds[k]);
+				ck_assert_ptr_eq(decode[k](encoded, len, decoded, decode_bounds[k], &decoded_len), SUCCEEDED);
+				ck_assert_uint_eq(decoded_len, n);
+				ck_assert_int_eq(memcmp(payload, decoded, n), 0);
+				free(decoded);
+			}
+			free(encoded);
+		}
+	}
+
+	// 2^262144 - 1 has a known digit count. A digit string that long comes back the same, and a
+	// bad character at its end is caught.
+	static const size_t counts[3] = {101412, 78914, 44750};
+	memset(payload, 0xff, 32768);
+	for (int k = 0; k < 3; ++k)
+	{
+		size_t count = counts[k], base = strlen(alphabets[k]);
+		size_t encode_bounds[3] = {BASE6_ENCODE_BOUND(32768), BASE10_ENCODE_BOUND(32768), BASE58_ENCODE_BOUND(32768)};
+		size_t decode_bounds[3] = {BASE6_DECODE_BOUND(count), BASE10_DECODE_BOUND(count), BASE58_DECODE_BOUND(count)};
+		uint8_t *encoded = malloc(encode_bounds[k]), *digits = malloc(count);
+		byte *decoded = malloc(decode_bounds[k]);
+
+		ck_assert_ptr_eq(encode[k](payload, 32768, encoded, encode_bounds[k], &len), SUCCEEDED);
+		ck_assert_uint_eq(len, count);
+
+		digits[0] = (uint8_t)alphabets[k][1];
+		for (size_t i = 1; i < count; ++i)
+			digits[i] = (uint8_t)alphabets[k][(i * 7919 + i / 13) % base];
+		ck_assert_ptr_eq(decode[k](digits, count, decoded, decode_bounds[k], &decoded_len), SUCCEEDED);
+		ck_assert_ptr_eq(encode[k](decoded, decoded_len, encoded, encode_bounds[k], &len), SUCCEEDED);
+		ck_assert_uint_eq(len, count);
+		ck_assert_int_eq(memcmp(digits, encoded, count), 0);
+		digits[count - 1] = '!';
+		ck_assert_ptr_eq(decode[k](digits, count, decoded, decode_bounds[k], &decoded_len), CODEC_INVALID_CHARACTER);
+
+		free(encoded);
+		free(digits);
+		free(decoded);
+	}
+	free(payload);
+
+	// Megabytes of leading zeros in front of a one byte value, the zeros map one to one.
+	size_t zeros = 4 << 20;
+	payload = calloc(zeros + 1, 1);
+	payload[zeros] = 0x01;
+	for (int k = 0; k < 3; ++k)
+	{
+		size_t encode_bounds[3] = {BASE6_ENCODE_BOUND(zeros + 1), BASE10_ENCODE_BOUND(zeros + 1),
+			BASE58_ENCODE_BOUND(zeros + 1)};
+		uint8_t *encoded = malloc(encode_bounds[k]);
+		byte *decoded = malloc(zeros + 1);
+
+		ck_assert_ptr_eq(encode[k](payload, zeros + 1, encoded, encode_bounds[k], &len), SUCCEEDED);
+		ck_assert_uint_eq(len, zeros + 1);
+		ck_assert_uint_eq(encoded[0], alphabets[k][0]);
+		ck_assert_uint_eq(encoded[zeros], alphabets[k][1]);
+		ck_assert_ptr_eq(decode[k](encoded, len, decoded, zeros + 1, &decoded_len), SUCCEEDED);
+		ck_assert_uint_eq(decoded_len, zeros + 1);
+		ck_assert_int_eq(memcmp(payload, decoded, zeros + 1), 0);
+
+		free(encoded);
+		free(decoded);
+	}
+	free(payload);
+}
+END_TEST
+
+Suite * make_Base58_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Base58");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, base58_encoding);
+	tcase_add_test(tc_core, base58_decoding);
+	tcase_add_test(tc_core, base58_decode_fixed);
+	tcase_add_test(tc_core, base58_round_trip);
+	tcase_add_test(tc_core, base58_fixed_sizes);
+	tcase_add_test(tc_core, base58_single_pass);
+	tcase_add_test(tc_core, base6_leading_zeros);
+	tcase_add_test(tc_core, base10_vectors);
+	tcase_add_test(tc_core, base_large_payloads);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
@@ -0,0 +1,195 @@
+#include <check.h>
+#include <string.h>
+#include "internal/codec/base.h"
+
+static const BASE64_IMPL impls[2] = {BASE64_SCALAR, BASE64_AVX2};
+
+// RFC 4648 test vectors.
+static const char *rfc_plain[7] = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
+static const char *rfc_encoded[7] = {"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"};
+
+START_TEST(base64_encoding)
+{
+	uint8_t encoded[16];
+	for (uint8_t i = 0; i < 7; ++i)
+	{
+		size_t len = strlen(rfc_plain[i]);
+		ck_assert_uint_eq(base64encode((byte *)rfc_plain[i], len, NULL), strlen(rfc_encoded[i]));
+		ck_assert_uint_eq(base64encode((byte *)rfc_plain[i], len, encoded), 0);
+		ck_assert_str_eq((char *)encoded, rfc_encoded[i]);
+	}
+
+	// Values that encode to 'A' are not padding.
+	byte zeros[2] = {0x00, 0x00};
+	ck_assert_uint_eq(base64encode(zeros, 2, encoded), 0);
+	ck_assert_str_eq((char *)encoded, "AAA=");
+}
+END_TEST
+
+START_TEST(base64_decoding)
+{
+	byte decoded[16];
+	for (uint8_t i = 0; i < 7; ++i)
+	{
+		size_t len = strlen(rfc_encoded[i]), plain_len = strlen(rfc_plain[i]);
+		ck_assert_uint_eq(base64decode((uint8_t *)rfc_encoded[i], len, NULL), plain_len);
+		ck_assert_uint_eq(base64decode((uint8_t *)rfc_encoded[i], len, decoded), 0);
+		ck_assert_int_eq(memcmp(decoded, rfc_plain[i], plain_len), 0);
+	}
+
+	// Unpadded last quantum.
+	ck_assert_uint_eq(base64decode((uint8_t *)"Zm9vYg", 6, NULL), 4);
+	ck_assert_uint_eq(base64decode((uint8_t *)"Zm9vYg", 6, decoded), 0);
+	ck_assert_int_eq(memcmp(decoded, "foob", 4), 0);
+
+	ck_assert_uint_eq(base64decode((uint8_t *)"Zm9v!mFy", 8, decoded), (size_t)-1);
+	ck_assert_uint_eq(base64decode((uint8_t *)"Zm9vY", 5, decoded), (size_t)-1);
+	ck_assert_uint_eq(base64decode((uint8_t *)"Z===", 4, decoded), (size_t)-1);
+	ck_assert_uint_eq(base64decode((uint8_t *)"Zg=a", 4, decoded), (size_t)-1);
+	ck_assert_uint_eq(base64decode((uint8_t *)"Zg==Zg==", 8, decoded), (size_t)-1);
+	ck_assert_uint_eq(base64decode((uint8_t *)"Zg=", 3, decoded), (size_t)-1);
+}
+END_TEST
+
+// Chunked conversions, cut at every few bytes, match the whole-buffer ones on every kernel.
+START_TEST(base64_stream)
+{
+	byte data[300], decoded[300];
+	uint8_t expected[401], encoded[401];
+	Base64Stream stream;
+	size_t len, total;
+
+	for (size_t i = 0; i < sizeof(data); ++i)
+		data[i] = (byte)(i * 97 + 5);
+
+	for (uint8_t k = 0; k < 2; ++k)
+	{
+		if (base64_select(impls[k]) != SUCCEEDED)
+			continue;
+		ck_assert_int_eq(base64_selected(), impls[k]);
+		for (size_t data_len = 0; data_len <= sizeof(data); data_len += 7)
+		{
+			base64_select(BASE64_SCALAR);
+			base64encode(data, data_len, expected);
+			base64_select(impls[k]);
+			size_t encoded_len = BASE64_ENCODED_LEN(data_len);
+
+			for (size_t chunk = 1; chunk <= 64; chunk = chunk * 2 + 1)
+			{
+				base64_encode_init(&stream);
+				total = 0;
+				for (size_t i = 0; i < data_len; i += chunk)
+					total += base64_encode_update(&stream, data + i, data_len - i < chunk ? data_len - i : chunk, encoded + total);
+				total += base64_encode_final(&stream, encoded + total);
+				ck_assert_uint_eq(total, encoded_len);
+				ck_assert_int_eq(memcmp(encoded, expected, encoded_len), 0);
+
+				base64_decode_init(&stream);
+				total = 0;
+				for (size_t i = 0; i < encoded_len; i += chunk)
+				{
+					ck_assert_ptr_eq(base64_decode_update(&stream, encoded + i,
+						encoded_len - i < chunk ? encoded_len - i : chunk, decoded + total, &len), SUCCEEDED);
+					total += len;
+				}
+				ck_assert_ptr_eq(base64_decode_final(&stream, decoded + total, &len), SUCCEEDED);
+				total += len;
+				ck_assert_uint_eq(total, data_len);
+				ck_assert_int_eq(memcmp(decoded, data, data_len), 0);
+			}
+
+			// A bad character anywhere, including inside a SIMD block.
+			for (size_t pos = 0; pos < encoded_len; pos += 13)
+			{
+				uint8_t saved = encoded[pos];
+				encoded[pos] = '.';
+				base64_decode_init(&stream);
+				ck_assert_ptr_eq(base64_decode_update(&stream, encoded, encoded_len, decoded, &len),
+					BASE64_INVALID_CHARACTER);
+				encoded[pos] = saved;
+			}
+		}
+	}
+	ck_assert_ptr_eq(base64_select(BASE64_AUTO), SUCCEEDED);
+}
+END_TEST
+
+START_TEST(base64_stream_split_quantum)
+{
+	// "Man is" and its padded tail, every quantum cut after one, two and three characters.
+	const uint8_t *encoded = (const uint8_t *)"TWFuIGlzTQ==";
+	byte decoded[16];
+	Base64Stream stream;
+	size_t len, total;
+
+	for (size_t cut = 1; cut < 4; ++cut)
+	{
+		base64_decode_init(&stream);
+		total = 0;
+		for (size_t i = 0; i < 12; )
+		{
+			size_t chunk = i % 4 == 0 ? cut : 4 - cut;
+			ck_assert_ptr_eq(base64_decode_update(&stream, encoded + i, chunk, decoded + total, &len), SUCCEEDED);
+			total += len;
+			i += chunk;
+			ck_assert_uint_le(stream.pending_len, 3);
+		}
+		ck_assert_ptr_eq(base64_decode_final(&stream, decoded + total, &len), SUCCEEDED);
+		total += len;
+		ck_assert_uint_eq(total, 7);
+		ck_assert_int_eq(memcmp(decoded, "Man isM", 7), 0);
+	}
+}
+END_TEST
+
+START_TEST(base64_single_pass)
+{
+	uint8_t encoded[16];
+	byte decoded[16];
+	size_t len;
+
+	for (uint8_t i = 0; i < 7; ++i)
+	{
+		size_t plain_len = strlen(rfc_plain[i]), encoded_len = strlen(rfc_encoded[i]);
+		ck_assert_uint_le(encoded_len + 1, BASE64_ENCODE_BOUND(plain_len));
+		ck_assert_uint_le(plain_len, BASE64_DECODE_BOUND(encoded_len));
+
+		ck_assert_ptr_eq(base64_encode((byte *)rfc_plain[i], plain_len, encoded, encoded_len, &len),
+			CODEC_BUFFER_TOO_SMALL);
+		ck_assert_uint_eq(len, encoded_len);
+		ck_assert_ptr_eq(base64_encode((byte *)rfc_plain[i], plain_len, encoded, encoded_len + 1, &len), SUCCEEDED);
+		ck_assert_str_eq((char *)encoded, rfc_encoded[i]);
+
+		if (plain_len > 0)
+		{
+			ck_assert_ptr_eq(base64_decode((uint8_t *)rfc_encoded[i], encoded_len, decoded, plain_len - 1, &len),
+				CODEC_BUFFER_TOO_SMALL);
+			ck_assert_uint_eq(len, plain_len);
+		}
+		ck_assert_ptr_eq(base64_decode((uint8_t *)rfc_encoded[i], encoded_len, decoded, plain_len, &len), SUCCEEDED);
+		ck_assert_uint_eq(len, plain_len);
+		ck_assert_int_eq(memcmp(decoded, rfc_plain[i], plain_len), 0);
+	}
+
+	ck_assert_ptr_eq(base64_decode((uint8_t *)"Zm9v=", 5, decoded, 16, &len), BASE64_INVALID_PADDING);
+	ck_assert_ptr_eq(base64_decode((uint8_t *)"Zm.v", 4, decoded, 16, &len), BASE64_INVALID_CHARACTER);
+}
+END_TEST
+
+Suite * make_Base64_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Base64");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, base64_encoding);
+	tcase_add_test(tc_core, base64_decoding);
+	tcase_add_test(tc_core, base64_stream);
+	tcase_add_test(tc_core, base64_stream_split_quantum);
+	tcase_add_test(tc_core, base64_single_pass);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
@@ -0,0 +1,604 @@
+#include <check.h>
+#include <stdlib.h>
+#include <string.h>
+#include "internal/codec/base.h"
+#include "internal/crypto/bigint.h"
+#include "internal/crypto/ntt.h"
+#include "internal/crypto/secp256k1.h"
+
+START_TEST(bigint_radix_conversion)
+{
+	uint8_t bytes[40], bytes_back[40];
+	uint16_t halves[20], halves_back[20];
+	uint32_t words[10];
+
+	for (size_t len = 1; len <= 40; ++len)
+	{
+		for (size_t i = 0; i < len; ++i)
+			bytes[i] = (uint8_t)(i * 37 + 1);
+
+		size_t words_len = base2p8_to_base2p32(bytes, len, NULL);
+		ck_assert_uint_eq(words_len, (len + 3) / 4);
+		ck_assert_uint_eq(base2p8_to_base2p32(bytes, len, words), 0);
+		for (size_t i = 0; i < len; ++i)
+			ck_assert_uint_eq((words[i / 4] >> (i % 4 * 8)) & 0xff, bytes[i]);
+		for (size_t i = len; i < words_len * 4; ++i)
+			ck_assert_uint_eq((words[i / 4] >> (i % 4 * 8)) & 0xff, 0);
+
+		ck_assert_uint_eq(base2p32_to_base2p8(words, words_len, NULL), len);
+		ck_assert_uint_eq(base2p32_to_base2p8(words, words_len, bytes_back), 0);
+		ck_assert_int_eq(memcmp(bytes, bytes_back, len), 0);
+
+		size_t halves_len = base2p32_to_base2p16(words, words_len, NULL);
+		ck_assert_uint_eq(halves_len, (len + 1) / 2);
+		ck_assert_uint_eq(base2p32_to_base2p16(words, words_len, halves), 0);
+		for (size_t i = 0; i < halves_len; ++i)
+			ck_assert_uint_eq(halves[i], (words[i / 2] >> (i % 2 * 16)) & 0xffff);
+
+		ck_assert_uint_eq(base2p16_to_base2p32(halves, halves_len, NULL), words_len);
+		memset(words, 0xff, sizeof(words));
+		ck_assert_uint_eq(base2p16_to_base2p32(halves, halves_len, words), 0);
+		ck_assert_uint_eq(base2p32_to_base2p16(words, words_len, halves_back), 0);
+		ck_assert_int_eq(memcmp(halves, halves_back, halves_len * sizeof(uint16_t)), 0);
+	}
+
+	// A zero top byte is dropped, in place.
+	uint32_t buffer[3] = {0};
+	memcpy(buffer, "\x01\x02\x03\x04\x05\x00", 6);
+	ck_assert_uint_eq(base2p8_to_base2p32((uint8_t *)buffer, 6, NULL), 2);
+	ck_assert_uint_eq(base2p8_to_base2p32((uint8_t *)buffer, 6, buffer), 0);
+	ck_assert_uint_eq(buffer[0], 0x04030201);
+	ck_assert_uint_eq(buffer[1], 0x00000005);
+}
+END_TEST
+
+START_TEST(bigint_set_bytearr)
+{
+	byte arr[7] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x00, 0x00};
+	Bigint *bn = Bigint_set_bytearr(arr, 7, true);
+	ck_assert_uint_eq(bn->len, 2);
+	ck_assert_uint_eq(bn->d[0], 0x04030201);
+	ck_assert_uint_eq(bn->d[1], 0x00000005);
+	ck_assert(bn->neg);
+	delete_Bigint(bn);
+
+	memset(arr, 0x00, 7);
+	bn = Bigint_set_bytearr(arr, 7, false);
+	ck_assert_uint_eq(bn->len, 1);
+	ck_assert_uint_eq(bn->d[0], 0);
+	delete_Bigint(bn);
+}
+END_TEST
+
+START_TEST(bigint_ntt_plan)
+{
+	uint32_t a[16], x[16];
+	uint64_t y[16];
+
+	for (uint32_t k = 0; k < NTT_PRIME_COUNT; ++k)
+	{
+		const uint64_t p = ntt_primes[k];
+		for (uint32_t len = 1; len <= 16; len <<= 1)
+		{
+			NttPlan *plan = new_NttPlan(len, k);
+			ck_assert(plan != MEMORY_ALLOCATE_FAILED);
+			for (uint32_t i = 0; i < len; ++i)
+				a[i] = x[i] = (i * 2654435761u + k) % p;
+
+			// The forward transform is the DFT in natural order, w the primitive len-th root in the plan.
+			uint64_t w = len >= 4 ? plan->twiddles[len / 2 + 1] : len == 2 ? p - 1 : 1;
+			if (len > 1)
+				ck_assert_uint_eq(quick_power_mod(w, len / 2, p), p - 1);
+			ntt_execute(plan, x, false);
+			for (uint32_t i = 0; i < len; ++i)
+			{
+				uint64_t sum = 0, wi = quick_power_mod(w, i, p);
+				for (uint32_t j = len; j--; )
+					sum = (sum * wi + a[j]) % p;
+				ck_assert_uint_eq(x[i], sum);
+			}
+
+			ntt_execute(plan, x, true);
+			ck_assert_int_eq(memcmp(x, a, len * sizeof(uint32_t)), 0);
+			delete_NttPlan(plan);
+		}
+	}
+
+	for (uint32_t i = 0; i < 16; ++i)
+		y[i] = i * 2654435761u;
+	ck_assert(ntt(y, 16, false) == SUCCEEDED);
+	ck_assert(ntt(y, 16, true) == SUCCEEDED);
+	for (uint32_t i = 0; i < 16; ++i)
+		ck_assert_uint_eq(y[i], i * 2654435761u % P);
+}
+END_TEST
+
+// The four-step spectrum is the radix-2 one in transposed order, on every kernel.
+START_TEST(bigint_ntt_four_step)
+{
+	static const uint32_t lens[] = {256, 512, 2048};
+	const NTT_IMPL impls[3] = {NTT_SCALAR, NTT_AVX2, NTT_AVX512};
+	uint32_t a[2048], expected[2048], x[2048];
+
+	for (uint32_t k = 0; k < NTT_PRIME_COUNT; ++k)
+	{
+		for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l)
+		{
+			const uint32_t len = lens[l];
+			NttPlan *radix2 = new_NttPlan(len, k), *four_step = new_NttPlan_four_step(len, k);
+			ck_assert(radix2 != MEMORY_ALLOCATE_FAILED && four_step != MEMORY_ALLOCATE_FAILED);
+			const uint32_t rows = four_step->col_plan->len, cols = four_step->row_plan->len;
+			ck_assert_uint_eq(rows * cols, len);
+
+			for (uint32_t i = 0; i < len; ++i)
+				a[i] = expected[i] = i % 5 ? (uint32_t)((i * 2654435761u) % ntt_primes[k]) : (uint32_t)ntt_primes[k] - 1;
+			ntt_execute(radix2, expected, false);
+
+			for (uint8_t impl = 0; impl < 3; ++impl)
+			{
+				if (ntt_select(impls[impl]) != SUCCEEDED)
+					continue;
+				memcpy(x, a, len * sizeof(uint32_t));
+				ntt_execute(four_step, x, false);
+				for (uint32_t k_r = 0; k_r < rows; ++k_r)
+					for (uint32_t k_c = 0; k_c < cols; ++k_c)
+						ck_assert_uint_eq(x[k_r * cols + k_c], expected[k_r + rows * k_c]);
+
+				ntt_execute(four_step, x, true);
+				ck_assert_int_eq(memcmp(x, a, len * sizeof(uint32_t)), 0);
+			}
+			delete_NttPlan(radix2);
+			delete_NttPlan(four_step);
+		}
+	}
+	ck_assert_ptr_eq(ntt_select(NTT_AUTO), SUCCEEDED);
+
+	// Too short for strips, a radix-2 plan is the same order with one row.
+	NttPlan *plan = new_NttPlan_four_step(64, 0);
+	ck_assert(plan != MEMORY_ALLOCATE_FAILED);
+	ck_assert_ptr_eq(plan->col_plan, NULL);
+	delete_NttPlan(plan);
+}
+END_TEST
+
+// Every kernel against the scalar one, from stages shorter than the lanes to a few full ones.
+START_TEST(bigint_ntt_kernels)
+{
+	const NTT_IMPL impls[3] = {NTT_SCALAR, NTT_AVX2, NTT_AVX512};
+	const uint32_t len = 1024;
+	uint32_t a[1024], expected[1024], x[1024];
+
+	for (uint32_t k = 0; k < NTT_PRIME_COUNT; ++k)
+	{
+		NttPlan *plan = new_NttPlan(len, k);
+		ck_assert(plan != MEMORY_ALLOCATE_FAILED);
+		// Residues up to p - 1 exercise the conditional subtractions.
+		for (uint32_t i = 0; i < len; ++i)
+			a[i] = i % 3 ? (uint32_t)((i * 2654435761u) % ntt_primes[k]) : (uint32_t)ntt_primes[k] - 1;
+
+		ck_assert_ptr_eq(ntt_select(NTT_SCALAR), SUCCEEDED);
+		memcpy(expected, a, sizeof(a));
+		ntt_execute(plan, expected, false);
+
+		for (uint8_t i = 1; i < 3; ++i)
+		{
+			if (ntt_select(impls[i]) != SUCCEEDED)
+				continue;
+			ck_assert_int_eq(ntt_selected(), impls[i]);
+			memcpy(x, a, sizeof(a));
+			ntt_execute(plan, x, false);
+			ck_assert_int_eq(memcmp(x, expected, sizeof(x)), 0);
+			ntt_execute(plan, x, true);
+			ck_assert_int_eq(memcmp(x, a, sizeof(x)), 0);
+		}
+		delete_NttPlan(plan);
+	}
+	ck_assert_ptr_eq(ntt_select(NTT_AUTO), SUCCEEDED);
+	ck_assert_int_eq(ntt_selected(), NTT_AUTO);
+}
+END_TEST
+
+START_TEST(bigint_mul_algorithms)
+{
+	static const uint32_t lens[][2] = {{1, 1}, {3, 7}, {31, 32}, {32, 32}, {33, 100}, {100, 33}, {257, 64}, {300, 300}};
+	const BigintMulConfig configs[] = {{UINT32_MAX, UINT32_MAX}, {4, UINT32_MAX}, {32, UINT32_MAX}, {4, 4}};
+	uint32_t a[300], b[300], expected[600], r[600];
+	BigintMulConfig saved;
+
+	Bigint_mul_config_get(&saved);
+	for (uint32_t i = 0; i < 300; ++i)
+	{
+		a[i] = i * 2654435761u + 0xffff0000;
+		b[i] = i % 5 ? ~i * 40503u : 0xffffffff;
+	}
+
+	for (size_t k = 0; k < sizeof(lens) / sizeof(lens[0]); ++k)
+	{
+		uint32_t a_len = lens[k][0], b_len = lens[k][1];
+
+		// Schoolbook is the reference.
+		Bigint_mul_config_set(&configs[0]);
+		ck_assert(d_mul(a, a_len, b, b_len, expected) == SUCCEEDED);
+		for (size_t c = 1; c < sizeof(configs) / sizeof(configs[0]); ++c)
+		{
+			Bigint_mul_config_set(&configs[c]);
+			memset(r, 0xaa, sizeof(r));
+			ck_assert(d_mul(a, a_len, b, b_len, r) == SUCCEEDED);
+			ck_assert_int_eq(memcmp(r, expected, (a_len + b_len) * sizeof(uint32_t)), 0);
+		}
+	}
+
+	// (2^64 - 1)^2 = 2^128 - 2^65 + 1.
+	uint32_t ones[2] = {0xffffffff, 0xffffffff};
+	ck_assert(d_mul(ones, 2, ones, 2, r) == SUCCEEDED);
+	ck_assert_uint_eq(r[0], 1);
+	ck_assert_uint_eq(r[1], 0);
+	ck_assert_uint_eq(r[2], 0xfffffffe);
+	ck_assert_uint_eq(r[3], 0xffffffff);
+
+	Bigint_mul_config_set(&saved);
+}
+END_TEST
+
+START_TEST(bigint_mul_ntt_exact)
+{
+	// All-ones limbs give the largest coefficients, (2^32 - 1)^2 * n.
+	const uint32_t n = 4096;
+	const BigintMulConfig karatsuba = {32, UINT32_MAX}, ntt = {32, 32};
+	uint32_t *a = malloc(n * sizeof(uint32_t)), *expected = malloc(2 * n * sizeof(uint32_t));
+	uint32_t *r = malloc(2 * n * sizeof(uint32_t));
+	BigintMulConfig saved;
+
+	Bigint_mul_config_get(&saved);
+	memset(a, 0xff, n * sizeof(uint32_t));
+	Bigint_mul_config_set(&karatsuba);
+	ck_assert(d_mul(a, n, a, n, expected) == SUCCEEDED);
+	Bigint_mul_config_set(&ntt);
+	ck_assert(d_mul(a, n, a, n, r) == SUCCEEDED);
+	ck_assert_int_eq(memcmp(r, expected, 2 * n * sizeof(uint32_t)), 0);
+	// (2^k - 1)^2 = 2^2k - 2^(k + 1) + 1.
+	ck_assert_uint_eq(r[0], 1);
+	ck_assert_uint_eq(r[n], 0xfffffffe);
+	ck_assert_uint_eq(r[2 * n - 1], 0xffffffff);
+
+	Bigint_mul_config_set(&saved);
+	free(a);
+	free(expected);
+	free(r);
+}
+END_TEST
+
+// Split across threads, the transforms and the products are the serial ones.
+START_TEST(bigint_mul_parallel)
+{
+	static const uint32_t threads[] = {0, 2, 3, 7, NTT_MAX_THREADS + 1};
+	static const uint32_t lens[][2] = {{3000, 2500}, {5000, 300}, {40, 4000}};
+	const BigintMulConfig parallel = {32, 64, 64}, serial = {32, 64, UINT32_MAX};
+	const uint32_t len = 4096, max_len = 5000; // Transform length, longest operand in 'lens'.
+	uint32_t *a = malloc(max_len * sizeof(uint32_t)), *b = malloc(max_len * sizeof(uint32_t));
+	uint32_t *expected = malloc(2 * max_len * sizeof(uint32_t)), *r = malloc(2 * max_len * sizeof(uint32_t));
+	BigintMulConfig saved;
+
+	for (uint32_t k = 0; k < NTT_PRIME_COUNT; ++k)
+	{
+		NttPlan *plan = new_NttPlan_four_step(len, k);
+		ck_assert(plan != MEMORY_ALLOCATE_FAILED);
+		for (uint32_t i = 0; i < len; ++i)
+			a[i] = (uint32_t)((i * 2654435761u) % ntt_primes[k]);
+		memcpy(expected, a, len * sizeof(uint32_t));
+		ntt_execute(plan, expected, false);
+		for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t)
+		{
+			memcpy(r, a, len * sizeof(uint32_t));
+			ntt_execute_parallel(plan, r, false, threads[t]);
+			ck_assert_int_eq(memcmp(r, expected, len * sizeof(uint32_t)), 0);
+			ntt_execute_parallel(plan, r, true, threads[t]);
+			ck_assert_int_eq(memcmp(r, a, len * sizeof(uint32_t)), 0);
+		}
+		delete_NttPlan(plan);
+	}
+
+	Bigint_mul_config_get(&saved);
+	for (uint32_t i = 0; i < max_len; ++i)
+	{
+		a[i] = i * 2654435761u + 0xffff0000;
+		b[i] = i % 5 ? ~i * 40503u : 0xffffffff;
+	}
+	for (size_t k = 0; k < sizeof(lens) / sizeof(lens[0]); ++k)
+	{
+		uint32_t a_len = lens[k][0], b_len = lens[k][1];
+		ck_assert_uint_le(a_len, max_len);
+		ck_assert_uint_le(b_len, max_len);
+
+		Bigint_mul_config_set(&serial);
+		ck_assert(d_mul(a, a_len, b, b_len, expected) == SUCCEEDED);
+		for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t)
+		{
+			// Below the cutoff, then split.
+			Bigint_mul_config_set(&serial);
+			memset(r, 0xaa, 2 * max_len * sizeof(uint32_t));
+			ck_assert(d_mul_parallel(a, a_len, b, b_len, r, threads[t]) == SUCCEEDED);
+			ck_assert_int_eq(memcmp(r, expected, (a_len + b_len) * sizeof(uint32_t)), 0);
+			Bigint_mul_config_set(&parallel);
+			memset(r, 0xaa, 2 * max_len * sizeof(uint32_t));
+			ck_assert(d_mul_parallel(a, a_len, b, b_len, r, threads[t]) == SUCCEEDED);
+			ck_assert_int_eq(memcmp(r, expected, (a_len + b_len) * sizeof(uint32_t)), 0);
+		}
+	}
+
+	// The Bigint wrapper keeps the sign and strips the top zero limbs.
+	byte x[8] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+	Bigint *p = Bigint_set_bytearr(x, 8, true), *q = Bigint_set_bytearr(x, 4, false);
+	Bigint *pq = Bigint_mul_parallel(p, q, 2);
+	ck_assert_uint_eq(pq->len, 3);
+	ck_assert_uint_eq(pq->d[0], 1);
+	ck_assert_uint_eq(pq->d[2], 0xfffffffe);
+	ck_assert(pq->neg);
+	delete_Bigint(pq);
+	delete_Bigint(p);
+	delete_Bigint(q);
+
+	Bigint_mul_config_set(&saved);
+	free(a);
+	free(b);
+	free(expected);
+	free(r);
+}
+END_TEST
+
+START_TEST(bigint_mul)
+{
+	byte x[8] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, zero[4] = {0};
+	Bigint *a = Bigint_set_bytearr(x, 8, true), *b = Bigint_set_bytearr(x, 4, false);
+	Bigint *z = Bigint_set_bytearr(zero, 4, false);
+
+	// -(2^64 - 1) * (2^32 - 1) = -(2^96 - 2^64 - 2^32 + 1).
+	Bigint *r = Bigint_mul(a, b);
+	ck_assert_uint_eq(r->len, 3);
+	ck_assert_uint_eq(r->d[0], 1);
+	ck_assert_uint_eq(r->d[1], 0xffffffff);
+	ck_assert_uint_eq(r->d[2], 0xfffffffe);
+	ck_assert(r->neg);
+	delete_Bigint(r);
+
+	// No negative zero, and the top zero limbs are stripped.
+	r = Bigint_mul(a, z);
+	ck_assert_uint_eq(r->len, 1);
+	ck_assert_uint_eq(r->d[0], 0);
+	ck_assert(!r->neg);
+	delete_Bigint(r);
+
+	delete_Bigint(a);
+	delete_Bigint(b);
+	delete_Bigint(z);
+}
+END_TEST
+
+static Bigint * bigint_of(const uint32_t *d, uint32_t len, bool neg)
+{
+	Bigint *bn = new_Bigint();
+	bn->d = (uint32_t *)malloc(len * sizeof(uint32_t));
+	memcpy(bn->d, d, len * sizeof(uint32_t));
+	bn->len = len;
+	bn->neg = neg;
+	return bn;
+}
+
+static void ck_bigint_eq(Bigint *bn, const uint32_t *d, uint32_t len)
+{
+	ck_assert(bn != MEMORY_ALLOCATE_FAILED && bn != BIGINT_INVALID_MODULUS && bn != BIGINT_NOT_INVERTIBLE);
+	ck_assert_uint_eq(bn->len, len);
+	ck_assert_int_eq(memcmp(bn->d, d, len * sizeof(uint32_t)), 0);
+	ck_assert(!bn->neg);
+	delete_Bigint(bn);
+}
+
+START_TEST(bigint_pow)
+{
+	Bigint * (*const pows[2])(Bigint *, Bigint *, Bigint *) = {Bigint_pow, Bigint_pow_consttime};
+	// {a, e, m, a^e (mod m)} with signs.
+	static const int32_t smalls[][4] = {{2, 10, 1001, 23}, {-2, 3, 7, 6}, {3, 0, 7, 1}, {2, -1, 7, 4}, {5, 3, 1, 0}, {7, 5, 7, 0}};
+	// A 160-bit modulus, a 224-bit base and a 96-bit exponent.
+	static const uint32_t m[] = {0x52e6b439, 0xf2a74de4, 0x269e0d37, 0x6513270e, 0xa6a3a450};
+	static const uint32_t a[] = {0x0c5c7fd0, 0x128b2f33, 0xd23f0824, 0x892f902b, 0x1818e811, 0x5d9dc9f8, 0x9531985d};
+	static const uint32_t e[] = {0x0ed90475, 0xe8e25d94, 0x81e74ef5};
+	static const uint32_t expected[] = {0x280b2e70, 0x5718fc50, 0xa3f76361, 0x50f69945, 0x0fd55145};
+	static const uint32_t p[] = {0xfffffc2f, 0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+	static const uint32_t p_1[] = {0xfffffc2e, 0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+	static const uint32_t zero = 0, one[] = {1}, even[] = {10}, six[] = {6}, nine[] = {9};
+
+	for (uint8_t k = 0; k < 2; ++k)
+	{
+		for (size_t i = 0; i < sizeof(smalls) / sizeof(smalls[0]); ++i)
+		{
+			uint32_t x = (uint32_t)abs(smalls[i][0]), y = (uint32_t)abs(smalls[i][1]), z = (uint32_t)smalls[i][2];
+			uint32_t r = (uint32_t)smalls[i][3];
+			Bigint *bx = bigint_of(&x, 1, smalls[i][0] < 0), *by = bigint_of(&y, 1, smalls[i][1] < 0);
+			Bigint *bz = bigint_of(&z, 1, false);
+			ck_bigint_eq(pows[k](bx, by, bz), &r, 1);
+			delete_Bigint(bx); delete_Bigint(by); delete_Bigint(bz);
+		}
+
+		Bigint *ba = bigint_of(a, 7, false), *be = bigint_of(e, 3, false), *bm = bigint_of(m, 5, false);
+		ck_bigint_eq(pows[k](ba, be, bm), expected, 5);
+		delete_Bigint(bm);
+
+		// Fermat: a^(p - 1) = 1 (mod p).
+		Bigint *bp = bigint_of(p, 8, false), *bp_1 = bigint_of(p_1, 8, false);
+		ck_bigint_eq(pows[k](ba, bp_1, bp), one, 1);
+
+		// Even and negative moduli, and a negative exponent without an inverse.
+		Bigint *b_even = bigint_of(even, 1, false), *b_six = bigint_of(six, 1, false), *b_nine = bigint_of(nine, 1, false);
+		ck_assert_ptr_eq(pows[k](ba, be, b_even), BIGINT_INVALID_MODULUS);
+		bp->neg = true;
+		ck_assert_ptr_eq(pows[k](ba, be, bp), BIGINT_INVALID_MODULUS);
+		be->neg = true;
+		ck_assert_ptr_eq(pows[k](b_six, be, b_nine), BIGINT_NOT_INVERTIBLE);
+		// -0 is still 0, the same base gives 1.
+		Bigint *b_neg_zero = bigint_of(&zero, 1, true);
+		ck_bigint_eq(pows[k](b_six, b_neg_zero, b_nine), one, 1);
+
+		delete_Bigint(ba); delete_Bigint(be); delete_Bigint(bp); delete_Bigint(bp_1);
+		delete_Bigint(b_even); delete_Bigint(b_six); delete_Bigint(b_nine); delete_Bigint(b_neg_zero);
+	}
+}
+END_TEST
+
+START_TEST(bigint_ext)
+{
+	static const uint32_t m[] = {0x52e6b439, 0xf2a74de4, 0x269e0d37, 0x6513270e, 0xa6a3a450};
+	static const uint32_t a[] = {0x0c5c7fd0, 0x128b2f33, 0xd23f0824, 0x892f902b, 0x1818e811, 0x5d9dc9f8, 0x9531985d};
+	static const uint32_t expected[] = {0x12e016e6, 0x251799f3, 0x582f35f1, 0x6c8accf9, 0x134bc6ec};
+	static const uint32_t p[] = {0xfffffc2f, 0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+	static const uint32_t zero[] = {0}, one[] = {1}, two[] = {2}, three[] = {3}, six[] = {6}, seven[] = {7}, nine[] = {9};
+
+	Bigint *ba = bigint_of(a, 7, false), *bm = bigint_of(m, 5, false);
+	ck_bigint_eq(Bigint_ext(ba, bm), expected, 5);
+
+	// -3 * 2 = 1 (mod 7), no inverse when the gcd isn't 1, everything is 0 mod 1.
+	Bigint *b_zero = bigint_of(zero, 1, false), *b_one = bigint_of(one, 1, false), *b_three = bigint_of(three, 1, true);
+	Bigint *b_six = bigint_of(six, 1, false), *b_seven = bigint_of(seven, 1, false), *b_nine = bigint_of(nine, 1, false);
+	ck_bigint_eq(Bigint_ext(b_three, b_seven), two, 1);
+	ck_assert_ptr_eq(Bigint_ext(b_six, b_nine), BIGINT_NOT_INVERTIBLE);
+	ck_assert_ptr_eq(Bigint_ext(b_zero, b_seven), BIGINT_NOT_INVERTIBLE);
+	ck_assert_ptr_eq(Bigint_ext(b_three, b_six), BIGINT_INVALID_MODULUS);
+	ck_bigint_eq(Bigint_ext(ba, b_one), zero, 1);
+
+	// Field inversions agree with the secp256k1 ones.
+	Bigint *bp = bigint_of(p, 8, false);
+	for (uint32_t k = 0; k < 16; ++k)
+	{
+		byte bytes[32];
+		FieldElement x, inv;
+		for (uint8_t i = 0; i < 32; ++i)
+			bytes[i] = (byte)(k * 97 + i * 31 + 1);
+		secp256k1_fe_set_bytes(&x, bytes);
+		secp256k1_fe_inv(&inv, &x);
+
+		uint32_t x_limbs[8], inv_limbs[8];
+		for (uint8_t i = 0; i < 8; ++i)
+		{
+			x_limbs[i] = (uint32_t)(x.n[i / 2] >> (i % 2 * 32));
+			inv_limbs[i] = (uint32_t)(inv.n[i / 2] >> (i % 2 * 32));
+		}
+		Bigint *bx = bigint_of(x_limbs, 8, false);
+		Bigint *r = Bigint_ext(bx, bp);
+		ck_assert(r != MEMORY_ALLOCATE_FAILED && r != BIGINT_NOT_INVERTIBLE);
+		ck_assert_int_eq(memcmp(r->d, inv_limbs, r->len * sizeof(uint32_t)), 0);
+		delete_Bigint(r);
+		delete_Bigint(bx);
+	}
+
+	delete_Bigint(ba); delete_Bigint(bm); delete_Bigint(bp);
+	delete_Bigint(b_zero); delete_Bigint(b_one); delete_Bigint(b_three);
+	delete_Bigint(b_six); delete_Bigint(b_seven); delete_Bigint(b_nine);
+}
+END_TEST
+
+START_TEST(bigint_div_algorithms)
+{
+	// One limb, Algorithm D, a divisor with only its top bit set, and the Newton path.
+	static const uint32_t lens[][2] = {{1, 1}, {9, 1}, {2, 2}, {7, 3}, {50, 49}, {300, 64}, {64, 300}, {10000, 4200}};
+	const uint32_t max = 10000;
+	uint32_t *a = malloc(max * sizeof(uint32_t)), *b = malloc(max * sizeof(uint32_t));
+	uint32_t *q = malloc((max + 1) * sizeof(uint32_t)), *r = malloc(max * sizeof(uint32_t));
+	uint32_t *t = malloc((2 * max + 1) * sizeof(uint32_t));
+
+	for (size_t k = 0; k < sizeof(lens) / sizeof(lens[0]); ++k)
+	{
+		for (uint8_t fill = 0; fill < 3; ++fill)
+		{
+			uint32_t a_len = lens[k][0], b_len = lens[k][1];
+			uint32_t q_len = a_len < b_len ? 1 : a_len - b_len + 1;
+			for (uint32_t i = 0; i < a_len; ++i)
+				a[i] = fill == 1 ? 0xffffffff : i * 2654435761u + 0xffff0000;
+			for (uint32_t i = 0; i < b_len; ++i)
+				b[i] = fill == 2 ? 0 : ~i * 40503u;
+			b[b_len - 1] = fill == 2 ? 0x80000000 : b[b_len - 1] | 1;
+
+			// a = q * b + r with r < b.
+			ck_assert(d_div(a, a_len, b, b_len, q, r) == SUCCEEDED);
+			ck_assert(d_mul(q, q_len, b, b_len, t) == SUCCEEDED);
+			uint64_t c = 0;
+			for (uint32_t i = 0; i <= a_len; ++i)
+			{
+				c += (uint64_t)t[i] + (i < b_len ? r[i] : 0);
+				t[i] = (uint32_t)c;
+				c >>= 32;
+			}
+			ck_assert_int_eq(memcmp(t, a, a_len * sizeof(uint32_t)), 0);
+			ck_assert_uint_eq(t[a_len], 0);
+			uint32_t i = b_len - 1;
+			while (i > 0 && r[i] == b[i])
+				--i;
+			ck_assert(r[i] < b[i]);
+		}
+	}
+
+	// floor((2^96 - 1) / (2^64 - 1)) = 2^32, the remainder is 2^32 - 1.
+	uint32_t ones[3] = {0xffffffff, 0xffffffff, 0xffffffff};
+	ck_assert(d_div(ones, 3, ones, 2, q, r) == SUCCEEDED);
+	ck_assert_uint_eq(q[0], 0);
+	ck_assert_uint_eq(q[1], 1);
+	ck_assert_uint_eq(r[0], 0xffffffff);
+	ck_assert_uint_eq(r[1], 0);
+
+	uint32_t zero[2] = {0, 0};
+	ck_assert(d_div(ones, 3, zero, 2, q, r) == BIGINT_DIVIDE_BY_ZERO);
+	ck_assert(d_div(ones, 3, zero, 0, NULL, NULL) == BIGINT_DIVIDE_BY_ZERO);
+
+	free(a); free(b); free(q); free(r); free(t);
+}
+END_TEST
+
+START_TEST(bigint_div)
+{
+	// (2^128 - 1) / 0xfedcba9876543210 = 0x10124924924924924.
+	uint32_t a[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, b[3] = {0x76543210, 0xfedcba98, 0};
+	uint32_t expected[3] = {0x24924924, 0x01249249, 0x1}, seven = 7, two = 2, zero = 0;
+	Bigint *ba = bigint_of(a, 4, false), *bb = bigint_of(b, 3, false);
+	ck_bigint_eq(Bigint_div(ba, bb), expected, 3);
+
+	// Toward zero: -7 / 2 = -3, 2 / -7 = 0 and not negative.
+	Bigint *b_seven = bigint_of(&seven, 1, true), *b_two = bigint_of(&two, 1, false);
+	Bigint *b_zero = bigint_of(&zero, 1, false);
+	Bigint *r = Bigint_div(b_seven, b_two);
+	ck_assert(r != MEMORY_ALLOCATE_FAILED && r != BIGINT_DIVIDE_BY_ZERO);
+	ck_assert_uint_eq(r->len, 1);
+	ck_assert_uint_eq(r->d[0], 3);
+	ck_assert(r->neg);
+	delete_Bigint(r);
+	uint32_t z = 0;
+	ck_bigint_eq(Bigint_div(b_two, b_seven), &z, 1);
+	ck_assert(Bigint_div(b_seven, b_zero) == BIGINT_DIVIDE_BY_ZERO);
+
+	delete_Bigint(ba); delete_Bigint(bb);
+	delete_Bigint(b_seven); delete_Bigint(b_two); delete_Bigint(b_zero);
+}
+END_TEST
+
+Suite * make_Bigint_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Bigint");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, bigint_radix_conversion);
+	tcase_add_test(tc_core, bigint_set_bytearr);
+	tcase_add_test(tc_core, bigint_ntt_plan);
+	tcase_add_test(tc_core, bigint_ntt_kernels);
+	tcase_add_test(tc_core, bigint_ntt_four_step);
+	tcase_add_test(tc_core, bigint_mul_algorithms);
+	tcase_add_test(tc_core, bigint_mul_ntt_exact);
+	tcase_add_test(tc_core, bigint_mul_parallel);
+	tcase_add_test(tc_core, bigint_mul);
+	tcase_add_test(tc_core, bigint_pow);
+	tcase_add_test(tc_core, bigint_ext);
+	tcase_add_test(tc_core, bigint_div_algorithms);
+	tcase_add_test(tc_core, bigint_div);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
@@ -1,15 +1,15 @@
 #include <check.h>
 #include <string.h>
 #include <stdlib.h>
-#include "../src/container/CLinkedlist.h"
+#include "internal/container/CLinkedlist.h"
 
 START_TEST(clinkedlist_add_and_is_empty)
 {
 	CLinkedlist *list = new_CLinkedlist();
 	ck_assert(list->is_empty(list));
 
-	BYTE *data1 = (BYTE *)malloc(10);
-	ck_assert(list->add(list, data1, 10, BYTE_TYPE));
+	byte *data1 = (byte *)malloc(10);
+	ck_assert_ptr_eq(list->add(list, data1, 10, BYTE_TYPE, true), SUCCEEDED);
 	ck_assert_ptr_eq(list->head->next->data, data1);
 	ck_assert(!(list->is_empty(list)));
 
@@ -20,38 +20,38 @@ END_TEST
 START_TEST(clinkedlist_delete)
 {
 	CLinkedlist *list = new_CLinkedlist();
-	BYTE *data1 = (BYTE *)malloc(10);
-	list->add(list, data1, 10, BYTE_TYPE);
+	byte *data1 = (byte *)malloc(10);
+	list->add(list, data1, 10, BYTE_TYPE, true);
 
-	list->delete(list, 0);
+	ck_assert_ptr_eq(list->del(list, 0), SUCCEEDED);
 	ck_assert_ptr_eq(list->head->next, NULL);
 	ck_assert(list->is_empty(list));
+	ck_assert_ptr_eq(list->del(list, 0), CLINKEDLIST_EMPTY);
 
 	delete_CLinkedlist(list);
-	free(data1);
 }
 END_TEST
 
 START_TEST(clinkedlist_insert)
 {
 	CLinkedlist *list1 = new_CLinkedlist();
-	BYTE *data1 = (BYTE *)malloc(10);
-	BYTE *data2 = (BYTE *)malloc(10);
-	BYTE *data3 = (BYTE *)malloc(10);
-	list1->add(list1, data1, 10, BYTE_TYPE);
-	list1->add(list1, data3, 10, BYTE_TYPE);
-	list1->insert(list1, 1, data2, 10, BYTE_TYPE);
+	byte *data1 = (byte *)malloc(10);
+	byte *data2 = (byte *)malloc(10);
+	byte *data3 = (byte *)malloc(10);
+	list1->add(list1, data1, 10, BYTE_TYPE, true);
+	list1->add(list1, data3, 10, BYTE_TYPE, true);
+	list1->insert(list1, 1, data2, 10, BYTE_TYPE, true);
 	ck_assert_ptr_eq(list1->head->next->data, data1);
 	ck_assert_ptr_eq(list1->head->next->next->data, data2);
 	ck_assert_ptr_eq(list1->head->next->next->next->data, data3);
 
 	CLinkedlist *list2 = new_CLinkedlist();
-	BYTE *data4 = (BYTE *)malloc(10);
-	BYTE *data5 = (BYTE *)malloc(10);
-	BYTE *data6 = (BYTE *)malloc(10);
-	list2->add(list2, data5, 10, BYTE_TYPE);
-	list2->add(list2, data6, 10, BYTE_TYPE);
-	list2->insert(list2, 0, data4, 10, BYTE_TYPE);
+	byte *data4 = (byte *)malloc(10);
+	byte *data5 = (byte *)malloc(10);
+	byte *data6 = (byte *)malloc(10);
+	list2->add(list2, data5, 10, BYTE_TYPE, true);
+	list2->add(list2, data6, 10, BYTE_TYPE, true);
+	list2->insert(list2, 0, data4, 10, BYTE_TYPE, true);
 	ck_assert_ptr_eq(list2->head->next->data, data4);
 	ck_assert_ptr_eq(list2->head->next->next->data, data5);
 	ck_assert_ptr_eq(list2->head->next->next->next->data, data6);
@@ -64,57 +64,59 @@ END_TEST
 START_TEST(clinkedlist_change)
 {
 	CLinkedlist *list = new_CLinkedlist();
-	BYTE *data1 = (BYTE *)malloc(10);
-	BYTE *data2 = (BYTE *)malloc(10);
-	list->add(list, data1, 10, BYTE_TYPE);
-	ck_assert(list->change(list, 0, data2, 10, BYTE_TYPE));
+	byte *data1 = (byte *)malloc(10);
+	byte *data2 = (byte *)malloc(10);
+	list->add(list, data1, 10, BYTE_TYPE, true);
+	ck_assert_ptr_eq(list->change(list, 0, data2, 10, BYTE_TYPE, true), SUCCEEDED);
 	ck_assert_ptr_eq(list->head->next->data, data2);
 	delete_CLinkedlist(list);
 }
 END_TEST
 
-START_TEST(clinkedlist_forward_traversing)
+START_TEST(clinkedlist_forward_iter)
 {
 	CLinkedlist *list = new_CLinkedlist();
-	BYTE *data1 = (BYTE *)malloc(10);
-	BYTE *data2 = (BYTE *)malloc(10);
-	BYTE *data3 = (BYTE *)malloc(10);
-	list->add(list, data1, 10, BYTE_TYPE);
-	list->add(list, data2, 10, BYTE_TYPE);
-	list->add(list, data3, 10, BYTE_TYPE);
+	byte *data1 = (byte *)malloc(10);
+	byte *data2 = (byte *)malloc(10);
+	byte *data3 = (byte *)malloc(10);
+	list->add(list, data1, 10, BYTE_TYPE, true);
+	list->add(list, data2, 10, BYTE_TYPE, true);
+	list->add(list, data3, 10, BYTE_TYPE, true);
 	CLinkedlistNode *node1 = list->head->next;
 	CLinkedlistNode *node2 = list->head->next->next;
 	CLinkedlistNode *node3 = list->head->next->next->next;
-	CLinkedlistNode **nodes = list->forward_traversing(list);
+	CLinkedlistNode **nodes = list->forward_iter(list);
 	ck_assert_ptr_eq(nodes[0], node1);
 	ck_assert_ptr_eq(nodes[1], node2);
 	ck_assert_ptr_eq(nodes[2], node3);
 	ck_assert_ptr_eq(nodes[0]->data, data1);
 	ck_assert_ptr_eq(nodes[1]->data, data2);
 	ck_assert_ptr_eq(nodes[2]->data, data3);
+	free(nodes);
 	delete_CLinkedlist(list);
 }
 END_TEST
 
-START_TEST(clinkedlist_backward_traversing)
+START_TEST(clinkedlist_backward_iter)
 {
 	CLinkedlist *list = new_CLinkedlist();
-	BYTE *data1 = (BYTE *)malloc(10);
-	BYTE *data2 = (BYTE *)malloc(10);
-	BYTE *data3 = (BYTE *)malloc(10);
-	list->add(list, data1, 10, BYTE_TYPE);
-	list->add(list, data2, 10, BYTE_TYPE);
-	list->add(list, data3, 10, BYTE_TYPE);
+	byte *data1 = (byte *)malloc(10);
+	byte *data2 = (byte *)malloc(10);
+	byte *data3 = (byte *)malloc(10);
+	list->add(list, data1, 10, BYTE_TYPE, true);
+	list->add(list, data2, 10, BYTE_TYPE, true);
+	list->add(list, data3, 10, BYTE_TYPE, true);
 	CLinkedlistNode *node1 = list->head->next;
 	CLinkedlistNode *node2 = list->head->next->next;
 	CLinkedlistNode *node3 = list->head->next->next->next;
-	CLinkedlistNode **nodes = list->backward_traversing(list);
+	CLinkedlistNode **nodes = list->backward_iter(list);
 	ck_assert_ptr_eq(nodes[0], node3);
 	ck_assert_ptr_eq(nodes[1], node2);
 	ck_assert_ptr_eq(nodes[2], node1);
 	ck_assert_ptr_eq(nodes[0]->data, data3);
 	ck_assert_ptr_eq(nodes[1]->data, data2);
 	ck_assert_ptr_eq(nodes[2]->data, data1);
+	free(nodes);
 	delete_CLinkedlist(list);
 }
 END_TEST
@@ -122,12 +124,12 @@ END_TEST
 START_TEST(clinkedlist_reverse)
 {
 	CLinkedlist *list = new_CLinkedlist();
-	BYTE *data1 = (BYTE *)malloc(10);
-	BYTE *data2 = (BYTE *)malloc(10);
-	BYTE *data3 = (BYTE *)malloc(10);
-	list->add(list, data1, 10, BYTE_TYPE);
-	list->add(list, data2, 10, BYTE_TYPE);
-	list->add(list, data3, 10, BYTE_TYPE);
+	byte *data1 = (byte *)malloc(10);
+	byte *data2 = (byte *)malloc(10);
+	byte *data3 = (byte *)malloc(10);
+	list->add(list, data1, 10, BYTE_TYPE, true);
+	list->add(list, data2, 10, BYTE_TYPE, true);
+	list->add(list, data3, 10, BYTE_TYPE, true);
 	CLinkedlistNode *node1 = list->head->next;
 	CLinkedlistNode *node2 = list->head->next->next;
 	CLinkedlistNode *node3 = list->head->next->next->next;
@@ -145,15 +147,15 @@ END_TEST
 START_TEST(clinkedlist_total_size)
 {
 	CLinkedlist *list = new_CLinkedlist();
-	ck_assert_uint_eq(list->total_size(list), 0);
-	BYTE *data1 = (BYTE *)malloc(10);
-	BYTE *data2 = (BYTE *)malloc(10);
-	BYTE *data3 = (BYTE *)malloc(10);
-	list->add(list, data1, 10, BYTE_TYPE);
+	ck_assert_uint_eq(list->total_size(list), 0xffffffffffffffff); // Empty.
+	byte *data1 = (byte *)malloc(10);
+	byte *data2 = (byte *)malloc(10);
+	byte *data3 = (byte *)malloc(10);
+	list->add(list, data1, 10, BYTE_TYPE, true);
 	ck_assert_uint_eq(list->total_size(list), 10);
-	list->add(list, data2, 10, BYTE_TYPE);
+	list->add(list, data2, 10, BYTE_TYPE, true);
 	ck_assert_uint_eq(list->total_size(list), 20);
-	list->add(list, data3, 10, BYTE_TYPE);
+	list->add(list, data3, 10, BYTE_TYPE, true);
 	ck_assert_uint_eq(list->total_size(list), 30);
 	delete_CLinkedlist(list);
 }
@@ -162,13 +164,13 @@ END_TEST
 START_TEST(clinkedlist_last_node)
 {
 	CLinkedlist *list = new_CLinkedlist();
-	BYTE *data1 = (BYTE *)malloc(10);
-	BYTE *data2 = (BYTE *)malloc(10);
-	list->add(list, data1, 10, BYTE_TYPE);
+	byte *data1 = (byte *)malloc(10);
+	byte *data2 = (byte *)malloc(10);
+	list->add(list, data1, 10, BYTE_TYPE, true);
 	CLinkedlistNode *last1 = list->last_node(list);
 	ck_assert_ptr_eq(list->head->next, last1);
 	ck_assert_ptr_eq(list->head->next->data, data1);
-	list->add(list, data2, 10, BYTE_TYPE);
+	list->add(list, data2, 10, BYTE_TYPE, true);
 	CLinkedlistNode *last2 = list->last_node(list);
 	ck_assert_ptr_eq(list->head->next->next, last2);
 	ck_assert_ptr_eq(list->head->next->next->data, data2);
@@ -176,21 +178,22 @@ START_TEST(clinkedlist_last_node)
 }
 END_TEST
 
-START_TEST(clinkedlist_specific_node)
+START_TEST(clinkedlist_get_node)
 {
 	CLinkedlist *list = new_CLinkedlist();
-	BYTE *data1 = (BYTE *)malloc(10);
-	BYTE *data2 = (BYTE *)malloc(10);
-	BYTE *data3 = (BYTE *)malloc(10);
-	list->add(list, data1, 10, BYTE_TYPE);
-	list->add(list, data2, 10, BYTE_TYPE);
-	list->add(list, data3, 10, BYTE_TYPE);
+	byte *data1 = (byte *)malloc(10);
+	byte *data2 = (byte *)malloc(10);
+	byte *data3 = (byte *)malloc(10);
+	list->add(list, data1, 10, BYTE_TYPE, true);
+	list->add(list, data2, 10, BYTE_TYPE, true);
+	list->add(list, data3, 10, BYTE_TYPE, true);
 	CLinkedlistNode *node1 = list->head->next;
 	CLinkedlistNode *node2 = list->head->next->next;
 	CLinkedlistNode *node3 = list->head->next->next->next;
-	ck_assert_ptr_eq(list->specific_node(list, 0), node1);
-	ck_assert_ptr_eq(list->specific_node(list, 1), node2);
-	ck_assert_ptr_eq(list->specific_node(list, 2), node3);
+	ck_assert_ptr_eq(list->get_node(list, 0), node1);
+	ck_assert_ptr_eq(list->get_node(list, 1), node2);
+	ck_assert_ptr_eq(list->get_node(list, 2), node3);
+	ck_assert_ptr_eq(list->get_node(list, 3), INDEX_OUT_RANGE);
 	delete_CLinkedlist(list);
 }
 END_TEST
@@ -207,12 +210,12 @@ Suite * make_CLinkedlist_suite(void)
 	tcase_add_test(tc_core, clinkedlist_delete);
 	tcase_add_test(tc_core, clinkedlist_insert);
 	tcase_add_test(tc_core, clinkedlist_change);
-	tcase_add_test(tc_core, clinkedlist_forward_traversing);
-	tcase_add_test(tc_core, clinkedlist_backward_traversing);
+	tcase_add_test(tc_core, clinkedlist_forward_iter);
+	tcase_add_test(tc_core, clinkedlist_backward_iter);
 	tcase_add_test(tc_core, clinkedlist_reverse);
 	tcase_add_test(tc_core, clinkedlist_total_size);
 	tcase_add_test(tc_core, clinkedlist_last_node);
-	tcase_add_test(tc_core, clinkedlist_specific_node);
+	tcase_add_test(tc_core, clinkedlist_get_node);
 	suite_add_tcase(s, tc_core);
 
 	return s;
@@ -1,27 +1,31 @@
 #include <check.h>
 #include <string.h>
 #include <stdlib.h>
-#include "../src/container/CStack.h"
+#include "internal/container/CStack.h"
 
 START_TEST(stack_push_and_pop)
 {
 	CStack *stack = new_CStack(1);
-	BYTE *data = (BYTE *)malloc(2);
+	byte *data = (byte *)malloc(2);
 	data[0] = 0xaa;
 	data[1] = 0xff;
 
-	stack->push(stack, data, 2, BYTE_TYPE);
+	ck_assert_ptr_eq(stack->push(stack, data, 2, BYTE_TYPE, true), SUCCEEDED);
 	size_t popped_size;
 	void *type;
-	BYTE *popped = stack->pop(stack, &popped_size, &type);
+	bool autofree;
+	byte *popped = stack->pop(stack, &popped_size, &type, &autofree);
 
 	ck_assert_ptr_eq(popped, data);
 	ck_assert_ptr_eq(type, BYTE_TYPE);
+	ck_assert(autofree);
 	ck_assert_uint_eq(popped[0], data[0]);
 	ck_assert_uint_eq(popped[1], data[1]);
 	ck_assert_uint_eq(popped_size, 2);
+	ck_assert(stack->is_empty(stack));
 
 	delete_CStack(stack);
+	free(data);
 }
 END_TEST
 
@@ -30,16 +34,15 @@ START_TEST(stack_is_empty_and_is_full)
 	CStack *stack = new_CStack(2);
 	ck_assert(stack->is_empty(stack));
 
-	BYTE *data1 = (BYTE *)malloc(1);
-	BYTE *data2 = (BYTE *)malloc(1);
-	stack->push(stack, data1, 1, BYTE_TYPE);
-	stack->push(stack, data2, 1, BYTE_TYPE);
-	
+	byte *data1 = (byte *)malloc(1);
+	byte *data2 = (byte *)malloc(1);
+	stack->push(stack, data1, 1, BYTE_TYPE, true);
+	stack->push(stack, data2, 1, BYTE_TYPE, true);
+
 	ck_assert(stack->is_full(stack));
+	ck_assert_ptr_eq(stack->push(stack, NULL, 0, NULL, false), CSTACK_FULL);
 
 	delete_CStack(stack);
-	free(data1);
-	free(data2);
 }
 END_TEST
 
@@ -48,17 +51,15 @@ START_TEST(stack_total_size)
 	CStack *stack = new_CStack(2);
 	ck_assert_uint_eq(stack->total_size(stack), 0);
 
-	BYTE *data1 = (BYTE *)malloc(5);
-	stack->push(stack, data1, 5, BYTE_TYPE);
+	byte *data1 = (byte *)malloc(5);
+	stack->push(stack, data1, 5, BYTE_TYPE, true);
 	ck_assert_uint_eq(stack->total_size(stack), 5);
 
-	BYTE *data2 = (BYTE *)malloc(10);
-	stack->push(stack, data1, 10, BYTE_TYPE);
+	byte *data2 = (byte *)malloc(10);
+	stack->push(stack, data2, 10, BYTE_TYPE, true);
 	ck_assert_uint_eq(stack->total_size(stack), 15);
 
 	delete_CStack(stack);
-	free(data1);
-	free(data2);
 }
 END_TEST
 
@@ -0,0 +1,98 @@
+#include <check.h>
+#include <string.h>
+#include "internal/codec/strings.h"
+
+static const HEX_IMPL impls[3] = {HEX_SCALAR, HEX_SSSE3, HEX_AVX2};
+
+START_TEST(hex_encode)
+{
+	byte arr[3] = {0x0a, 0x1b, 0x2c};
+	uint8_t str[7];
+
+	ck_assert_ptr_eq(bytearr_to_hexstr(arr, 3, str), SUCCEEDED);
+	ck_assert_str_eq((char *)str, "0A1B2C");
+	ck_assert_ptr_eq(bytearr_to_hexstr_case(arr, 3, str, HEX_LOWER), SUCCEEDED);
+	ck_assert_str_eq((char *)str, "0a1b2c");
+	ck_assert_ptr_eq(bytearr_to_hexstr(arr, 0, str), SUCCEEDED);
+	ck_assert_str_eq((char *)str, "");
+}
+END_TEST
+
+START_TEST(hex_decode)
+{
+	byte arr[4];
+
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0A1b2C", 6, arr), SUCCEEDED);
+	ck_assert_uint_eq(arr[0], 0x0a);
+	ck_assert_uint_eq(arr[1], 0x1b);
+	ck_assert_uint_eq(arr[2], 0x2c);
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"", 0, arr), SUCCEEDED);
+
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0A1", 3, arr), HEXSTR_ODD_LENGTH);
+	// Just outside the digits and both letter ranges.
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0A/0", 4, arr), HEXSTR_INVALID_CHARACTER);
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0A:0", 4, arr), HEXSTR_INVALID_CHARACTER);
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0A@0", 4, arr), HEXSTR_INVALID_CHARACTER);
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0AG0", 4, arr), HEXSTR_INVALID_CHARACTER);
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0A`0", 4, arr), HEXSTR_INVALID_CHARACTER);
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0Ag0", 4, arr), HEXSTR_INVALID_CHARACTER);
+	ck_assert_ptr_eq(hexstr_to_bytearr((uint8_t *)"0A\xc1" "0", 4, arr), HEXSTR_INVALID_CHARACTER);
+}
+END_TEST
+
+// Every kernel against the scalar one, at lengths around the block sizes.
+START_TEST(hex_kernels)
+{
+	byte arr[200], decoded[200];
+	uint8_t expected[401], str[401];
+
+	for (size_t i = 0; i < sizeof(arr); ++i)
+		arr[i] = (byte)(i * 73 + 11);
+
+	for (uint8_t k = 0; k < 3; ++k)
+	{
+		if (hex_select(impls[k]) != SUCCEEDED)
+			continue;
+		ck_assert_int_eq(hex_selected(), impls[k]);
+		for (size_t len = 0; len <= sizeof(arr); ++len)
+		{
+			for (uint8_t c = 0; c < 2; ++c)
+			{
+				hex_encode_scalar(arr, len, expected, hex_digits[c]);
+				expected[len * 2] = '\0';
+				ck_assert_ptr_eq(bytearr_to_hexstr_case(arr, len, str, (HEX_CASE)c), SUCCEEDED);
+				ck_assert_str_eq((char *)str, (char *)expected);
+
+				ck_assert_ptr_eq(hexstr_to_bytearr(str, len * 2, decoded), SUCCEEDED);
+				ck_assert_int_eq(memcmp(decoded, arr, len), 0);
+			}
+			// A bad character anywhere, including inside a SIMD block.
+			for (size_t pos = 0; pos < len * 2; pos += 7)
+			{
+				uint8_t saved = str[pos];
+				str[pos] = 'x';
+				ck_assert_ptr_eq(hexstr_to_bytearr(str, len * 2, decoded), HEXSTR_INVALID_CHARACTER);
+				str[pos] = saved;
+			}
+		}
+	}
+	ck_assert_ptr_eq(hex_select(HEX_AUTO), SUCCEEDED);
+	ck_assert_int_eq(hex_selected(), HEX_AUTO);
+}
+END_TEST
+
+Suite * make_Hex_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Hex");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, hex_encode);
+	tcase_add_test(tc_core, hex_decode);
+	tcase_add_test(tc_core, hex_kernels);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
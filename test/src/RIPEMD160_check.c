@@ -0,0 +1,64 @@
+#include <check.h>
+#include <string.h>
+#include "internal/crypto/ripemd160.h"
+
+// Test vectors from the RIPEMD-160 paper.
+byte ripemd160_empty[20] = {0x9c,0x11,0x85,0xa5,0xc5,0xe9,0xfc,0x54,0x61,0x28,\
+0x08,0x97,0x7e,0xe8,0xf5,0x48,0xb2,0x25,0x8d,0x31};
+byte ripemd160_abc[20] = {0x8e,0xb2,0x08,0xf7,0xe0,0x5d,0x98,0x7a,0x9b,0x04,\
+0x4a,0x8e,0x98,0xc6,0xb0,0x87,0xf1,0x5a,0x0b,0xfc};
+byte ripemd160_two_blocks[20] = {0x12,0xa0,0x53,0x38,0x4a,0x9c,0x0c,0x88,0xe4,0x05,\
+0xa0,0x6c,0x27,0xdc,0xf4,0x9a,0xda,0x62,0xeb,0x2b};
+
+START_TEST(ripemd160_vectors)
+{
+	byte digest[20];
+	const char *two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+	ripemd160((const byte *)"", 0, digest);
+	ck_assert_int_eq(memcmp(digest, ripemd160_empty, 20), 0);
+	ripemd160((const byte *)"abc", 3, digest);
+	ck_assert_int_eq(memcmp(digest, ripemd160_abc, 20), 0);
+	ripemd160((const byte *)two_blocks, strlen(two_blocks), digest);
+	ck_assert_int_eq(memcmp(digest, ripemd160_two_blocks, 20), 0);
+}
+END_TEST
+
+START_TEST(ripemd160_batch_lanes)
+{
+	byte data[37 * 150], expected[37 * 20], digests[37 * 20];
+	for (size_t i = 0; i < sizeof(data); ++i)
+		data[i] = (byte)(i * 7 + (i >> 8));
+
+	// Every length around the padding boundaries, counts that leave partial lane groups.
+	for (size_t len = 0; len < 150; ++len)
+	{
+		for (size_t i = 0; i < 37; ++i)
+			hash160(data + i * 150, len, expected + i * 20);
+
+		for (RIPEMD160_IMPL impl = RIPEMD160_AUTO; impl <= RIPEMD160_AVX512; ++impl)
+		{
+			if (ripemd160_select(impl) != SUCCEEDED)
+				continue;
+			hash160_batch(data, 150, len, 37, digests);
+			ck_assert_int_eq(memcmp(digests, expected, sizeof(expected)), 0);
+		}
+	}
+	ripemd160_select(RIPEMD160_AUTO);
+}
+END_TEST
+
+Suite * make_RIPEMD160_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("RIPEMD160");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, ripemd160_vectors);
+	tcase_add_test(tc_core, ripemd160_batch_lanes);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
@@ -0,0 +1,121 @@
+#include <check.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "internal/crypto/random.h"
+#include "internal/crypto/secp256k1.h"
+#include "internal/address.h"
+
+// RFC 8439 section 2.3.2.
+uint32_t chacha20_input[16] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c, 0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c,
+0x00000001, 0x09000000, 0x4a000000, 0x00000000};
+byte chacha20_output[64] = {0x10,0xf1,0xe7,0xe4,0xd1,0x3b,0x59,0x15,0x50,0x0f,0xdd,0x1f,0xa3,0x20,0x71,0xc4,\
+0xc7,0xd1,0xf4,0xc7,0x33,0xc0,0x68,0x03,0x04,0x22,0xaa,0x9a,0xc3,0xd4,0x6c,0x4e,\
+0xd2,0x82,0x64,0x46,0x07,0x9f,0xaa,0x09,0x14,0xc2,0xd7,0x05,0xd9,0x8b,0x02,0xa2,\
+0xb5,0x12,0x9c,0xd1,0xde,0x16,0x4e,0xb9,0xcb,0xd0,0x83,0xe8,0xa2,0x50,0x3c,0x4e};
+
+START_TEST(random_chacha20_block)
+{
+	byte out[64];
+	chacha20_block(chacha20_input, out);
+	ck_assert_int_eq(memcmp(out, chacha20_output, 64), 0);
+}
+END_TEST
+
+START_TEST(random_bytes_stream)
+{
+	byte a[3000], b[3000], zeros[3000] = {0};
+
+	// Reads across refills never repeat and never leave a block unfilled.
+	ck_assert_ptr_eq(random_bytes(a, 1), SUCCEEDED);
+	ck_assert_ptr_eq(random_bytes(a, sizeof(a)), SUCCEEDED);
+	ck_assert_ptr_eq(random_bytes(b, sizeof(b)), SUCCEEDED);
+	ck_assert_int_ne(memcmp(a, b, sizeof(a)), 0);
+	for (size_t i = 0; i + 32 <= sizeof(a); i += 32)
+	{
+		ck_assert_int_ne(memcmp(a + i, zeros, 32), 0);
+		ck_assert_int_ne(memcmp(b + i, zeros, 32), 0);
+	}
+}
+END_TEST
+
+START_TEST(random_private_keys)
+{
+	byte keys[500 * 32], key[32];
+
+	ck_assert_ptr_eq(ecdsa_secp256k1_generate_private_keys(keys, 500), SUCCEEDED);
+	for (size_t i = 0; i < 500; ++i)
+	{
+		ck_assert(secp256k1_seckey_verify(keys + i * 32));
+		if (i)
+			ck_assert_int_ne(memcmp(keys + i * 32, keys + (i - 1) * 32, 32), 0);
+	}
+	ck_assert_ptr_eq(ecdsa_secp256k1_generate_private_key(key), SUCCEEDED);
+	ck_assert(secp256k1_seckey_verify(key));
+}
+END_TEST
+
+// Stands in for libc's getrandom() in the test binary, so a missing entropy source can be forced.
+static volatile bool getrandom_fails;
+
+ssize_t getrandom(void *buf, size_t buflen, unsigned int flags)
+{
+	if (getrandom_fails)
+	{
+		errno = ENOSYS;
+		return -1;
+	}
+	return syscall(SYS_getrandom, buf, buflen, flags);
+}
+
+// A new thread's generator isn't seeded yet, so it has to ask for a seed.
+static void * random_no_entropy(void *arg)
+{
+	byte key[32];
+	(void)arg;
+
+	ck_assert_ptr_eq(random_bytes(key, sizeof(key)), FAILED);
+	ck_assert_ptr_eq(ecdsa_secp256k1_generate_private_key(key), FAILED);
+	ck_assert_ptr_eq(new_P2PKH_Main(true), FAILED);
+	ck_assert_ptr_eq(new_P2PKH_Main(false), FAILED);
+	return NULL;
+}
+
+START_TEST(random_entropy_failure)
+{
+	pthread_t thread;
+
+	getrandom_fails = true;
+	ck_assert_int_eq(pthread_create(&thread, NULL, random_no_entropy, NULL), 0);
+	ck_assert_int_eq(pthread_join(thread, NULL), 0);
+	getrandom_fails = false;
+
+	// And the constructor works again once the source is back.
+	P2PKH_Main_Address *addr = new_P2PKH_Main(true);
+	ck_assert_ptr_ne(addr, FAILED);
+	ck_assert_ptr_ne(addr, MEMORY_ALLOCATE_FAILED);
+	ck_assert(secp256k1_seckey_verify(addr->root.priv_raw));
+	free(addr);
+}
+END_TEST
+
+Suite * make_Random_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Random");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, random_chacha20_block);
+	tcase_add_test(tc_core, random_bytes_stream);
+	tcase_add_test(tc_core, random_private_keys);
+	tcase_add_test(tc_core, random_entropy_failure);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
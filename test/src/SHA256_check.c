@@ -0,0 +1,71 @@
+#include <check.h>
+#include <string.h>
+#include "internal/crypto/sha256.h"
+
+// FIPS 180-2 test vectors.
+byte sha256_abc[32] = {0xba,0x78,0x16,0xbf,0x8f,0x01,0xcf,0xea,0x41,0x41,0x40,0xde,0x5d,0xae,0x22,0x23,\
+0xb0,0x03,0x61,0xa3,0x96,0x17,0x7a,0x9c,0xb4,0x10,0xff,0x61,0xf2,0x00,0x15,0xad};
+byte sha256_two_blocks[32] = {0x24,0x8d,0x6a,0x61,0xd2,0x06,0x38,0xb8,0xe5,0xc0,0x26,0x93,0x0c,0x3e,0x60,0x39,\
+0xa3,0x3c,0xe4,0x59,0x64,0xff,0x21,0x67,0xf6,0xec,0xed,0xd4,0x19,0xdb,0x06,0xc1};
+byte sha256d_empty[32] = {0x5d,0xf6,0xe0,0xe2,0x76,0x13,0x59,0xd3,0x0a,0x82,0x75,0x05,0x8e,0x29,0x9f,0xcc,\
+0x03,0x81,0x53,0x45,0x45,0xf5,0x5c,0xf4,0x3e,0x41,0x98,0x3f,0x5d,0x4c,0x94,0x56};
+
+START_TEST(sha256_vectors)
+{
+	byte digest[32];
+	const char *two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+	for (SHA256_IMPL impl = SHA256_AUTO; impl <= SHA256_AVX512; ++impl)
+	{
+		if (sha256_select(impl) != SUCCEEDED)
+			continue;
+		sha256((const byte *)"abc", 3, digest);
+		ck_assert_int_eq(memcmp(digest, sha256_abc, 32), 0);
+		sha256((const byte *)two_blocks, strlen(two_blocks), digest);
+		ck_assert_int_eq(memcmp(digest, sha256_two_blocks, 32), 0);
+		sha256d((const byte *)"", 0, digest);
+		ck_assert_int_eq(memcmp(digest, sha256d_empty, 32), 0);
+	}
+	sha256_select(SHA256_AUTO);
+}
+END_TEST
+
+START_TEST(sha256_batch_lanes)
+{
+	byte data[37 * 150], expected[37 * 32], digests[37 * 32];
+	for (size_t i = 0; i < sizeof(data); ++i)
+		data[i] = (byte)(i * 7 + (i >> 8));
+
+	// Every length around the padding boundaries, counts that leave partial lane groups.
+	for (size_t len = 0; len < 150; ++len)
+	{
+		sha256_select(SHA256_SCALAR);
+		for (size_t i = 0; i < 37; ++i)
+			sha256d(data + i * 150, len, expected + i * 32);
+
+		for (SHA256_IMPL impl = SHA256_AUTO; impl <= SHA256_AVX512; ++impl)
+		{
+			if (sha256_select(impl) != SUCCEEDED)
+				continue;
+			sha256d_batch(data, 150, len, 37, digests);
+			ck_assert_int_eq(memcmp(digests, expected, sizeof(expected)), 0);
+		}
+	}
+	sha256_select(SHA256_AUTO);
+}
+END_TEST
+
+Suite * make_SHA256_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("SHA256");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, sha256_vectors);
+	tcase_add_test(tc_core, sha256_batch_lanes);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
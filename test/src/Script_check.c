@@ -1,10 +1,13 @@
 #include <check.h>
-#include "../src/script/script.h"
+#include <stdlib.h>
+#include <string.h>
+#include "internal/machine/script.h"
+#include "internal/machine/interpreter.h"
 
-BYTE sample1[28] = {0x04,0xff,0xaa,0xdd,0xee,0xa9,0x14,0xf3,0x70,0x78,0xa5,\
+byte sample1[28] = {0x04,0xff,0xaa,0xdd,0xee,0xa9,0x14,0xf3,0x70,0x78,0xa5,\
 0x3a,0xf0,0x2c,0xe0,0x81,0x79,0xfe,0x34,0x6a,0x54,0x0a,0x0a,0x62,0x56,0x70,0x07,0x87};
-BYTE sample2[6] = {0x4d,0x03,0x00,0x00,0xff,0xff};
-const char *sample1_str = "PUSHDATA(0x04)[FFAADDEE] OP_HASH160 PUSHDATA(0x14)[F37078A53AF02CE08179FE346A540A0A62567007] OP_EQUAL";
+byte sample2[6] = {0x4d,0x03,0x00,0x00,0xff,0xff};
+const char *sample1_str = "PUSHDATA(0x04)[FFAADDEE] OP_HASH160 PUSHDATA(0x14)[F37078A53AF02CE08179FE346A540A0A62567007] OP_EQUAL ";
 const char *sample2_str = "OP_PUSHDATA2[00FFFF]";
 
 START_TEST(script_new_from_bytes_and_to_bytes)
@@ -12,7 +15,7 @@ START_TEST(script_new_from_bytes_and_to_bytes)
 	Script *script1 = new_Script_from_bytes(sample1, 28);
 	ck_assert_ptr_ne(script1, NULL);
 	size_t bytes_size1;
-	BYTE *bytes1 = script1->to_bytes(script1, &bytes_size1);
+	byte *bytes1 = script1->to_bytes(script1, &bytes_size1);
 	ck_assert_ptr_ne(bytes1, NULL);
 	ck_assert_uint_eq(bytes_size1, 28);
 	for (uint8_t i = 0; i < bytes_size1; ++i)
@@ -23,13 +26,18 @@ START_TEST(script_new_from_bytes_and_to_bytes)
 	Script *script2 = new_Script_from_bytes(sample2, 6);
 	ck_assert_ptr_ne(script2, NULL);
 	size_t bytes_size2;
-	BYTE *bytes2 = script2->to_bytes(script2, &bytes_size2);
+	byte *bytes2 = script2->to_bytes(script2, &bytes_size2);
 	ck_assert_ptr_ne(bytes2, NULL);
 	ck_assert_uint_eq(bytes_size2, 6);
 	for (uint8_t i = 0; i < bytes_size2; ++i)
 	{
 		ck_assert_uint_eq(bytes2[i], sample2[i]);
 	}
+
+	free(bytes1);
+	free(bytes2);
+	delete_Script(script1);
+	delete_Script(script2);
 }
 END_TEST
 
@@ -38,10 +46,54 @@ START_TEST(script_to_string)
 	Script *script1 = new_Script_from_bytes(sample1, 28);
 	size_t size1;
 	char *str1 = (char *)script1->to_string(script1, &size1);
+	ck_assert_ptr_ne(str1, NULL);
+	ck_assert_uint_eq(size1, strlen(sample1_str));
 	for (uint8_t i = 0; i < size1; ++i)
 	{
 		ck_assert_int_eq(str1[i], sample1_str[i]);
 	}
+
+	free(str1);
+	delete_Script(script1);
+}
+END_TEST
+
+START_TEST(script_interpret_hash160)
+{
+	// <data> OP_HASH160 OP_1, the final OP_1 is consumed by launch and leaves the digest on top.
+	byte abc_script[6] = {0x03,'a','b','c',0xa9,0x51};
+	byte empty_script[3] = {0x00,0xa9,0x51};
+	byte abc_hash160[20] = {0xbb,0x1b,0xe9,0x8c,0x14,0x24,0x44,0xd7,0xa5,0x6a,\
+0xa3,0x98,0x1c,0x39,0x42,0xa9,0x78,0xe4,0xdc,0x33};
+	byte empty_hash160[20] = {0xb4,0x72,0xa2,0x66,0xd0,0xbd,0x89,0xc1,0x37,0x06,\
+0xa4,0x13,0x2c,0xcf,0xb1,0x6f,0x7c,0x3b,0x9f,0xcb};
+
+	byte *scripts[2] = {abc_script, empty_script};
+	size_t script_sizes[2] = {6, 3};
+	byte *digests[2] = {abc_hash160, empty_hash160};
+	for (int i = 0; i < 2; ++i)
+	{
+		Script *script = new_Script_from_bytes(scripts[i], script_sizes[i]);
+		ck_assert_ptr_ne(script, NULL);
+		Interpreter *interpreter = new_Interpreter();
+		ck_assert_ptr_ne(interpreter, MEMORY_ALLOCATE_FAILED);
+		ck_assert_ptr_eq(interpreter->load_script(interpreter, script), SUCCEEDED);
+		ck_assert_ptr_eq(interpreter->launch(interpreter, 0), INTERPRETER_TRUE);
+
+		size_t size;
+		byte *top = (byte *)interpreter->data_stack->pop(interpreter->data_stack, &size, NULL, NULL);
+		ck_assert_uint_eq(size, 20);
+		for (int j = 0; j < 20; ++j)
+		{
+			ck_assert_uint_eq(top[j], digests[i][j]);
+		}
+		ck_assert(interpreter->data_stack->is_empty(interpreter->data_stack));
+
+		free(top);
+		interpreter->unload_script(interpreter);
+		delete_Interpreter(interpreter);
+		delete_Script(script);
+	}
 }
 END_TEST
 
@@ -55,6 +107,7 @@ Suite * make_Script_suite(void)
 
 	tcase_add_test(tc_core, script_new_from_bytes_and_to_bytes);
 	tcase_add_test(tc_core, script_to_string);
+	tcase_add_test(tc_core, script_interpret_hash160);
 	suite_add_tcase(s, tc_core);
 
 	return s;
@@ -0,0 +1,140 @@
+#include <check.h>
+#include <string.h>
+#include "internal/crypto/secp256k1.h"
+
+// 1 * G, 2 * G and 3 * G.
+byte pub_g[65] = {0x04,0x79,0xbe,0x66,0x7e,0xf9,0xdc,0xbb,0xac,0x55,0xa0,0x62,0x95,0xce,0x87,0x0b,\
+0x07,0x02,0x9b,0xfc,0xdb,0x2d,0xce,0x28,0xd9,0x59,0xf2,0x81,0x5b,0x16,0xf8,0x17,\
+0x98,0x48,0x3a,0xda,0x77,0x26,0xa3,0xc4,0x65,0x5d,0xa4,0xfb,0xfc,0x0e,0x11,0x08,\
+0xa8,0xfd,0x17,0xb4,0x48,0xa6,0x85,0x54,0x19,0x9c,0x47,0xd0,0x8f,0xfb,0x10,0xd4,\
+0xb8};
+byte pubc_2g[33] = {0x02,0xc6,0x04,0x7f,0x94,0x41,0xed,0x7d,0x6d,0x30,0x45,0x40,0x6e,0x95,0xc0,0x7c,\
+0xd8,0x5c,0x77,0x8e,0x4b,0x8c,0xef,0x3c,0xa7,0xab,0xac,0x09,0xb9,0x5c,0x70,0x9e,\
+0xe5};
+byte pub_3g[65] = {0x04,0xf9,0x30,0x8a,0x01,0x92,0x58,0xc3,0x10,0x49,0x34,0x4f,0x85,0xf8,0x9d,0x52,\
+0x29,0xb5,0x31,0xc8,0x45,0x83,0x6f,0x99,0xb0,0x86,0x01,0xf1,0x13,0xbc,0xe0,0x36,\
+0xf9,0x38,0x8f,0x7b,0x0f,0x63,0x2d,0xe8,0x14,0x0f,0xe3,0x37,0xe6,0x2a,0x37,0xf3,\
+0x56,0x65,0x00,0xa9,0x99,0x34,0xc2,0x23,0x1b,0x6c,0xb9,0xfd,0x75,0x84,0xb8,0xe6,\
+0x72};
+// n - 1, its public key is -G.
+byte seckey_n_minus_1[32] = {0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xfe,\
+0xba,0xae,0xdc,0xe6,0xaf,0x48,0xa0,0x3b,0xbf,0xd2,0x5e,0x8c,0xd0,0x36,0x41,0x40};
+
+START_TEST(secp256k1_small_scalars)
+{
+	byte seckey[32] = {0}, pub[65];
+
+	seckey[31] = 1;
+	ck_assert_ptr_eq(secp256k1_pubkey_create(seckey, pub, false), SUCCEEDED);
+	ck_assert_int_eq(memcmp(pub, pub_g, 65), 0);
+
+	seckey[31] = 2;
+	ck_assert_ptr_eq(secp256k1_pubkey_create(seckey, pub, true), SUCCEEDED);
+	ck_assert_int_eq(memcmp(pub, pubc_2g, 33), 0);
+
+	seckey[31] = 3;
+	ck_assert_ptr_eq(secp256k1_pubkey_create(seckey, pub, false), SUCCEEDED);
+	ck_assert_int_eq(memcmp(pub, pub_3g, 65), 0);
+}
+END_TEST
+
+START_TEST(secp256k1_order_bounds)
+{
+	byte seckey[32], pub[33];
+
+	// -G has G's x coordinate and the odd y.
+	ck_assert_ptr_eq(secp256k1_pubkey_create(seckey_n_minus_1, pub, true), SUCCEEDED);
+	ck_assert_int_eq(pub[0], 0x03);
+	ck_assert_int_eq(memcmp(pub + 1, pub_g + 1, 32), 0);
+
+	memcpy(seckey, seckey_n_minus_1, 32);
+	seckey[31] = 0x41;
+	ck_assert(!secp256k1_seckey_verify(seckey));
+	ck_assert_ptr_eq(secp256k1_pubkey_create(seckey, pub, true), FAILED);
+
+	memset(seckey, 0, 32);
+	ck_assert(!secp256k1_seckey_verify(seckey));
+	memset(seckey, 0xff, 32);
+	ck_assert(!secp256k1_seckey_verify(seckey));
+}
+END_TEST
+
+START_TEST(secp256k1_generic_multiplication)
+{
+	byte seckey[32], pub[65], expected[65];
+	JacobianPoint acc, base, r;
+	AffinePoint affine;
+
+	for (uint8_t i = 0; i < 32; ++i)
+		seckey[i] = (byte)(i * 29 + 7);
+
+	// Double-and-add, independent of the precomputed table.
+	memset(&acc, 0, sizeof(JacobianPoint));
+	acc.infinity = true;
+	base.x = secp256k1_g.x; base.y = secp256k1_g.y;
+	memset(&base.z, 0, sizeof(FieldElement));
+	base.z.n[0] = 1;
+	base.infinity = false;
+	for (int16_t bit = 255; bit >= 0; --bit)
+	{
+		secp256k1_gej_double(&acc, &acc);
+		if ((seckey[31 - bit / 8] >> (bit % 8)) & 1)
+			secp256k1_gej_add(&acc, &acc, &base);
+	}
+	secp256k1_ge_set_gej(&affine, &acc);
+	secp256k1_ge_serialize(&affine, expected, false);
+
+	secp256k1_ecmult_gen(&r, seckey);
+	secp256k1_ge_set_gej(&affine, &r);
+	secp256k1_ge_serialize(&affine, pub, false);
+	ck_assert_int_eq(memcmp(pub, expected, 65), 0);
+}
+END_TEST
+
+START_TEST(secp256k1_batch)
+{
+	// More keys than one block, with a bad key in each block.
+	size_t count = SECP256K1_BATCH_SIZE + 45;
+	byte seckeys[count * 32], pubs[count * 33], expected[33];
+	Status statuses[count];
+
+	for (size_t i = 0; i < count * 32; ++i)
+		seckeys[i] = (byte)(i * 131 + (i >> 5));
+	memset(seckeys + 7 * 32, 0, 32);
+	memcpy(seckeys + (SECP256K1_BATCH_SIZE + 3) * 32, seckey_n_minus_1, 32);
+	seckeys[(SECP256K1_BATCH_SIZE + 3) * 32 + 31] = 0x41;
+
+	ck_assert_uint_eq(secp256k1_pubkey_create_batch(seckeys, count, pubs, true, statuses), count - 2);
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (i == 7 || i == SECP256K1_BATCH_SIZE + 3)
+		{
+			ck_assert_ptr_eq(statuses[i], FAILED);
+			memset(expected, 0, 33);
+		}
+		else
+		{
+			ck_assert_ptr_eq(statuses[i], SUCCEEDED);
+			secp256k1_pubkey_create(seckeys + i * 32, expected, true);
+		}
+		ck_assert_int_eq(memcmp(pubs + i * 33, expected, 33), 0);
+	}
+}
+END_TEST
+
+Suite * make_Secp256k1_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Secp256k1");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, secp256k1_small_scalars);
+	tcase_add_test(tc_core, secp256k1_order_bounds);
+	tcase_add_test(tc_core, secp256k1_generic_multiplication);
+	tcase_add_test(tc_core, secp256k1_batch);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
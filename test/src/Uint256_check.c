@@ -0,0 +1,105 @@
+#include <check.h>
+#include <string.h>
+#include "internal/crypto/uint256.h"
+
+static const Uint256 gx = {{0x59f2815b16f81798ULL, 0x029bfcdb2dce28d9ULL, 0x55a06295ce870b07ULL, 0x79be667ef9dcbbacULL}};
+
+static void assert_uint256_eq(const Uint256 *a, const Uint256 *b)
+{
+	for (uint8_t i = 0; i < 4; ++i)
+		ck_assert_uint_eq(a->n[i], b->n[i]);
+}
+
+START_TEST(uint256_bytes_and_compare)
+{
+	byte bytes[32], back[32];
+	Uint256 a, one;
+
+	for (uint8_t i = 0; i < 32; ++i)
+		bytes[i] = i + 1;
+	uint256_set_bytes(&a, bytes);
+	ck_assert_uint_eq(a.n[3], 0x0102030405060708ULL);
+	ck_assert_uint_eq(a.n[0], 0x191a1b1c1d1e1f20ULL);
+	uint256_get_bytes(&a, back);
+	ck_assert_int_eq(memcmp(bytes, back, 32), 0);
+
+	uint256_set_u64(&one, 1);
+	ck_assert_int_eq(uint256_cmp(&one, &uint256_n), -1);
+	ck_assert_int_eq(uint256_cmp(&uint256_p, &uint256_n), 1);
+	ck_assert_int_eq(uint256_cmp(&gx, &gx), 0);
+	ck_assert(!uint256_is_zero(&one));
+
+	// Carry and borrow out of 2^256.
+	Uint256 max = {{UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX}}, r;
+	ck_assert_uint_eq(uint256_add(&r, &max, &one), 1);
+	ck_assert(uint256_is_zero(&r));
+	ck_assert_uint_eq(uint256_sub(&r, &r, &one), 1);
+	assert_uint256_eq(&r, &max);
+}
+END_TEST
+
+START_TEST(uint256_reduction)
+{
+	Uint256 max = {{UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX}}, r, one;
+	Uint512 wide, sq;
+
+	// 2^512 - 1 mod n and mod p.
+	memset(wide.n, 0xff, sizeof(wide.n));
+	const Uint256 max_n = {{0x896cf21467d7d13fULL, 0x741496c20e7cf878ULL, 0xe697f5e45bcd07c6ULL, 0x9d671cd581c69bc5ULL}};
+	const Uint256 max_p = {{0x000007a2000e90a0ULL, 0x0000000000000001ULL, 0, 0}};
+	uint256_reduce_n(&r, &wide);
+	assert_uint256_eq(&r, &max_n);
+	uint256_reduce_p(&r, &wide);
+	assert_uint256_eq(&r, &max_p);
+
+	// Gx^2 mod p, Gx * (n - 1) mod n, and (m - 1)^2 = 1 for both moduli.
+	const Uint256 gx2 = {{0x38d50229b854fc49ULL, 0xe3652194d06cb5bbULL, 0x6ba9adcf0fb52a9dULL, 0x8550e7d238fcf308ULL}};
+	const Uint256 gxn = {{0x65dfdd31b93e29a9ULL, 0xb812e00b817a7762ULL, 0xaa5f9d6a3178f4f7ULL, 0x8641998106234453ULL}};
+	uint256_sqr(&sq, &gx);
+	uint256_mul(&wide, &gx, &gx);
+	ck_assert_int_eq(memcmp(&sq, &wide, sizeof(sq)), 0);
+	uint256_reduce_p(&r, &sq);
+	assert_uint256_eq(&r, &gx2);
+
+	Uint256 m1;
+	uint256_set_u64(&one, 1);
+	uint256_sub(&m1, &uint256_n, &one);
+	uint256_mul_mod_n(&r, &gx, &m1);
+	assert_uint256_eq(&r, &gxn);
+	uint256_mul_mod_n(&r, &m1, &m1);
+	assert_uint256_eq(&r, &one);
+	uint256_sub(&m1, &uint256_p, &one);
+	uint256_mul_mod_p(&r, &m1, &m1);
+	assert_uint256_eq(&r, &one);
+
+	// 2^256 - 1 reduced, then (m - 1) + 1 = 0 and 0 - 1 = m - 1.
+	uint256_mod_p(&r, &max);
+	ck_assert_uint_eq(r.n[0], 0x1000003d0ULL);
+	uint256_mod_n(&r, &uint256_n);
+	ck_assert(uint256_is_zero(&r));
+	uint256_add_mod_p(&r, &m1, &one);
+	ck_assert(uint256_is_zero(&r));
+	uint256_sub_mod_p(&r, &r, &one);
+	assert_uint256_eq(&r, &m1);
+	uint256_sub(&m1, &uint256_n, &one);
+	uint256_add_mod_n(&r, &m1, &one);
+	ck_assert(uint256_is_zero(&r));
+	uint256_sub_mod_n(&r, &r, &one);
+	assert_uint256_eq(&r, &m1);
+}
+END_TEST
+
+Suite * make_Uint256_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Uint256");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, uint256_bytes_and_compare);
+	tcase_add_test(tc_core, uint256_reduction);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
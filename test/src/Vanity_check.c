@@ -0,0 +1,139 @@
+#include <check.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "internal/address.h"
+#include "internal/vanity.h"
+#include "internal/codec/base.h"
+
+// Addresses of hash160s inside the ranges may still miss the prefix, the ones outside never hit it.
+static void check_ranges(const char *pattern, VANITY_MATCH match, ADDRESS_TYPE addr_type)
+{
+	VanityRange *ranges;
+	Status status;
+	byte to_base58[25], hash160[20];
+	uint8_t address[ADDRESS_SLOT_SIZE];
+	size_t len = strlen(pattern), count, hits = 0;
+
+	count = vanity_ranges((const uint8_t *)pattern, match, addr_type, &ranges, &status);
+	ck_assert_ptr_eq(status, SUCCEEDED);
+	ck_assert_uint_gt(count, 0);
+
+	srand(7);
+	for (uint32_t i = 0; i < 200000; ++i)
+	{
+		for (uint8_t j = 0; j < 20; ++j)
+			hash160[j] = (byte)rand();
+		// Land inside the first range half of the time.
+		if (i % 2)
+			memcpy(hash160, ranges[i / 2 % count].lo, 4);
+
+		to_base58[0] = address_prefix(addr_type);
+		memcpy(to_base58 + 1, hash160, 20);
+		memset(to_base58 + 21, 0, 4);
+		base58encode(to_base58, 25, address);
+
+		bool hit = match == VANITY_PREFIX_NOCASE ? !strncasecmp((char *)address, pattern, len) :
+			!strncmp((char *)address, pattern, len);
+		if (hit)
+		{
+			ck_assert(vanity_ranges_match(ranges, count, hash160));
+			hits++;
+		}
+	}
+	ck_assert_uint_gt(hits, 0);
+	free(ranges);
+}
+
+START_TEST(vanity_pattern_ranges)
+{
+	check_ranges("1A", VANITY_PREFIX, MAINNET_P2PKH);
+	check_ranges("1Bit", VANITY_PREFIX, MAINNET_P2PKH);
+	check_ranges("11", VANITY_PREFIX, MAINNET_P2PKH);
+	check_ranges("1", VANITY_PREFIX, MAINNET_P2PKH);
+	check_ranges("3Q", VANITY_PREFIX, MAINNET_P2SH);
+	check_ranges("mz", VANITY_PREFIX, TESTNET_P2PKH);
+	check_ranges("1bit", VANITY_PREFIX_NOCASE, MAINNET_P2PKH);
+}
+END_TEST
+
+START_TEST(vanity_pattern_errors)
+{
+	VanityRange *ranges;
+	Status status;
+
+	// '0' isn't Base58, mainnet P2PKH addresses start with '1', testnet ones with 'm' or 'n'.
+	ck_assert_uint_eq(vanity_ranges((const uint8_t *)"10", VANITY_PREFIX, MAINNET_P2PKH, &ranges, &status), 0);
+	ck_assert_ptr_eq(status, VANITY_INVALID_PATTERN);
+	ck_assert_uint_eq(vanity_ranges((const uint8_t *)"2A", VANITY_PREFIX, MAINNET_P2PKH, &ranges, &status), 0);
+	ck_assert_ptr_eq(status, VANITY_INVALID_PATTERN);
+	ck_assert_uint_eq(vanity_ranges((const uint8_t *)"1A", VANITY_PREFIX, TESTNET_P2PKH, &ranges, &status), 0);
+	ck_assert_ptr_eq(status, VANITY_INVALID_PATTERN);
+	ck_assert_uint_eq(vanity_ranges((const uint8_t *)"0g", VANITY_HASH160_PREFIX, MAINNET_P2PKH, &ranges, &status), 0);
+	ck_assert_ptr_eq(status, VANITY_INVALID_PATTERN);
+	ck_assert_uint_eq(vanity_ranges((const uint8_t *)"1abcdefghjkmnpqrstuvwxyz", VANITY_PREFIX_NOCASE, MAINNET_P2PKH,
+		&ranges, &status), 0);
+	ck_assert_ptr_eq(status, VANITY_PATTERN_TOO_BROAD);
+}
+END_TEST
+
+START_TEST(vanity_search_hits)
+{
+	VanityConfig config = {
+		.pattern = (const uint8_t *)"1Ab", .match = VANITY_PREFIX_NOCASE, .compress = true,
+		.addr_type = MAINNET_P2PKH, .threads = 2, .max_hits = 3,
+	};
+	VanityHit hits[3];
+	VanityStats stats;
+	size_t count;
+	byte pub[33], hash160[20];
+
+	ck_assert_ptr_eq(vanity_search(&config, hits, &count, &stats), SUCCEEDED);
+	ck_assert_uint_eq(count, 3);
+	ck_assert_uint_gt(stats.keys, 0);
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		ck_assert_int_eq(strncasecmp((char *)hits[i].address, "1Ab", 3), 0);
+		ecdsa_secp256k1_privkey_to_pubkey(hits[i].priv_raw, pub, true);
+		ck_assert_int_eq(memcmp(pub, hits[i].pub_raw, 33), 0);
+	}
+
+	// hash160 prefix.
+	config.pattern = (const uint8_t *)"00f";
+	config.match = VANITY_HASH160_PREFIX;
+	config.max_hits = 1;
+	ck_assert_ptr_eq(vanity_search(&config, hits, &count, NULL), SUCCEEDED);
+	ck_assert_uint_eq(count, 1);
+	ck_assert_ptr_eq(address_to_hash160(hits[0].address, hash160), SUCCEEDED);
+	ck_assert_int_eq(hash160[0], 0x00);
+	ck_assert_int_eq(hash160[1] >> 4, 0x0f);
+
+	// Nothing found within max_keys.
+	config.pattern = (const uint8_t *)"00000000";
+	config.max_keys = 5000;
+	ck_assert_ptr_eq(vanity_search(&config, hits, &count, &stats), SUCCEEDED);
+	ck_assert_uint_eq(count, 0);
+	ck_assert_uint_ge(stats.keys, 5000);
+
+	// No room for a hit.
+	config.max_hits = 0;
+	ck_assert_ptr_eq(vanity_search(&config, hits, &count, NULL), FAILED);
+	ck_assert_uint_eq(count, 0);
+}
+END_TEST
+
+Suite * make_Vanity_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Vanity");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, vanity_pattern_ranges);
+	tcase_add_test(tc_core, vanity_pattern_errors);
+	tcase_add_test(tc_core, vanity_search_hits);
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
@@ -5,5 +5,16 @@
 Suite * make_CStack_suite(void);
 Suite * make_CLinkedlist_suite(void);
 Suite * make_Script_suite(void);
+Suite * make_Base58_suite(void);
+Suite * make_Address_suite(void);
+Suite * make_SHA256_suite(void);
+Suite * make_RIPEMD160_suite(void);
+Suite * make_Secp256k1_suite(void);
+Suite * make_Vanity_suite(void);
+Suite * make_Random_suite(void);
+Suite * make_Hex_suite(void);
+Suite * make_Base64_suite(void);
+Suite * make_Bigint_suite(void);
+Suite * make_Uint256_suite(void);
 
 #endif
\ No newline at end of file